@@ -0,0 +1,661 @@
+/**
+ * @file   SmallVector.hpp
+ * @brief  Vector style class with inline storage for N elements and heap spill-over.
+ *
+ * SmallVector keeps up to N elements in the same aligned_storage elems[N] block
+ * that StaticVector uses, so containers sized for the common case never allocate.
+ * What happens when more than N elements are needed is selected by the
+ * OverflowPolicy template parameter:
+ *
+ *   small_vector_throw  never allocates, throws std::out_of_range just like StaticVector
+ *   small_vector_spill  moves to an allocator backed buffer grown in blocks of N elements
+ *   small_vector_grow   moves to an allocator backed buffer grown geometrically (default)
+ *
+ * The allocator only supplies raw memory, elements are constructed in place
+ * exactly as in StaticVector. Relocatable element types (see
+ * boost::is_trivially_relocatable) are moved between buffers with memcpy.
+ * Unlike StaticVector, a moved-from SmallVector is left empty.
+ *
+ *  SmallVector is not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_SMALL_VECTOR_HPP
+#define BOOST_SMALL_VECTOR_HPP
+
+#include "StaticVector.hpp"
+#include <boost/core/empty_value.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace boost {
+
+    // overflow policies for SmallVector
+
+    // never leave the inline storage, overflow throws std::out_of_range
+    struct small_vector_throw {
+        static const bool can_allocate = false;
+        static std::size_t next_capacity(std::size_t /*inline_capacity*/, std::size_t /*current*/, std::size_t required) {
+            return required;
+        }
+    };
+
+    // spill to the heap, growing in blocks of the inline capacity to keep the tail cases tight
+    struct small_vector_spill {
+        static const bool can_allocate = true;
+        static std::size_t next_capacity(std::size_t inline_capacity, std::size_t /*current*/, std::size_t required) {
+            return (required + inline_capacity - 1) / inline_capacity * inline_capacity;
+        }
+    };
+
+    // spill to the heap, doubling the capacity like std::vector
+    struct small_vector_grow {
+        static const bool can_allocate = true;
+        static std::size_t next_capacity(std::size_t /*inline_capacity*/, std::size_t current, std::size_t required) {
+            return (std::max)(required, current * 2);
+        }
+    };
+
+    template<class T, std::size_t N, class Alloc = std::allocator<T>, class OverflowPolicy = small_vector_grow>
+    class SmallVector : private boost::empty_value<Alloc> {
+        BOOST_STATIC_ASSERT(N > 0);
+        typedef boost::empty_value<Alloc>                      alloc_holder;
+        typedef std::allocator_traits<Alloc>                   alloc_traits;
+
+      public:
+        // type definitions
+        typedef T                                              value_type;
+        typedef T*                                             pointer;
+        typedef const T*                                       const_pointer;
+        typedef T*                                             iterator;
+        typedef const T*                                       const_iterator;
+        typedef T&                                             reference;
+        typedef const T&                                       const_reference;
+        typedef std::reverse_iterator<iterator>                reverse_iterator;
+        typedef std::reverse_iterator<const_iterator>          const_reverse_iterator;
+        typedef typename boost::aligned_storage<
+                           sizeof(T),
+                           boost::alignment_of<T>::value
+                         >::type                               aligned_storage;
+        typedef std::size_t                                    size_type;
+        typedef std::ptrdiff_t                                 difference_type;
+        typedef Alloc                                          allocator_type;
+        typedef OverflowPolicy                                 overflow_policy;
+
+      private:
+        pointer m_data;              // elems while inline, otherwise the allocated buffer
+        size_type m_size;
+        size_type m_capacity;
+        aligned_storage elems[N];    // inline array of memory aligned elements of type T
+
+      public:
+
+        // iterator support
+        iterator        begin()       { return m_data; }
+        const_iterator  begin() const { return m_data; }
+        const_iterator cbegin() const { return m_data; }
+
+        iterator        end()       { return m_data + m_size; }
+        const_iterator  end() const { return m_data + m_size; }
+        const_iterator cend() const { return m_data + m_size; }
+
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const { return const_reverse_iterator(end()); }
+
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
+
+        explicit SmallVector(const allocator_type& alloc = allocator_type()):
+          alloc_holder(boost::empty_init_t(), alloc),
+          m_data(inline_data()), m_size(0), m_capacity(N)
+        {}
+
+        SmallVector(size_type n, const_reference value, const allocator_type& alloc = allocator_type()):
+          alloc_holder(boost::empty_init_t(), alloc),
+          m_data(inline_data()), m_size(0), m_capacity(N)
+        {
+          BOOST_TRY {
+            insert(end(),n,value);
+          } BOOST_CATCH(...) {
+            clear();
+            release();
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+        }
+
+        template<typename InputIterator>
+        SmallVector(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(),
+                    typename boost::disable_if<boost::is_integral<InputIterator> >::type* = 0):
+          alloc_holder(boost::empty_init_t(), alloc),
+          m_data(inline_data()), m_size(0), m_capacity(N)
+        {
+          BOOST_TRY {
+            insert(end(),first,last);
+          } BOOST_CATCH(...) {
+            clear();
+            release();
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+        }
+
+        SmallVector(const SmallVector& rhs):
+          alloc_holder(boost::empty_init_t(), alloc_traits::select_on_container_copy_construction(rhs.get_allocator())),
+          m_data(inline_data()), m_size(0), m_capacity(N)
+        {
+          BOOST_TRY {
+            reserve_for(rhs.size());
+            std::uninitialized_copy(rhs.begin(),rhs.end(),begin());
+            m_size = rhs.size();
+          } BOOST_CATCH(...) {
+            clear();
+            release();
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+        }
+
+        // rhs is left empty, a heap buffer is taken over without touching the elements;
+        // inline elements are moved, so this only throws if moving a T does
+        SmallVector(SmallVector&& rhs) BOOST_NOEXCEPT_IF(std::is_nothrow_move_constructible<T>::value):
+          alloc_holder(boost::empty_init_t(), boost::move(rhs.get_allocator_ref())),
+          m_data(inline_data()), m_size(0), m_capacity(N)
+        {
+          steal(rhs);
+        }
+
+        ~SmallVector(){
+          clear();
+          release();
+        }
+
+        SmallVector& operator= (const SmallVector& rhs) {
+            if(this != &rhs){
+              assign(rhs.begin(),rhs.end());
+            }
+            return *this;
+        }
+
+        // with allocators that may compare unequal a new buffer may have to be allocated
+        SmallVector& operator= (SmallVector&& rhs)
+          BOOST_NOEXCEPT_IF(std::is_nothrow_move_constructible<T>::value && alloc_traits::is_always_equal::value) {
+            if(this != &rhs){
+              clear();
+              if(!rhs.is_inline() && get_allocator_ref() != rhs.get_allocator_ref()){
+                // the buffer belongs to another allocator, move the elements one at a time; if a move
+                // throws, the elements moved so far stay here and rhs keeps its size
+                reserve_for(rhs.size());
+                for(iterator it = rhs.begin(); it != rhs.end(); ++it){
+                  new (end()) T(boost::move(*it));
+                  ++m_size;
+                }
+                rhs.clear();
+              } else {
+                release();
+                steal(rhs);
+              }
+            }
+            return *this;
+        }
+
+        template<typename InputIterator>
+        void assign(InputIterator first, InputIterator last){
+          clear();
+          insert(end(),first,last);
+        }
+
+        void assign(size_type n, const_reference value){
+          value_type copy(value);
+          clear();
+          insert(end(),n,copy);
+        }
+
+        allocator_type get_allocator() const { return alloc_holder::get(); }
+
+        void push_back (const_reference x){
+          if(size() == capacity()){
+            // x may refer to an element that is about to be relocated
+            value_type copy(x);
+            reserve_for(size()+1);
+            unchecked_push_back(boost::move(copy));
+          } else {
+            unchecked_push_back(x);
+          }
+        }
+
+        void push_back (value_type&& x){
+          reserve_for(size()+1);
+          unchecked_push_back(boost::move(x));
+        }
+
+        void unchecked_push_back (const_reference x){
+          BOOST_ASSERT(size() < capacity());
+          new (end()) T(x);
+          m_size++;
+        }
+
+        void unchecked_push_back (value_type&& x){
+          BOOST_ASSERT(size() < capacity());
+          new (end()) T(boost::move(x));
+          m_size++;
+        }
+
+        template<typename... Args>
+        reference emplace_back (Args&&... args){
+          if(size() == capacity()){
+            // args may refer to an element that is about to be relocated
+            value_type x(boost::forward<Args>(args)...);
+            reserve_for(size()+1);
+            unchecked_push_back(boost::move(x));
+          } else {
+            new (end()) T(boost::forward<Args>(args)...);
+            m_size++;
+          }
+          return back();
+        }
+
+        template<typename... Args>
+        iterator emplace (const_iterator pos, Args&&... args){
+          value_type x(boost::forward<Args>(args)...);
+          return insert(pos,boost::move(x));
+        }
+
+        void pop_back(){
+          BOOST_ASSERT(!empty());
+          m_size--;
+          end()->~T();
+        }
+
+        iterator insert(const_iterator pos, const_reference x){
+          value_type copy(x);
+          return insert(pos,boost::move(copy));
+        }
+
+        iterator insert(const_iterator pos, value_type&& x){
+          size_type index = pos-begin();
+          reserve_for(size()+1);
+          iterator p = begin()+index;
+          if(p == end()){
+            unchecked_push_back(boost::move(x));
+          } else {
+            insert_gap(p,1,is_trivially_relocatable<T>());
+            BOOST_TRY {
+              construct_in_gap(p,boost::move(x),is_trivially_relocatable<T>());
+            } BOOST_CATCH(...) {
+              close_gap(p,1);
+              BOOST_RETHROW;
+            } BOOST_CATCH_END
+          }
+          return p;
+        }
+
+        iterator insert(const_iterator pos, size_type n, const_reference x){
+          size_type index = pos-begin();
+          // x may refer to an element that is about to be shifted
+          value_type copy(x);
+          reserve_for(size()+n);
+          iterator p = begin()+index;
+          if(is_trivially_relocatable<T>::value){
+            insert_gap(p,n,boost::true_type());
+            BOOST_TRY {
+              std::uninitialized_fill_n(p,n,copy);
+            } BOOST_CATCH(...) {
+              close_gap(p,n);
+              BOOST_RETHROW;
+            } BOOST_CATCH_END
+          } else {
+            append_and_rotate(p,n,copy);
+          }
+          return p;
+        }
+
+        template <typename InputIterator>
+        typename boost::disable_if<boost::is_integral<InputIterator>, iterator>::type
+        insert(const_iterator pos, InputIterator first, InputIterator last){
+          size_type index = pos-begin();
+          insert_range(index,first,last,typename std::iterator_traits<InputIterator>::iterator_category());
+          return begin()+index;
+        }
+
+        iterator erase(const_iterator pos){
+          return erase(pos,pos+1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+          BOOST_ASSERT(begin() <= first && first <= last && last <= end());
+          iterator f = begin()+(first-begin());
+          iterator l = begin()+(last-begin());
+          if(is_trivially_relocatable<T>::value){
+            destroy_range(f,l);
+            std::memmove(static_cast<void*>(f), static_cast<const void*>(l), sizeof(T)*(end()-l));
+          } else {
+            iterator new_end = boost::move(l,end(),f);
+            destroy_range(new_end,end());
+          }
+          m_size -= l-f;
+          return f;
+        }
+
+        void clear(){
+          destroy_range(begin(),end());
+          m_size = 0;
+        }
+
+        void resize(size_type n, const_reference t = T()){
+          if(n > size()){
+            insert(end(),n-size(),t);
+          } else {
+            erase(begin()+n,end());
+          }
+        }
+
+        void reserve(size_type n){
+          reserve_for(n);
+        }
+
+        // moves the elements back into the inline storage when they fit, otherwise into an exactly sized buffer
+        void shrink_to_fit(){
+          if(is_inline() || size() == capacity()){
+            return;
+          }
+          if(size() <= N){
+            relocate_elements(begin(),end(),inline_data());
+            alloc_traits::deallocate(get_allocator_ref(),m_data,m_capacity);
+            m_data = inline_data();
+            m_capacity = N;
+          } else {
+            reallocate(size());
+          }
+        }
+
+        // operator[]
+        reference operator[](size_type i)
+        {
+            BOOST_ASSERT( i < size() && "SmallVector<>: out of range" );
+            return m_data[i];
+        }
+
+        const_reference operator[](size_type i) const
+        {
+            BOOST_ASSERT( i < size() && "SmallVector<>: out of range" );
+            return m_data[i];
+        }
+
+        // at() with range check
+        reference at(size_type i) { rangecheck(i); return m_data[i]; }
+        const_reference at(size_type i) const { rangecheck(i); return m_data[i]; }
+
+        // front() and back()
+        reference front() { return *begin(); }
+        const_reference front() const { return *begin(); }
+        reference back() { return *(end()-1); }
+        const_reference back() const { return *(end()-1); }
+
+        // capacity starts at N and only grows past it once the elements spill to the heap
+        size_type size() const { return m_size; }
+        size_type capacity() const { return m_capacity; }
+        bool empty() const { return size() == 0; }
+        size_type max_size() const {
+          return OverflowPolicy::can_allocate ? alloc_traits::max_size(get_allocator_ref()) : N;
+        }
+        static size_type inline_capacity() { return N; }
+        enum { static_size = N };
+
+        // true while the elements live in the inline storage
+        bool is_inline() const { return m_data == inline_data(); }
+
+        // swap (note: linear unless both vectors are on the heap and their buffers may change hands,
+        // i.e. the allocators propagate on swap or compare equal)
+        void swap (SmallVector& y) {
+            if(!is_inline() && !y.is_inline()
+               && (alloc_traits::propagate_on_container_swap::value || get_allocator_ref() == y.get_allocator_ref())){
+              swap_allocators(y, std::integral_constant<bool, alloc_traits::propagate_on_container_swap::value>());
+              std::swap(m_data,y.m_data);
+              std::swap(m_size,y.m_size);
+              std::swap(m_capacity,y.m_capacity);
+              return;
+            }
+            SmallVector tmp(boost::move(y));
+            y = boost::move(*this);
+            *this = boost::move(tmp);
+        }
+
+        // direct access to data
+        const_pointer data() const { return m_data; }
+        pointer data() { return m_data; }
+
+        // check range (may not be private because it is not static)
+        // throws on failure
+        // returns: 0 on success, 1 otherwise when exceptions are disabled
+        bool rangecheck (size_type i) const {
+          bool failure(i >= size());
+          if (failure) {
+              std::out_of_range e("SmallVector<>: index out of range");
+              BOOST_THROW_EXCEPTION(e);
+          }
+          return failure;
+        }
+
+private:
+       inline pointer inline_data() { return reinterpret_cast<pointer>(elems); }
+       inline const_pointer inline_data() const { return reinterpret_cast<const_pointer>(elems); }
+
+       allocator_type& get_allocator_ref() { return alloc_holder::get(); }
+       const allocator_type& get_allocator_ref() const { return alloc_holder::get(); }
+
+       // make room for n elements, leaving the inline storage if the policy allows it
+       void reserve_for(size_type n){
+          if(n <= capacity()){
+            return;
+          }
+          if(!OverflowPolicy::can_allocate){
+            std::out_of_range e("SmallVector<>: index out of capacity");
+            BOOST_THROW_EXCEPTION(e);
+          }
+          if(n > max_size()){
+            std::length_error e("SmallVector<>: size exceeds max_size()");
+            BOOST_THROW_EXCEPTION(e);
+          }
+          reallocate((std::min)(max_size(),OverflowPolicy::next_capacity(N,capacity(),n)));
+       }
+
+       void reallocate(size_type new_capacity){
+          pointer p = alloc_traits::allocate(get_allocator_ref(),new_capacity);
+          BOOST_TRY {
+            relocate_elements(begin(),end(),p);
+          } BOOST_CATCH(...) {
+            alloc_traits::deallocate(get_allocator_ref(),p,new_capacity);
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+          release();
+          m_data = p;
+          m_capacity = new_capacity;
+       }
+
+       void swap_allocators(SmallVector& y, const std::true_type&){
+          boost::swap(get_allocator_ref(), y.get_allocator_ref());
+       }
+
+       void swap_allocators(SmallVector& /*y*/, const std::false_type&){}
+
+       // give the heap buffer back, the elements must already be destroyed or relocated
+       void release(){
+          if(!is_inline()){
+            alloc_traits::deallocate(get_allocator_ref(),m_data,m_capacity);
+            m_data = inline_data();
+            m_capacity = N;
+          }
+       }
+
+       // take over the contents of rhs, which must not own any elements or buffer
+       void steal(SmallVector& rhs){
+          BOOST_ASSERT(empty() && is_inline());
+          if(rhs.is_inline()){
+            relocate_elements(rhs.begin(),rhs.end(),inline_data());
+          } else {
+            m_data = rhs.m_data;
+            m_capacity = rhs.m_capacity;
+            rhs.m_data = rhs.inline_data();
+            rhs.m_capacity = N;
+          }
+          m_size = rhs.m_size;
+          rhs.m_size = 0;
+       }
+
+       // move the objects in [first,last) into raw storage at result and end the lifetime of the originals
+       static void relocate_elements(pointer first, pointer last, pointer result){
+          if(is_trivially_relocatable<T>::value){
+            std::memcpy(static_cast<void*>(result), static_cast<const void*>(first), sizeof(T)*(last-first));
+          } else {
+            boost::uninitialized_move(first,last,result);
+            destroy_range(first,last);
+          }
+       }
+
+       static void destroy_range(pointer first, pointer last){
+          if(!boost::has_trivial_destructor<T>::value){
+            for(; first != last; ++first){
+              first->~T();
+            }
+          }
+       }
+
+       // T is relocatable, memmove the tail up by n leaving raw storage at [pos,pos+n)
+       void insert_gap(iterator pos, size_type n, const boost::true_type&){
+          std::memmove(static_cast<void*>(pos+n), static_cast<const void*>(pos), sizeof(T)*(end()-pos));
+          m_size += n;
+       }
+
+       // shift the tail up by one leaving a moved-from element at pos, pos must not be end()
+       void insert_gap(iterator pos, size_type n, const boost::false_type&){
+          BOOST_ASSERT(n == 1 && pos != end());
+          iterator old_end = end();
+          new (old_end) T(boost::move(*(old_end-1)));
+          m_size += n;
+          boost::move_backward(pos,old_end-1,old_end);
+       }
+
+       void construct_in_gap(iterator pos, value_type&& x, const boost::true_type&){
+          new (pos) T(boost::move(x));
+       }
+
+       void construct_in_gap(iterator pos, value_type&& x, const boost::false_type&){
+          *pos = boost::move(x);
+       }
+
+       // undo insert_gap after constructing into the gap failed
+       void close_gap(iterator pos, size_type n){
+          if(is_trivially_relocatable<T>::value){
+            m_size -= n;
+            std::memmove(static_cast<void*>(pos), static_cast<const void*>(pos+n), sizeof(T)*(end()-pos));
+          } else {
+            erase(pos,pos+n);
+          }
+       }
+
+       // single pass input, append and rotate into place
+       template<typename InputIterator>
+       void insert_range(size_type index, InputIterator first, InputIterator last, std::input_iterator_tag){
+          size_type old_size = size();
+          BOOST_TRY {
+            for(; first != last; ++first){
+              emplace_back(*first);
+            }
+          } BOOST_CATCH(...) {
+            erase(begin()+old_size,end());
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+          std::rotate(begin()+index,begin()+old_size,end());
+       }
+
+       // the length is known up front, reserve once and copy straight into the gap when possible
+       template<typename ForwardIterator>
+       void insert_range(size_type index, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag){
+          size_type n = std::distance(first,last);
+          reserve_for(size()+n);
+          iterator p = begin()+index;
+          if(is_trivially_relocatable<T>::value){
+            insert_gap(p,n,boost::true_type());
+            BOOST_TRY {
+              std::uninitialized_copy(first,last,p);
+            } BOOST_CATCH(...) {
+              close_gap(p,n);
+              BOOST_RETHROW;
+            } BOOST_CATCH_END
+          } else {
+            append_and_rotate(p,first,last);
+          }
+       }
+
+       // T is not relocatable, construct the new elements at the end and rotate them into place
+       void append_and_rotate(iterator pos, size_type n, const_reference x){
+          size_type old_size = size();
+          BOOST_TRY {
+            for(; n > 0; --n){
+              unchecked_push_back(x);
+            }
+          } BOOST_CATCH(...) {
+            erase(begin()+old_size,end());
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+          std::rotate(pos,begin()+old_size,end());
+       }
+
+       template<typename ForwardIterator>
+       void append_and_rotate(iterator pos, ForwardIterator first, ForwardIterator last){
+          size_type old_size = size();
+          BOOST_TRY {
+            for(; first != last; ++first){
+              unchecked_push_back(*first);
+            }
+          } BOOST_CATCH(...) {
+            erase(begin()+old_size,end());
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+          std::rotate(pos,begin()+old_size,end());
+       }
+}; // class SmallVector
+
+    // comparisons
+    template<class T, std::size_t N, class A, class P>
+    bool operator== (const SmallVector<T,N,A,P>& x, const SmallVector<T,N,A,P>& y) {
+        return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+    }
+    template<class T, std::size_t N, class A, class P>
+    bool operator< (const SmallVector<T,N,A,P>& x, const SmallVector<T,N,A,P>& y) {
+        return std::lexicographical_compare(x.begin(),x.end(),y.begin(),y.end());
+    }
+    template<class T, std::size_t N, class A, class P>
+    bool operator!= (const SmallVector<T,N,A,P>& x, const SmallVector<T,N,A,P>& y) {
+        return !(x==y);
+    }
+    template<class T, std::size_t N, class A, class P>
+    bool operator> (const SmallVector<T,N,A,P>& x, const SmallVector<T,N,A,P>& y) {
+        return y<x;
+    }
+    template<class T, std::size_t N, class A, class P>
+    bool operator<= (const SmallVector<T,N,A,P>& x, const SmallVector<T,N,A,P>& y) {
+        return !(y<x);
+    }
+    template<class T, std::size_t N, class A, class P>
+    bool operator>= (const SmallVector<T,N,A,P>& x, const SmallVector<T,N,A,P>& y) {
+        return !(x<y);
+    }
+
+    // global swap()
+    template<class T, std::size_t N, class A, class P>
+    inline void swap (SmallVector<T,N,A,P>& x, SmallVector<T,N,A,P>& y) {
+        x.swap(y);
+    }
+
+} // namespace boost
+
+#endif /*BOOST_SMALL_VECTOR_HPP*/
@@ -0,0 +1,266 @@
+/**
+ *  @file   SmallVectorTests.cpp
+ *  @brief  SmallVectorTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  SmallVector is not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <SmallVector.hpp>
+#include <StaticVectorTestTypes.hpp>
+#include <boost/iterator/iterator_adaptor.hpp>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+using namespace boost;
+
+// std::allocator that counts the allocations it performs; instances with different ids
+// compare unequal, and outstanding[id] is the number of elements allocated but not
+// yet deallocated through an allocator with that id
+template <typename T>
+struct countingAllocator : std::allocator<T> {
+  typedef T value_type;
+  typedef std::false_type is_always_equal;
+  template <typename U> struct rebind { typedef countingAllocator<U> other; };
+  explicit countingAllocator(int id = 0):id(id){}
+  template <typename U> countingAllocator(const countingAllocator<U>& rhs):id(rhs.id){}
+  T* allocate(std::size_t n){ allocations++; outstanding[id] += n; return std::allocator<T>::allocate(n); }
+  void deallocate(T* p, std::size_t n){ deallocations++; outstanding[id] -= n; std::allocator<T>::deallocate(p,n); }
+  int id;
+  static std::size_t allocations;
+  static std::size_t deallocations;
+  static long outstanding[3];
+};
+template <typename T> std::size_t countingAllocator<T>::allocations = 0;
+template <typename T> std::size_t countingAllocator<T>::deallocations = 0;
+template <typename T> long countingAllocator<T>::outstanding[3] = {0, 0, 0};
+
+template <typename T, typename U>
+bool operator==(const countingAllocator<T>& x, const countingAllocator<U>& y){ return x.id == y.id; }
+template <typename T, typename U>
+bool operator!=(const countingAllocator<T>& x, const countingAllocator<U>& y){ return x.id != y.id; }
+
+#define SMALL_SIZE 4
+
+BOOST_AUTO_TEST_CASE(SmallVectorStaysInline){
+  typedef countingAllocator<std::size_t> alloc;
+  alloc::allocations = 0;
+  SmallVector<std::size_t,SMALL_SIZE,alloc> vec;
+  for(std::size_t i = 0; i < SMALL_SIZE; i++){
+    vec.push_back(i);
+  }
+  BOOST_CHECK(vec.is_inline());
+  BOOST_CHECK_EQUAL(vec.size(),SMALL_SIZE);
+  BOOST_CHECK_EQUAL(vec.capacity(),SMALL_SIZE);
+  BOOST_CHECK_EQUAL(alloc::allocations,0);
+}
+
+BOOST_AUTO_TEST_CASE(SmallVectorSpillsToHeap){
+  typedef countingAllocator<std::string> alloc;
+  alloc::allocations = 0;
+  alloc::deallocations = 0;
+  {
+    SmallVector<std::string,SMALL_SIZE,alloc> vec;
+    std::vector<std::string> stdvec;
+    for(std::size_t i = 0; i < SMALL_SIZE*3; i++){
+      vec.push_back(std::string(20,'a'+i));
+      stdvec.push_back(std::string(20,'a'+i));
+    }
+    BOOST_CHECK(!vec.is_inline());
+    BOOST_CHECK_EQUAL(alloc::allocations,2);
+    BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+    
+    vec.erase(vec.begin()+1,vec.end()-2);
+    vec.shrink_to_fit();
+    BOOST_CHECK(vec.is_inline());
+    BOOST_CHECK_EQUAL(vec.size(),3);
+    BOOST_CHECK_EQUAL(vec[0],stdvec[0]);
+    BOOST_CHECK_EQUAL(vec[2],stdvec.back());
+  }
+  BOOST_CHECK_EQUAL(alloc::allocations,alloc::deallocations);
+}
+
+BOOST_AUTO_TEST_CASE(SmallVectorSpillPolicy){
+  SmallVector<std::size_t,SMALL_SIZE,std::allocator<std::size_t>,small_vector_spill> vec;
+  vec.resize(SMALL_SIZE+1);
+  BOOST_CHECK_EQUAL(vec.capacity(),SMALL_SIZE*2);
+  vec.resize(SMALL_SIZE*2+1);
+  BOOST_CHECK_EQUAL(vec.capacity(),SMALL_SIZE*3);
+}
+
+BOOST_AUTO_TEST_CASE(SmallVectorThrowPolicy){
+  SmallVector<std::size_t,SMALL_SIZE,std::allocator<std::size_t>,small_vector_throw> vec(SMALL_SIZE,7);
+  BOOST_CHECK_EQUAL(vec.max_size(),SMALL_SIZE);
+  BOOST_CHECK_THROW(vec.push_back(8),std::out_of_range);
+  BOOST_CHECK_EQUAL(vec.size(),SMALL_SIZE);
+  BOOST_CHECK(vec.is_inline());
+}
+
+BOOST_AUTO_TEST_CASE(SmallVectorInsertEraseMatchStdVector){
+  SmallVector<std::string,SMALL_SIZE> vec;
+  std::vector<std::string> stdvec;
+  const char* words[] = {"a","b","c","d","e","f"};
+  
+  vec.insert(vec.end(),words,words+3);
+  stdvec.insert(stdvec.end(),words,words+3);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+  
+  vec.insert(vec.begin()+1,words+3,words+6);
+  stdvec.insert(stdvec.begin()+1,words+3,words+6);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+  
+  vec.insert(vec.begin(),2,vec[3]);
+  stdvec.insert(stdvec.begin(),2,stdvec[3]);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+  
+  vec.emplace(vec.begin()+4,3,'x');
+  stdvec.emplace(stdvec.begin()+4,3,'x');
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+  
+  vec.erase(vec.begin()+2);
+  stdvec.erase(stdvec.begin()+2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+}
+
+BOOST_AUTO_TEST_CASE(SmallVectorTrivialInsert){
+  SmallVector<std::size_t,SMALL_SIZE> vec(3,1);
+  std::vector<std::size_t> stdvec(3,1);
+  vec.insert(vec.begin()+1,4,2);
+  stdvec.insert(stdvec.begin()+1,4,2);
+  vec.insert(vec.begin(),vec.back());
+  stdvec.insert(stdvec.begin(),stdvec.back());
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+}
+
+BOOST_AUTO_TEST_CASE(SmallVectorMoveAndSwap){
+  SmallVector<std::string,SMALL_SIZE> heap;
+  SmallVector<std::string,SMALL_SIZE> inl;
+  for(std::size_t i = 0; i < SMALL_SIZE*2; i++){
+    heap.push_back(std::string(1,'a'+i));
+  }
+  inl.push_back("z");
+  const std::string* buffer = heap.data();
+  
+  SmallVector<std::string,SMALL_SIZE> moved(std::move(heap));
+  BOOST_CHECK(moved.data() == buffer);
+  BOOST_CHECK(heap.empty());
+  BOOST_CHECK(heap.is_inline());
+  
+  moved.swap(inl);
+  BOOST_CHECK_EQUAL(moved.size(),1);
+  BOOST_CHECK_EQUAL(moved[0],"z");
+  BOOST_CHECK(inl.data() == buffer);
+  BOOST_CHECK_EQUAL(inl.size(),SMALL_SIZE*2);
+  
+  SmallVector<std::string,SMALL_SIZE> copy(inl);
+  BOOST_CHECK(copy == inl);
+  copy = moved;
+  BOOST_CHECK(copy == moved);
+  BOOST_CHECK(inl < copy);
+}
+
+BOOST_AUTO_TEST_CASE(SmallVectorSwapUnequalAllocators){
+  typedef countingAllocator<std::string> alloc;
+  typedef SmallVector<std::string,2,alloc> Strings;
+  {
+    Strings a((alloc(1)));
+    Strings b((alloc(2)));
+    for(std::size_t i = 0; i < 4; i++){
+      a.push_back(std::string(20,'a'+i));
+      b.push_back(std::string(20,'z'-i));
+    }
+    b.push_back("last");
+    BOOST_CHECK(!a.is_inline() && !b.is_inline());
+    
+    // the allocators do not propagate, so the buffers must not change hands
+    a.swap(b);
+    BOOST_CHECK_EQUAL(a.size(),5u);
+    BOOST_CHECK_EQUAL(b.size(),4u);
+    BOOST_CHECK_EQUAL(a.back(),"last");
+    BOOST_CHECK_EQUAL(b.front(),std::string(20,'a'));
+    BOOST_CHECK_EQUAL(a.get_allocator().id,1);
+    BOOST_CHECK_EQUAL(b.get_allocator().id,2);
+  }
+  BOOST_CHECK_EQUAL(alloc::outstanding[1],0);
+  BOOST_CHECK_EQUAL(alloc::outstanding[2],0);
+}
+
+BOOST_AUTO_TEST_CASE(SmallVectorMovesInStdVector){
+  typedef SmallVector<std::string,SMALL_SIZE> Strings;
+  BOOST_STATIC_ASSERT(std::is_nothrow_move_constructible<Strings>::value);
+  BOOST_STATIC_ASSERT(std::is_nothrow_move_assignable<Strings>::value);
+
+  // reallocation moves the elements, so heap buffers are handed over rather than copied
+  std::vector<Strings> rows(1);
+  for(std::size_t i = 0; i < SMALL_SIZE*2; i++){
+    rows[0].push_back(std::string(20,'a'+i));
+  }
+  const std::string* buffer = rows[0].data();
+  for(std::size_t i = 0; i < 100; i++){
+    rows.push_back(Strings(1,"x"));
+  }
+  BOOST_CHECK(rows[0].data() == buffer);
+  BOOST_CHECK_EQUAL(rows[0].size(),SMALL_SIZE*2);
+}
+
+BOOST_AUTO_TEST_CASE(SmallVectorConstructionIsExceptionSafe){
+  typedef countingAllocator<Tracked> alloc;
+  typedef SmallVector<Tracked,2,alloc> TrackedVector;
+  {
+    Tracked::copies_left = 100;
+    TrackedVector rows(8,Tracked());
+    std::vector<Tracked> source(8);
+    BOOST_CHECK_EQUAL(Tracked::live,16);
+    alloc::allocations = 0;
+    alloc::deallocations = 0;
+
+    // each of these has spilled to the heap by the time the 5th copy throws
+    Tracked::copies_left = 4;
+    BOOST_CHECK_THROW(TrackedVector copy(rows),std::runtime_error);
+    Tracked::copies_left = 4;
+    BOOST_CHECK_THROW(TrackedVector copy(source.begin(),source.end()),std::runtime_error);
+    Tracked::copies_left = 4;
+    BOOST_CHECK_THROW(TrackedVector copy(8,source.front()),std::runtime_error);
+    BOOST_CHECK_EQUAL(Tracked::live,16);
+    BOOST_CHECK_EQUAL(alloc::allocations,3);
+    BOOST_CHECK_EQUAL(alloc::deallocations,3);
+
+    Tracked::copies_left = 100;
+    TrackedVector copy(rows);
+    BOOST_CHECK_EQUAL(Tracked::live,24);
+  }
+  BOOST_CHECK_EQUAL(Tracked::live,0);
+}
+
+// restricts an iterator to single pass traversal, so ranges take the input iterator path
+template <typename Iterator>
+struct inputOnly : boost::iterator_adaptor<inputOnly<Iterator>,Iterator,boost::use_default,boost::single_pass_traversal_tag> {
+  explicit inputOnly(Iterator it):inputOnly::iterator_adaptor_(it){}
+};
+
+BOOST_AUTO_TEST_CASE(SmallVectorInputRangeInsertIsExceptionSafe){
+  typedef SmallVector<Tracked,2> TrackedVector;
+  BOOST_STATIC_ASSERT((boost::is_same<std::iterator_traits<inputOnly<std::vector<Tracked>::iterator> >::iterator_category,
+                                      std::input_iterator_tag>::value));
+  {
+    Tracked::copies_left = 100;
+    TrackedVector rows(3,Tracked());
+    std::vector<Tracked> source(8);
+    BOOST_CHECK_EQUAL(Tracked::live,11);
+    
+    Tracked::copies_left = 4;
+    BOOST_CHECK_THROW(rows.insert(rows.begin()+1,inputOnly<std::vector<Tracked>::iterator>(source.begin()),
+                                  inputOnly<std::vector<Tracked>::iterator>(source.end())),std::runtime_error);
+    BOOST_CHECK_EQUAL(rows.size(),3u);
+    BOOST_CHECK_EQUAL(Tracked::live,11);
+    Tracked::copies_left = 100;
+  }
+  BOOST_CHECK_EQUAL(Tracked::live,0);
+}
@@ -0,0 +1,580 @@
+/**
+ * @file   StaticBitVector.hpp
+ * @brief  Fixed capacity vector of bits packed into 64 bit words.
+ *
+ * StaticBitVector<N> holds up to N flags packed into 64 bit words, one eighth
+ * of the memory of N bools. Element access goes through a proxy reference as
+ * in std::vector<bool>. push_back, pop_back, resize and clear behave like
+ * StaticVector: capacity and range checks go through the same StatsPolicy
+ * and ErrorPolicy parameters, so by default they throw std::out_of_range,
+ * and try_push_back() returns false instead. Elements are not inserted or
+ * erased in the middle, so there is no try_insert().
+ *
+ * Whole-vector operations work a word at a time: count() uses popcount,
+ * find_first()/find_next() use count trailing zeros, all()/any()/none() and
+ * the bitwise operators combine 64 flags per step. With -march=native (or
+ * -mpopcnt -mbmi) these are single instructions.
+ *
+ * Only the words covering [0, size()) are ever read, and their bits past
+ * size() are kept zero, so like StaticVector nothing is initialized on
+ * construction beyond the size.
+ *
+ * Bit packing is opt-in: StaticVector<bool, N> stays an ordinary StaticVector
+ * of bools with the full interface, and StaticBitVector<N> is used by name
+ * where the memory and the word-parallel operations are worth the proxy
+ * references and the missing middle insert and erase.
+ *
+ *  StaticBitVector is not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_BIT_VECTOR_HPP
+#define BOOST_STATIC_BIT_VECTOR_HPP
+
+#include "StaticVector.hpp"
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/integer.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace boost {
+
+  namespace detail {
+        // number of set bits
+        inline unsigned popcount64(boost::uint64_t w){
+#if defined(__GNUC__) || defined(__clang__)
+          return static_cast<unsigned>(__builtin_popcountll(w));
+#elif defined(_MSC_VER) && defined(_M_X64)
+          return static_cast<unsigned>(__popcnt64(w));
+#else
+          w = w - ((w >> 1) & 0x5555555555555555ULL);
+          w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+          w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+          return static_cast<unsigned>((w * 0x0101010101010101ULL) >> 56);
+#endif
+        }
+
+        // index of the lowest set bit, w must not be 0
+        inline unsigned count_trailing_zeros64(boost::uint64_t w){
+          BOOST_ASSERT(w != 0);
+#if defined(__GNUC__) || defined(__clang__)
+          return static_cast<unsigned>(__builtin_ctzll(w));
+#elif defined(_MSC_VER) && defined(_M_X64)
+          unsigned long index;
+          _BitScanForward64(&index, w);
+          return static_cast<unsigned>(index);
+#else
+          unsigned n = 0;
+          for(; !(w & 1); w >>= 1){
+            ++n;
+          }
+          return n;
+#endif
+        }
+
+        // proxy reference to one bit of a word
+        template<typename Word>
+        class bit_reference {
+          public:
+            bit_reference(Word* word, Word mask):m_word(word),m_mask(mask){}
+            operator bool() const { return (*m_word & m_mask) != 0; }
+            bool operator~() const { return !static_cast<bool>(*this); }
+            bit_reference& operator=(bool x){
+              if(x){
+                *m_word |= m_mask;
+              } else {
+                *m_word &= ~m_mask;
+              }
+              return *this;
+            }
+            bit_reference& operator=(const bit_reference& x){ return *this = static_cast<bool>(x); }
+            bit_reference& flip(){ *m_word ^= m_mask; return *this; }
+          private:
+            Word* m_word;
+            Word  m_mask;
+        };
+
+        // random access iterator over the bits of a StaticBitVector, dereferences to a proxy or a bool
+        template<typename Word, bool Const>
+        class bit_iterator
+          : public boost::iterator_facade< bit_iterator<Word, Const>,
+                                           bool,
+                                           boost::random_access_traversal_tag,
+                                           typename boost::mpl::if_c< Const, bool, bit_reference<Word> >::type >
+        {
+            typedef typename boost::mpl::if_c< Const, const Word, Word >::type word_type;
+            typedef typename boost::mpl::if_c< Const, bool, bit_reference<Word> >::type reference_type;
+          public:
+            bit_iterator():m_words(0),m_index(0){}
+            bit_iterator(word_type* words, std::size_t index):m_words(words),m_index(index){}
+
+            // iterator to const_iterator conversion
+            bit_iterator(const bit_iterator<Word, false>& rhs):m_words(rhs.words()),m_index(rhs.index()){}
+
+            word_type* words() const { return m_words; }
+            std::size_t index() const { return m_index; }
+
+          private:
+            friend class boost::iterator_core_access;
+
+            reference_type dereference() const {
+              return dereference(boost::integral_constant<bool, Const>());
+            }
+            bool dereference(boost::true_type) const {
+              return (m_words[m_index / 64] >> (m_index % 64)) & 1;
+            }
+            reference_type dereference(boost::false_type) const {
+              return reference_type(m_words + m_index / 64, Word(1) << (m_index % 64));
+            }
+
+            template<bool OtherConst>
+            bool equal(const bit_iterator<Word, OtherConst>& rhs) const { return m_index == rhs.index(); }
+            void increment() { ++m_index; }
+            void decrement() { --m_index; }
+            void advance(std::ptrdiff_t n) { m_index += n; }
+            template<bool OtherConst>
+            std::ptrdiff_t distance_to(const bit_iterator<Word, OtherConst>& rhs) const {
+              return static_cast<std::ptrdiff_t>(rhs.index()) - static_cast<std::ptrdiff_t>(m_index);
+            }
+
+            word_type*  m_words;
+            std::size_t m_index;
+        };
+  } // namespace detail
+
+    // StatsPolicy and ErrorPolicy are those of StaticVector, see StaticVector.hpp
+    template<std::size_t N, typename size_type_t = typename boost::uint_value_t<N>::least,
+             class StatsPolicy = static_vector_no_stats, class ErrorPolicy = static_vector_throw_on_error>
+    class StaticBitVector {
+      public:
+        // type definitions
+        typedef boost::uint64_t                                word_type;
+        typedef bool                                           value_type;
+        typedef detail::bit_reference<word_type>               reference;
+        typedef bool                                           const_reference;
+        typedef size_type_t                                    size_type;
+        typedef size_type                                      max_size_type;
+        typedef std::ptrdiff_t                                 difference_type;
+        typedef detail::bit_iterator<word_type, false>         iterator;
+        typedef detail::bit_iterator<word_type, true>          const_iterator;
+        typedef StatsPolicy                                    stats_policy;
+        typedef ErrorPolicy                                    error_policy;
+
+        enum { static_size = N };
+        enum { bits_per_word = 64 };
+        // at least one word, so StaticBitVector<0> is a valid type
+        enum { word_count = N ? (N + bits_per_word - 1) / bits_per_word : 1 };
+
+        // returned by find_first() and find_next() when there is no set bit
+        static const std::size_t npos = static_cast<std::size_t>(-1);
+
+      private:
+        size_type m_size;
+        word_type m_words[word_count];   // words past used_words() are not initialized
+
+      public:
+
+        StaticBitVector():m_size(0){}
+
+        StaticBitVector(size_type n, bool value):m_size(0){
+          resize(n, value);
+        }
+
+        // two integers are a count and a value as in std::vector
+        template<typename InputIterator>
+        StaticBitVector(InputIterator first, InputIterator last):m_size(0){
+          construct(first, last, boost::is_integral<InputIterator>());
+        }
+
+        StaticBitVector(const StaticBitVector& rhs):m_size(rhs.m_size){
+          StatsPolicy::copy();
+          std::copy(rhs.m_words, rhs.m_words + rhs.used_words(), m_words);
+          grown();
+        }
+
+        StaticBitVector& operator=(const StaticBitVector& rhs){
+          StatsPolicy::copy();
+          std::copy(rhs.m_words, rhs.m_words + rhs.used_words(), m_words);
+          m_size = rhs.m_size;
+          return *this;
+        }
+
+        // iterator support
+        iterator        begin()       { return iterator(m_words, 0); }
+        const_iterator  begin() const { return const_iterator(m_words, 0); }
+        const_iterator cbegin() const { return const_iterator(m_words, 0); }
+        iterator        end()       { return iterator(m_words, m_size); }
+        const_iterator  end() const { return const_iterator(m_words, m_size); }
+        const_iterator cend() const { return const_iterator(m_words, m_size); }
+
+        void push_back(bool x){
+          if(capacitycheck(size()+1)){
+            return;
+          }
+          unchecked_push_back(x);
+        }
+
+        // push_back that returns false instead of failing through the error policy when the vector is full
+        bool try_push_back(bool x){
+          if(capacity_exceeded(size()+1)){
+            return false;
+          }
+          unchecked_push_back(x);
+          return true;
+        }
+
+        template<typename... Args>
+        bool try_emplace_back(Args&&... args){
+          return try_push_back(bool(boost::forward<Args>(args)...));
+        }
+
+        template<typename... Args>
+        void emplace_back(Args&&... args){
+          push_back(bool(boost::forward<Args>(args)...));
+        }
+
+        // the caller guarantees that the vector is not full
+        void unchecked_push_back(bool x){
+          BOOST_ASSERT( !full() && "StaticBitVector<>: unchecked_push_back past the capacity" );
+          if(m_size % bits_per_word == 0){
+            m_words[m_size / bits_per_word] = 0;
+          }
+          if(x){
+            m_words[m_size / bits_per_word] |= bit(m_size);
+          }
+          m_size++;
+          grown();
+        }
+
+        void pop_back(){
+          BOOST_ASSERT(!empty());
+          m_size--;
+          m_words[m_size / bits_per_word] &= ~bit(m_size);
+        }
+
+        void clear(){
+          m_size = 0;
+        }
+
+        void resize(max_size_type n, bool value = false){
+          if(capacitycheck(n)){
+            return;
+          }
+          unchecked_resize(n, value);
+        }
+
+        void reserve(max_size_type n){
+          capacitycheck(n);
+        }
+
+        // element access
+        reference operator[](max_size_type i){
+          BOOST_ASSERT( i < size() && "StaticBitVector<>: out of range" );
+          return reference(m_words + i / bits_per_word, bit(i));
+        }
+        const_reference operator[](max_size_type i) const {
+          BOOST_ASSERT( i < size() && "StaticBitVector<>: out of range" );
+          return test(i);
+        }
+
+        reference at(max_size_type i) { rangecheck(i); return (*this)[i]; }
+        const_reference at(max_size_type i) const { rangecheck(i); return (*this)[i]; }
+
+        reference front() { return (*this)[0]; }
+        const_reference front() const { return (*this)[0]; }
+        reference back() { return (*this)[size()-1]; }
+        const_reference back() const { return (*this)[size()-1]; }
+
+        bool test(max_size_type i) const { return (m_words[i / bits_per_word] & bit(i)) != 0; }
+        StaticBitVector& set(max_size_type i, bool value = true) { (*this)[i] = value; return *this; }
+        StaticBitVector& reset(max_size_type i) { (*this)[i] = false; return *this; }
+        StaticBitVector& flip(max_size_type i) { (*this)[i].flip(); return *this; }
+
+        // set, clear or flip all bits in [0, size())
+        StaticBitVector& set(){
+          std::fill(m_words, m_words + used_words(), ~word_type(0));
+          clear_tail();
+          return *this;
+        }
+        StaticBitVector& reset(){
+          std::fill(m_words, m_words + used_words(), word_type(0));
+          return *this;
+        }
+        StaticBitVector& flip(){
+          for(std::size_t w = 0; w < used_words(); ++w){
+            m_words[w] = ~m_words[w];
+          }
+          clear_tail();
+          return *this;
+        }
+
+        // number of set bits
+        std::size_t count() const {
+          std::size_t n = 0;
+          for(std::size_t w = 0; w < used_words(); ++w){
+            n += detail::popcount64(m_words[w]);
+          }
+          return n;
+        }
+
+        // true if every bit is set, also for an empty vector
+        bool all() const {
+          std::size_t full_words = m_size / bits_per_word;
+          for(std::size_t w = 0; w < full_words; ++w){
+            if(m_words[w] != ~word_type(0)){
+              return false;
+            }
+          }
+          return m_size % bits_per_word == 0 || m_words[full_words] == low_bits(m_size);
+        }
+
+        bool any() const {
+          for(std::size_t w = 0; w < used_words(); ++w){
+            if(m_words[w]){
+              return true;
+            }
+          }
+          return false;
+        }
+
+        bool none() const { return !any(); }
+
+        // index of the first set bit, npos if there is none
+        std::size_t find_first() const {
+          return find_from_word(0);
+        }
+
+        // index of the first set bit after pos, npos if there is none
+        std::size_t find_next(std::size_t pos) const {
+          ++pos;
+          if(pos >= size()){
+            return npos;
+          }
+          std::size_t w = pos / bits_per_word;
+          word_type rest = m_words[w] & ~low_bits(pos);
+          if(rest){
+            return w * bits_per_word + detail::count_trailing_zeros64(rest);
+          }
+          return find_from_word(w + 1);
+        }
+
+        // bitwise operations, both vectors must have the same size
+        StaticBitVector& operator&=(const StaticBitVector& rhs){
+          BOOST_ASSERT(size() == rhs.size());
+          for(std::size_t w = 0; w < used_words(); ++w){
+            m_words[w] &= rhs.m_words[w];
+          }
+          return *this;
+        }
+        StaticBitVector& operator|=(const StaticBitVector& rhs){
+          BOOST_ASSERT(size() == rhs.size());
+          for(std::size_t w = 0; w < used_words(); ++w){
+            m_words[w] |= rhs.m_words[w];
+          }
+          return *this;
+        }
+        StaticBitVector& operator^=(const StaticBitVector& rhs){
+          BOOST_ASSERT(size() == rhs.size());
+          for(std::size_t w = 0; w < used_words(); ++w){
+            m_words[w] ^= rhs.m_words[w];
+          }
+          return *this;
+        }
+        StaticBitVector operator~() const {
+          StaticBitVector result(*this);
+          return result.flip();
+        }
+
+        // capacity is constant, size varies
+        max_size_type size() const { return m_size; }
+        static max_size_type capacity() { return N; }
+        static max_size_type max_size() { return N; }
+        bool empty() const { return size() == 0; }
+        bool full() const { return size() >= capacity(); }
+
+        // the words holding [0, size()), bits past size() are zero
+        const word_type* words() const { return m_words; }
+        std::size_t used_words() const { return words_for(m_size); }
+
+        void swap(StaticBitVector& y){
+          std::size_t n = (std::max)(used_words(), y.used_words());
+          std::swap_ranges(m_words, m_words + n, y.m_words);
+          std::swap(m_size, y.m_size);
+        }
+
+        bool equals(const StaticBitVector& rhs) const {
+          return size() == rhs.size() && std::equal(m_words, m_words + used_words(), rhs.m_words);
+        }
+
+        // lexicographical comparison with false < true, decided at the lowest differing bit
+        bool less(const StaticBitVector& rhs) const {
+          std::size_t common = (std::min)(size(), rhs.size());
+          std::size_t words = words_for(common);
+          for(std::size_t w = 0; w < words; ++w){
+            word_type diff = m_words[w] ^ rhs.m_words[w];
+            if(w + 1 == words && common % bits_per_word){
+              diff &= low_bits(common);
+            }
+            if(diff){
+              return (rhs.m_words[w] & (diff & (~diff + 1))) != 0;
+            }
+          }
+          return size() < rhs.size();
+        }
+
+        // check range, fails through the error policy, which throws by default
+        // returns: 0 on success, 1 otherwise when the policy does not throw
+        bool rangecheck(max_size_type i) const {
+          bool failure(i >= size());
+          if(failure){
+            ErrorPolicy::out_of_range(i,size());
+          }
+          return failure;
+        }
+
+      private:
+        // returns: 0 on success, 1 when the error policy did not throw and the operation is to be dropped
+        static bool capacitycheck(std::size_t i){
+          bool failure(capacity_exceeded(i));
+          if(failure){
+            ErrorPolicy::overflow(i,N);
+          }
+          return failure;
+        }
+
+        // the check itself, without the error policy, growth is recorded by grown() as in StaticVector
+        static bool capacity_exceeded(std::size_t i){
+          if(i > N){
+            StatsPolicy::overflow(i,N);
+            return true;
+          }
+          return false;
+        }
+
+        void grown() const {
+          StatsPolicy::grow(size(),N);
+        }
+
+        static word_type bit(std::size_t i) { return word_type(1) << (i % bits_per_word); }
+        // the bits below i % bits_per_word
+        static word_type low_bits(std::size_t i) { return bit(i) - 1; }
+        static std::size_t words_for(std::size_t bits) { return (bits + bits_per_word - 1) / bits_per_word; }
+
+        // zero the bits of the last used word that lie past size()
+        void clear_tail(){
+          if(m_size % bits_per_word){
+            m_words[m_size / bits_per_word] &= low_bits(m_size);
+          }
+        }
+
+        // the caller guarantees that n <= capacity()
+        void unchecked_resize(max_size_type n, bool value = false){
+          BOOST_ASSERT( n <= N && "StaticBitVector<>: unchecked_resize past the capacity" );
+          bool grows = n > size();
+          if(grows){
+            std::size_t old_words = used_words();
+            std::size_t new_words = words_for(n);
+            word_type fill = value ? ~word_type(0) : word_type(0);
+            if(value && m_size % bits_per_word){
+              m_words[old_words-1] |= ~low_bits(m_size);
+            }
+            std::fill(m_words + old_words, m_words + new_words, fill);
+          }
+          m_size = n;
+          clear_tail();
+          if(grows){
+            grown();
+          }
+        }
+
+        template<typename Integer>
+        void construct(Integer n, Integer value, boost::true_type){
+          if(capacitycheck(static_cast<std::size_t>(n))){
+            return;
+          }
+          unchecked_resize(static_cast<size_type>(n), value != 0);
+        }
+
+        template<typename InputIterator>
+        void construct(InputIterator first, InputIterator last, boost::false_type){
+          for(; first != last; ++first){
+            push_back(static_cast<bool>(*first));
+          }
+        }
+
+        std::size_t find_from_word(std::size_t w) const {
+          for(; w < used_words(); ++w){
+            if(m_words[w]){
+              return w * bits_per_word + detail::count_trailing_zeros64(m_words[w]);
+            }
+          }
+          return npos;
+        }
+    };
+
+    template<std::size_t N, typename S, class P, class E>
+    const std::size_t StaticBitVector<N,S,P,E>::npos;
+
+    // comparisons
+    template<std::size_t N, typename S, class P, class E>
+    bool operator== (const StaticBitVector<N,S,P,E>& x, const StaticBitVector<N,S,P,E>& y) { return x.equals(y); }
+    template<std::size_t N, typename S, class P, class E>
+    bool operator!= (const StaticBitVector<N,S,P,E>& x, const StaticBitVector<N,S,P,E>& y) { return !x.equals(y); }
+    template<std::size_t N, typename S, class P, class E>
+    bool operator< (const StaticBitVector<N,S,P,E>& x, const StaticBitVector<N,S,P,E>& y) { return x.less(y); }
+    template<std::size_t N, typename S, class P, class E>
+    bool operator> (const StaticBitVector<N,S,P,E>& x, const StaticBitVector<N,S,P,E>& y) { return y.less(x); }
+    template<std::size_t N, typename S, class P, class E>
+    bool operator<= (const StaticBitVector<N,S,P,E>& x, const StaticBitVector<N,S,P,E>& y) { return !y.less(x); }
+    template<std::size_t N, typename S, class P, class E>
+    bool operator>= (const StaticBitVector<N,S,P,E>& x, const StaticBitVector<N,S,P,E>& y) { return !x.less(y); }
+
+    // bitwise operations, both vectors must have the same size
+    template<std::size_t N, typename S, class P, class E>
+    StaticBitVector<N,S,P,E> operator& (const StaticBitVector<N,S,P,E>& x, const StaticBitVector<N,S,P,E>& y) {
+        StaticBitVector<N,S,P,E> result(x);
+        return result &= y;
+    }
+    template<std::size_t N, typename S, class P, class E>
+    StaticBitVector<N,S,P,E> operator| (const StaticBitVector<N,S,P,E>& x, const StaticBitVector<N,S,P,E>& y) {
+        StaticBitVector<N,S,P,E> result(x);
+        return result |= y;
+    }
+    template<std::size_t N, typename S, class P, class E>
+    StaticBitVector<N,S,P,E> operator^ (const StaticBitVector<N,S,P,E>& x, const StaticBitVector<N,S,P,E>& y) {
+        StaticBitVector<N,S,P,E> result(x);
+        return result ^= y;
+    }
+
+    template<std::size_t N, typename S, class P, class E>
+    std::size_t count (const StaticBitVector<N,S,P,E>& x, bool value) {
+        return value ? x.count() : x.size() - x.count();
+    }
+    template<std::size_t N, typename S, class P, class E>
+    bool contains (const StaticBitVector<N,S,P,E>& x, bool value) {
+        return value ? x.any() : !x.all();
+    }
+
+    template<std::size_t N, typename S, class P, class E>
+    inline void swap (StaticBitVector<N,S,P,E>& x, StaticBitVector<N,S,P,E>& y) {
+        x.swap(y);
+    }
+
+} // namespace boost
+
+#endif /* BOOST_STATIC_BIT_VECTOR_HPP */
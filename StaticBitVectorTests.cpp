@@ -0,0 +1,218 @@
+/**
+ *  @file   StaticBitVectorTests.cpp
+ *  @brief  StaticBitVectorTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticBitVector is not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <StaticBitVector.hpp>
+#include <StaticFlatMap.hpp>
+#include <StaticHeap.hpp>
+#include <StaticSlotMap.hpp>
+#include <StaticVectorSerialization.hpp>
+#include <StaticVectorSaturate.hpp>
+#include <StaticVectorStats.hpp>
+#include <StaticVectorView.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+using namespace boost;
+
+namespace {
+  struct BitStats { static const char* name() { return "test bits"; } };
+  typedef StaticBitVector<200> Flags;
+
+  std::size_t FindFirst(const std::vector<bool>& v, std::size_t from){
+    for(std::size_t i = from; i < v.size(); ++i){
+      if(v[i]){
+        return i;
+      }
+    }
+    return Flags::npos;
+  }
+
+  void CheckMatches(const Flags& flags, const std::vector<bool>& expected){
+    BOOST_REQUIRE_EQUAL(flags.size(),expected.size());
+    BOOST_CHECK(std::equal(flags.begin(),flags.end(),expected.begin()));
+    std::size_t set = std::count(expected.begin(),expected.end(),true);
+    BOOST_CHECK_EQUAL(flags.count(),set);
+    BOOST_CHECK_EQUAL(flags.all(),set == expected.size());
+    BOOST_CHECK_EQUAL(flags.any(),set != 0);
+    BOOST_CHECK_EQUAL(flags.none(),set == 0);
+    BOOST_CHECK_EQUAL(flags.find_first(),FindFirst(expected,0));
+    for(std::size_t i = 0; i < expected.size(); ++i){
+      BOOST_CHECK_EQUAL(flags.find_next(i),FindFirst(expected,i+1));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(BitPacking){
+  BOOST_CHECK(sizeof(StaticBitVector<4096>) <= 4096/8 + sizeof(boost::uint64_t));
+  StaticBitVector<0> none;
+  BOOST_CHECK(none.empty());
+  BOOST_CHECK_THROW(none.push_back(true),std::out_of_range);
+  StaticBitVector<8> bits(3,1);
+  BOOST_CHECK_EQUAL(bits.count(),3u);
+}
+
+BOOST_AUTO_TEST_CASE(BitPolicies){
+  struct Drops {};
+  typedef static_vector_saturate_on_error<Drops> Saturate;
+  Saturate::reset();
+  StaticBitVector<70,uint_value_t<70>::least,static_vector_no_stats,Saturate> saturating(64,1);
+  saturating.resize(71,true);
+  for(int i = 0; i < 8; ++i){
+    saturating.push_back(true);
+  }
+  BOOST_CHECK(saturating.full());
+  BOOST_CHECK(saturating.all());
+  BOOST_CHECK_EQUAL(Saturate::dropped(),3u);
+
+  typedef StaticBitVector<2,uint_value_t<2>::least,static_vector_stats<BitStats> > Counted;
+  static_vector_counters& c = static_vector_stats<BitStats>::counters();
+  c.reset();
+  Counted bits;
+  BOOST_CHECK(bits.try_push_back(true));
+  BOOST_CHECK(bits.try_emplace_back(0));
+  BOOST_CHECK(!bits.try_push_back(true));
+  BOOST_CHECK_EQUAL(bits.count(),1u);
+  BOOST_CHECK_EQUAL(c.overflows(),1u);
+  BOOST_CHECK_THROW(bits.push_back(false),std::out_of_range);
+  BOOST_CHECK_THROW(bits.at(2),std::out_of_range);
+
+  // a count and value construction is checked and recorded once
+  c.reset();
+  Counted pair(2,1);
+  BOOST_CHECK_EQUAL(pair.count(),2u);
+  BOOST_CHECK_EQUAL(c.high_water(),2u);
+  BOOST_CHECK_EQUAL(c.near_capacity(),1u);
+  pair.reserve(2);
+  pair.resize(1);
+  BOOST_CHECK_EQUAL(c.near_capacity(),1u);
+}
+
+BOOST_AUTO_TEST_CASE(BitOperationsMatchVectorBool){
+  Flags flags;
+  std::vector<bool> expected;
+  std::srand(7);
+  for(int step = 0; step < 2000; ++step){
+    int op = std::rand() % 8;
+    if(op < 4 && !flags.full()){
+      bool x = std::rand() % 3 == 0;
+      flags.push_back(x);
+      expected.push_back(x);
+    } else if(op == 4 && !flags.empty()){
+      flags.pop_back();
+      expected.pop_back();
+    } else if(op == 5){
+      std::size_t n = std::rand() % 201;
+      bool x = std::rand() % 2 == 0;
+      flags.resize(n,x);
+      expected.resize(n,x);
+    } else if(op == 6 && !flags.empty()){
+      std::size_t i = std::rand() % flags.size();
+      flags[i] = !flags[i];
+      expected[i] = !expected[i];
+    } else if(op == 7){
+      flags.flip();
+      expected.flip();
+    }
+    CheckMatches(flags,expected);
+  }
+  BOOST_CHECK_THROW(flags.resize(201),std::out_of_range);
+  BOOST_CHECK_THROW(flags.at(flags.size()),std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(BitwiseOperators){
+  Flags a(130,false);
+  Flags b(130,false);
+  a.set(0).set(64).set(129);
+  b.set(64).set(100);
+  Flags both = a & b;
+  BOOST_CHECK_EQUAL(both.count(),1u);
+  BOOST_CHECK_EQUAL(both.find_first(),64u);
+  BOOST_CHECK_EQUAL((a | b).count(),4u);
+  BOOST_CHECK_EQUAL((a ^ b).count(),3u);
+  Flags inverse = ~a;
+  BOOST_CHECK_EQUAL(inverse.count(),127u);
+  BOOST_CHECK(!inverse[0] && inverse[1] && !inverse.test(129));
+
+  BOOST_CHECK(a != b);
+  BOOST_CHECK(b < a);            // first difference at bit 0
+  a.reset(0);
+  BOOST_CHECK(a < b);            // next difference at bit 100
+  a.reset();
+  BOOST_CHECK(a.none());
+  BOOST_CHECK_EQUAL(count(b,true),2u);
+  BOOST_CHECK_EQUAL(count(b,false),128u);
+  BOOST_CHECK(contains(b,false));
+
+  Flags prefix(b.begin(),b.begin()+70);
+  BOOST_CHECK_EQUAL(prefix.size(),70u);
+  BOOST_CHECK(prefix < b);
+  swap(prefix,b);
+  BOOST_CHECK_EQUAL(b.size(),70u);
+  BOOST_CHECK_EQUAL(prefix.find_next(64),100u);
+}
+
+// bit packing is opt-in, StaticVector<bool, N> and the containers built on it keep the full interface
+BOOST_AUTO_TEST_CASE(BoolElementsUseTheMainTemplate){
+  StaticVector<bool,8> flags;
+  flags.push_back(true);
+  flags.emplace_back(false);
+  flags.insert(flags.begin(),false);
+  flags.emplace(flags.begin()+1,true);
+  flags.unchecked_push_back(true);
+  BOOST_CHECK_EQUAL(flags.size(),5u);
+  BOOST_CHECK(*flags.data() == false);
+  BOOST_CHECK(*flags.rbegin() == true);
+  flags.erase(flags.begin());
+  BOOST_CHECK_EQUAL(erase_if(flags,[](bool b){ return !b; }),1u);
+  BOOST_CHECK_EQUAL(count(flags,true),3u);
+  BOOST_CHECK_EQUAL(erase(flags,true),3u);
+  BOOST_CHECK(flags.empty());
+
+  StaticFlatMap<int,bool,8> map;
+  map.emplace(2,true);
+  map[1] = false;
+  BOOST_CHECK_EQUAL(map.erase(1),1u);
+  BOOST_CHECK(map.at(2));
+  StaticFlatSet<bool,8> set;
+  set.insert(true);
+  set.insert(false);
+  BOOST_CHECK(*set.rbegin());
+
+  StaticSlotMap<bool,8> slots;
+  StaticSlotMap<bool,8>::handle h = slots.insert(true);
+  BOOST_CHECK(slots[h] && *slots.rbegin());
+
+  StaticHeap<bool,8> heap;
+  heap.push(false);
+  heap.push(true);
+  BOOST_CHECK(heap.top());
+
+  StaticVector<bool,8> stored(3,true);
+  StaticVectorView<bool,8> view(&stored,sizeof(stored));
+  BOOST_CHECK_EQUAL(view.size(),3u);
+
+  std::stringstream stream;
+  {
+    archive::text_oarchive out(stream);
+    out << stored;
+  }
+  StaticVector<bool,8> loaded;
+  archive::text_iarchive in(stream);
+  in >> loaded;
+  BOOST_CHECK(loaded == stored);
+}
@@ -0,0 +1,315 @@
+/**
+ * @file   StaticConcurrent.hpp
+ * @brief  Fixed capacity containers that many threads may push to concurrently.
+ *
+ * StaticMPMCQueue<T, N> is a bounded multi-producer multi-consumer FIFO
+ * queue after Dmitry Vyukov's design. Every one of the N slots holds a
+ * sequence number next to its aligned_storage element. A producer claims
+ * position p with a compare-and-swap on the enqueue counter once slot p % N
+ * reports sequence p, constructs the element and publishes it by storing
+ * p+1; a consumer waits for p+1, moves the element out and stores p+N to
+ * hand the slot to the producer of the next lap. try_push and try_pop never
+ * block and fail only when the queue is full or empty. Elements are moved
+ * into and out of their slot after the position is claimed, so T's move
+ * constructor and move assignment must not throw, which is checked at
+ * compile time.
+ *
+ * StaticAppendLog<T, N> is an append-only StaticVector: try_push_back claims
+ * the next index with one atomic fetch-add, constructs the element in place
+ * and marks the slot published. Elements are never moved or removed while
+ * threads are appending, so references stay valid. Since iteration covers
+ * every claimed index, T must be nothrow constructible from the arguments
+ * passed to try_push_back and try_emplace_back.
+ *
+ * Positions and sequence numbers are std::size_t rather than the
+ * uint_value_t<N> type used by the single threaded containers, since they
+ * must not wrap while a thread holds a stale copy.
+ *
+ *  StaticMPMCQueue and StaticAppendLog are not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_CONCURRENT_HPP
+#define BOOST_STATIC_CONCURRENT_HPP
+
+#include "StaticRing.hpp"
+#include <boost/atomic.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/noncopyable.hpp>
+#include <type_traits>
+
+namespace boost {
+
+    template<class T, std::size_t N>
+    class StaticMPMCQueue : private boost::noncopyable {
+        BOOST_STATIC_ASSERT(N > 0);
+      public:
+        // type definitions
+        typedef T                                              value_type;
+        typedef T&                                             reference;
+        typedef const T&                                       const_reference;
+        typedef std::size_t                                    size_type;
+
+        enum { static_size = N };
+
+      private:
+        typedef typename boost::aligned_storage<
+                           sizeof(T),
+                           boost::alignment_of<T>::value
+                         >::type aligned_storage;
+
+        struct cell {
+            boost::atomic<std::size_t> sequence;
+            aligned_storage            elem;
+        };
+
+        struct BOOST_ALIGNMENT(BOOST_STATIC_RING_CACHE_LINE_SIZE) position {
+            position():value(0){}
+            boost::atomic<std::size_t> value;
+        };
+
+        position m_enqueue;      // next position a producer claims
+        position m_dequeue;      // next position a consumer claims
+        cell     m_cells[N];     // N memory aligned elements of type T with their sequence numbers
+
+      public:
+
+        StaticMPMCQueue(){
+          for(std::size_t i = 0; i < N; ++i){
+            m_cells[i].sequence.store(i, boost::memory_order_relaxed);
+          }
+        }
+
+        // not thread-safe, no other thread may use the queue any more
+        ~StaticMPMCQueue(){
+          std::size_t last = m_enqueue.value.load(boost::memory_order_acquire);
+          for(std::size_t pos = m_dequeue.value.load(boost::memory_order_acquire); pos != last; ++pos){
+            reinterpret_cast<T*>(&m_cells[pos % N].elem)->~T();
+          }
+        }
+
+        // append x, false if the queue is full
+        bool try_push(BOOST_RV_REF(T) x){
+          // a throw after the position is claimed would leave a slot that is never published
+          BOOST_STATIC_ASSERT_MSG((std::is_nothrow_move_constructible<T>::value),
+                                  "StaticMPMCQueue<>: the move constructor of T must not throw");
+          std::size_t pos;
+          cell* c = claim_push(pos);
+          if(!c){
+            return false;
+          }
+          new (&c->elem) T(boost::move(x));
+          c->sequence.store(pos + 1, boost::memory_order_release);
+          return true;
+        }
+
+        // the element is built before a position is claimed, so a throwing
+        // constructor cannot leave a claimed slot that consumers wait on forever
+        bool try_push(const T& x){
+          T tmp(x);
+          return try_push(boost::move(tmp));
+        }
+
+        template<class... Args>
+        bool try_emplace(Args&&... args){
+          T tmp(boost::forward<Args>(args)...);
+          return try_push(boost::move(tmp));
+        }
+
+        // move the oldest element into x and remove it, false if the queue is empty
+        bool try_pop(T& x){
+          // a throw after the position is claimed would never hand the slot back to the producers
+          BOOST_STATIC_ASSERT_MSG((std::is_nothrow_move_assignable<T>::value),
+                                  "StaticMPMCQueue<>: the move assignment of T must not throw");
+          std::size_t pos = m_dequeue.value.load(boost::memory_order_relaxed);
+          cell* c;
+          for(;;){
+            c = &m_cells[pos % N];
+            std::size_t seq = c->sequence.load(boost::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if(diff == 0){
+              if(m_dequeue.value.compare_exchange_weak(pos, pos + 1, boost::memory_order_relaxed)){
+                break;
+              }
+            } else if(diff < 0){
+              return false;
+            } else {
+              pos = m_dequeue.value.load(boost::memory_order_relaxed);
+            }
+          }
+          T* p = reinterpret_cast<T*>(&c->elem);
+          x = boost::move(*p);
+          p->~T();
+          c->sequence.store(pos + N, boost::memory_order_release);
+          return true;
+        }
+
+        // approximate while other threads push or pop
+        std::size_t size() const {
+          std::size_t enqueued = m_enqueue.value.load(boost::memory_order_acquire);
+          std::size_t dequeued = m_dequeue.value.load(boost::memory_order_acquire);
+          return enqueued > dequeued ? (std::min)(enqueued - dequeued, N) : 0;
+        }
+        bool empty() const { return size() == 0; }
+
+        static std::size_t capacity() { return N; }
+        static std::size_t max_size() { return N; }
+
+      private:
+
+        // claim the next push position, 0 if the slot there still holds the element of the previous lap
+        cell* claim_push(std::size_t& pos){
+          pos = m_enqueue.value.load(boost::memory_order_relaxed);
+          for(;;){
+            cell* c = &m_cells[pos % N];
+            std::size_t seq = c->sequence.load(boost::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if(diff == 0){
+              if(m_enqueue.value.compare_exchange_weak(pos, pos + 1, boost::memory_order_relaxed)){
+                return c;
+              }
+            } else if(diff < 0){
+              return 0;
+            } else {
+              pos = m_enqueue.value.load(boost::memory_order_relaxed);
+            }
+          }
+        }
+    };
+
+    template<class T, std::size_t N>
+    class StaticAppendLog : private boost::noncopyable {
+        BOOST_STATIC_ASSERT(N > 0);
+      public:
+        // type definitions
+        typedef T                                              value_type;
+        typedef T*                                             pointer;
+        typedef const T*                                       const_pointer;
+        typedef T*                                             iterator;
+        typedef const T*                                       const_iterator;
+        typedef T&                                             reference;
+        typedef const T&                                       const_reference;
+        typedef std::size_t                                    size_type;
+
+        enum { static_size = N };
+
+      private:
+        typedef typename boost::aligned_storage<
+                           sizeof(T),
+                           boost::alignment_of<T>::value
+                         >::type aligned_storage;
+
+        struct BOOST_ALIGNMENT(BOOST_STATIC_RING_CACHE_LINE_SIZE) position {
+            position():value(0){}
+            boost::atomic<std::size_t> value;
+        };
+
+        position m_claimed;                      // number of indices handed out, may exceed N
+        boost::atomic<bool> m_published[N];      // set once the element at the same index is constructed
+        aligned_storage elems[N];                // N memory aligned elements of type T
+
+      public:
+
+        StaticAppendLog(){
+          for(std::size_t i = 0; i < N; ++i){
+            m_published[i].store(false, boost::memory_order_relaxed);
+          }
+        }
+
+        ~StaticAppendLog(){
+          clear();
+        }
+
+        // append a copy of x from any thread, false if the log is full
+        bool try_push_back(const T& x){
+          return try_emplace_back(x) != 0;
+        }
+
+        bool try_push_back(BOOST_RV_REF(T) x){
+          return push_claimed(boost::move(x)) != 0;
+        }
+
+        // construct an element from args from any thread, returns it or 0 if the log is full;
+        // the element is built before an index is claimed, so a throwing constructor
+        // cannot leave an unconstructed slot inside [0, size())
+        template<class... Args>
+        T* try_emplace_back(Args&&... args){
+          if(m_claimed.value.load(boost::memory_order_relaxed) >= N){
+            return 0;
+          }
+          T tmp(boost::forward<Args>(args)...);
+          return push_claimed(boost::move(tmp));
+        }
+
+        // number of claimed indices; elements below it may still be under construction
+        std::size_t size() const {
+          return (std::min)(m_claimed.value.load(boost::memory_order_acquire), N);
+        }
+        bool empty() const { return size() == 0; }
+        bool full() const { return size() == N; }
+
+        static std::size_t capacity() { return N; }
+        static std::size_t max_size() { return N; }
+
+        // true once the element at index i may be read by this thread
+        bool published(std::size_t i) const {
+          return i < N && m_published[i].load(boost::memory_order_acquire);
+        }
+
+        // element access, i must be published, or all appending threads joined
+        reference operator[](std::size_t i) {
+          BOOST_ASSERT( i < size() && "out of range" );
+          return *to_object(i);
+        }
+        const_reference operator[](std::size_t i) const {
+          BOOST_ASSERT( i < size() && "out of range" );
+          return *to_object(i);
+        }
+
+        // iteration over [0, size()), only once all appending threads have finished
+        iterator        begin()       { return to_object(0); }
+        const_iterator  begin() const { return to_object(0); }
+        iterator        end()       { return to_object(size()); }
+        const_iterator  end() const { return to_object(size()); }
+
+        // not thread-safe, no other thread may append concurrently
+        void clear(){
+          std::size_t n = size();
+          for(std::size_t i = 0; i < n; ++i){
+            if(m_published[i].load(boost::memory_order_relaxed)){
+              to_object(i)->~T();
+              m_published[i].store(false, boost::memory_order_relaxed);
+            }
+          }
+          m_claimed.value.store(0, boost::memory_order_release);
+        }
+
+      private:
+        // claim the next index and move x into it, 0 if the log is full
+        T* push_claimed(BOOST_RV_REF(T) x){
+          // a throw after the index is claimed would leave an unconstructed slot inside [0, size())
+          BOOST_STATIC_ASSERT_MSG((std::is_nothrow_move_constructible<T>::value),
+                                  "StaticAppendLog<>: the move constructor of T must not throw");
+          // once full, fail without touching the shared counter so it cannot grow without bound
+          if(m_claimed.value.load(boost::memory_order_relaxed) >= N){
+            return 0;
+          }
+          std::size_t i = m_claimed.value.fetch_add(1, boost::memory_order_relaxed);
+          if(i >= N){
+            return 0;
+          }
+          T* p = new (&elems[i]) T(boost::move(x));
+          m_published[i].store(true, boost::memory_order_release);
+          return p;
+        }
+
+        T* to_object(std::size_t i) { return reinterpret_cast<T*>(elems) + i; }
+        const T* to_object(std::size_t i) const { return reinterpret_cast<const T*>(elems) + i; }
+    };
+
+} // namespace boost
+
+#endif /* BOOST_STATIC_CONCURRENT_HPP */
@@ -0,0 +1,158 @@
+/**
+ *  @file   StaticConcurrentTests.cpp
+ *  @brief  StaticConcurrentTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticMPMCQueue and StaticAppendLog are not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <boost/thread/thread.hpp>
+#include <StaticConcurrent.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+using namespace boost;
+
+#define QUEUE_SIZE 5
+
+BOOST_AUTO_TEST_CASE(MPMCQueueFifo){
+  StaticMPMCQueue<std::string,QUEUE_SIZE> queue;
+  std::string value;
+  BOOST_CHECK(!queue.try_pop(value));
+  std::size_t next = 0;
+  std::size_t expected = 0;
+  // several laps around the slots
+  for(int round = 0; round < 10; round++){
+    while(queue.try_emplace(next + 1,'x')){
+      next++;
+    }
+    BOOST_CHECK_EQUAL(queue.size(),QUEUE_SIZE);
+    for(int i = 0; i < 2; i++){
+      BOOST_REQUIRE(queue.try_pop(value));
+      BOOST_CHECK_EQUAL(value.size(),++expected);
+    }
+  }
+  BOOST_CHECK_EQUAL(queue.size(),QUEUE_SIZE-2);
+  BOOST_CHECK(queue.try_push(std::string("moved")));
+  BOOST_CHECK(queue.try_push(value));
+  BOOST_CHECK(!queue.try_push(value));
+  // the remaining strings are released by the destructor
+}
+
+namespace {
+  const std::size_t per_thread = 20000;
+
+  template<class Queue>
+  void produce(Queue* queue, std::size_t first){
+    for(std::size_t i = first; i < first + per_thread; i++){
+      while(!queue->try_push(i)){
+        boost::this_thread::yield();
+      }
+    }
+  }
+
+  template<class Queue>
+  void consume(Queue* queue, std::vector<std::size_t>* popped){
+    std::size_t value;
+    while(popped->size() < per_thread){
+      if(queue->try_pop(value)){
+        popped->push_back(value);
+      } else {
+        boost::this_thread::yield();
+      }
+    }
+  }
+
+  template<class Log>
+  void append(Log* log, std::size_t first, std::size_t* failures){
+    for(std::size_t i = first; i < first + per_thread; i++){
+      if(!log->try_push_back(i)){
+        ++*failures;
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MPMCQueueThreads){
+  typedef StaticMPMCQueue<std::size_t,64> Queue;
+  const std::size_t threads = 4;
+  Queue queue;
+  std::vector<std::vector<std::size_t> > popped(threads);
+  boost::thread_group group;
+  for(std::size_t t = 0; t < threads; t++){
+    group.create_thread(boost::bind(&produce<Queue>,&queue,t*per_thread));
+    group.create_thread(boost::bind(&consume<Queue>,&queue,&popped[t]));
+  }
+  group.join_all();
+  BOOST_CHECK(queue.empty());
+  
+  // every value arrives exactly once, and each producer's values arrive in order at any one consumer
+  std::vector<std::size_t> all;
+  bool ordered = true;
+  for(std::size_t t = 0; t < threads; t++){
+    std::vector<std::size_t> last(threads,0);
+    for(std::size_t i = 0; i < popped[t].size(); i++){
+      std::size_t producer = popped[t][i] / per_thread;
+      ordered = ordered && (last[producer] == 0 || popped[t][i] > last[producer]);
+      last[producer] = popped[t][i];
+    }
+    all.insert(all.end(),popped[t].begin(),popped[t].end());
+  }
+  BOOST_CHECK(ordered);
+  std::sort(all.begin(),all.end());
+  BOOST_REQUIRE_EQUAL(all.size(),threads*per_thread);
+  for(std::size_t i = 0; i < all.size(); i++){
+    BOOST_REQUIRE_EQUAL(all[i],i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AppendLogThreads){
+  typedef StaticAppendLog<std::size_t,50000> Log;
+  const std::size_t threads = 4;
+  Log log;
+  std::vector<std::size_t> failures(threads,0);
+  boost::thread_group group;
+  for(std::size_t t = 0; t < threads; t++){
+    group.create_thread(boost::bind(&append<Log>,&log,t*per_thread,&failures[t]));
+  }
+  group.join_all();
+  BOOST_CHECK(log.full());
+  BOOST_CHECK_EQUAL(log.size(),log.capacity());
+  std::size_t failed = 0;
+  for(std::size_t t = 0; t < threads; t++){
+    failed += failures[t];
+  }
+  BOOST_CHECK_EQUAL(failed,threads*per_thread - log.capacity());
+  
+  std::vector<std::size_t> all(log.begin(),log.end());
+  std::sort(all.begin(),all.end());
+  BOOST_CHECK(std::adjacent_find(all.begin(),all.end()) == all.end());
+  BOOST_CHECK(log.published(log.size()-1));
+  BOOST_CHECK(!log.published(log.capacity()));
+  
+  log.clear();
+  BOOST_CHECK(log.empty());
+  BOOST_CHECK(log.try_push_back(7));
+  BOOST_CHECK_EQUAL(log[0],7u);
+}
+
+BOOST_AUTO_TEST_CASE(AppendLogStrings){
+  StaticAppendLog<std::string,3> log;
+  const std::string first(40,'a');
+  BOOST_CHECK(log.try_push_back(first));
+  BOOST_CHECK(log.try_push_back(std::string("second")));
+  std::string* third = log.try_emplace_back(3,'c');
+  BOOST_REQUIRE(third != 0);
+  BOOST_CHECK_EQUAL(*third,"ccc");
+  BOOST_CHECK(!log.try_push_back(first));
+  BOOST_CHECK(log.try_emplace_back("fourth") == 0);
+  BOOST_CHECK_EQUAL(log.size(),3u);
+  BOOST_CHECK_EQUAL(log[0],first);
+  BOOST_CHECK_EQUAL(log[1],"second");
+}
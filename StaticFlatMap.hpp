@@ -0,0 +1,708 @@
+/**
+ * @file   StaticFlatMap.hpp
+ * @brief  Sorted associative containers with fixed capacity, stored in StaticVector.
+ *
+ * StaticFlatSet<Key,N,Compare> keeps its keys sorted in a StaticVector<Key,N>.
+ * StaticFlatMap<Key,Value,N,Compare> keeps the sorted keys and the values in two
+ * parallel StaticVectors, so a lookup only walks the key array.
+ *
+ * Lookups over at most BOOST_STATIC_FLAT_LINEAR_SEARCH_LIMIT keys count the keys
+ * that compare less than the probe without branching, which the compiler can
+ * vectorize. Larger containers use binary search. Inserting a single element
+ * shifts the tail with StaticVector::insert, a single memmove for relocatable
+ * types. Inserting a range appends it, sorts the new part and merges it with the
+ * existing elements, in place with rotations so that nothing is allocated.
+ * Keys already present are kept, matching std::set and std::map.
+ *
+ * Iterators, references and pointers are invalidated by every insert and erase.
+ *
+ *  StaticFlatSet and StaticFlatMap are not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_FLAT_MAP_HPP
+#define BOOST_STATIC_FLAT_MAP_HPP
+
+#include "StaticVector.hpp"
+#include <boost/core/empty_value.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+// largest capacity searched with the branchless linear scan instead of binary search
+#ifndef BOOST_STATIC_FLAT_LINEAR_SEARCH_LIMIT
+#define BOOST_STATIC_FLAT_LINEAR_SEARCH_LIMIT 32
+#endif
+
+namespace boost {
+
+  namespace detail {
+        // position of the first element of the sorted range [first,last) that is not less than key
+        template<std::size_t N, typename Key, typename Compare>
+        inline std::size_t flat_lower_bound(const Key* first, const Key* last, const Key& key, const Compare& comp){
+            if(N <= BOOST_STATIC_FLAT_LINEAR_SEARCH_LIMIT){
+              // the range is sorted, so the number of smaller keys is the lower bound
+              std::size_t n = 0;
+              for(; first != last; ++first)
+                n += comp(*first,key) ? 1 : 0;
+              return n;
+            }
+            return std::lower_bound(first,last,key,comp) - first;
+        }
+
+        // position of the first element of the sorted range [first,last) that is greater than key
+        template<std::size_t N, typename Key, typename Compare>
+        inline std::size_t flat_upper_bound(const Key* first, const Key* last, const Key& key, const Compare& comp){
+            if(N <= BOOST_STATIC_FLAT_LINEAR_SEARCH_LIMIT){
+              std::size_t n = 0;
+              for(; first != last; ++first)
+                n += comp(key,*first) ? 0 : 1;
+              return n;
+            }
+            return std::upper_bound(first,last,key,comp) - first;
+        }
+
+        template<typename Iterator>
+        inline Iterator flat_rotate(Iterator first, Iterator middle, Iterator last){
+            return std::rotate(first,middle,last);
+        }
+
+        template<typename Key, typename Value>
+        class flat_entry_iterator;
+
+        // the entries of a map are only reachable through a proxy, so rotate them with swaps alone
+        template<typename Key, typename Value>
+        inline flat_entry_iterator<Key,Value> flat_rotate(flat_entry_iterator<Key,Value> first,
+                                                          flat_entry_iterator<Key,Value> middle,
+                                                          flat_entry_iterator<Key,Value> last){
+            std::reverse(first,middle);
+            std::reverse(middle,last);
+            std::reverse(first,last);
+            return first + (last - middle);
+        }
+
+        // stable sort of a short range by rotating each element into place
+        template<typename Iterator, typename Compare>
+        inline void flat_insertion_sort(Iterator first, Iterator last, const Compare& comp){
+            for(Iterator it = first; it != last; ++it){
+              flat_rotate(std::upper_bound(first,it,*it,comp),it,it+1);
+            }
+        }
+
+        // stable merge of the sorted ranges [first,middle) and [middle,last) without a buffer,
+        // splitting at the median of the longer range and rotating the parts into place
+        template<typename Iterator, typename Compare>
+        void flat_merge_without_buffer(Iterator first, Iterator middle, Iterator last, const Compare& comp){
+            std::ptrdiff_t len1 = middle - first;
+            std::ptrdiff_t len2 = last - middle;
+            if(len1 == 0 || len2 == 0){
+              return;
+            }
+            if(len1 + len2 == 2){
+              if(comp(*middle,*first)){
+                std::iter_swap(first,middle);
+              }
+              return;
+            }
+            Iterator cut1;
+            Iterator cut2;
+            if(len1 > len2){
+              cut1 = first + len1/2;
+              cut2 = std::lower_bound(middle,last,*cut1,comp);
+            } else {
+              cut2 = middle + len2/2;
+              cut1 = std::upper_bound(first,middle,*cut2,comp);
+            }
+            Iterator new_middle = flat_rotate(cut1,middle,cut2);
+            flat_merge_without_buffer(first,cut1,new_middle,comp);
+            flat_merge_without_buffer(new_middle,cut2,last,comp);
+        }
+
+        // stable sort that does not allocate, unlike std::stable_sort which asks for a temporary buffer
+        template<typename Iterator, typename Compare>
+        void flat_stable_sort(Iterator first, Iterator last, const Compare& comp){
+            if(last - first <= BOOST_STATIC_FLAT_LINEAR_SEARCH_LIMIT){
+              flat_insertion_sort(first,last,comp);
+              return;
+            }
+            Iterator middle = first + (last - first)/2;
+            flat_stable_sort(first,middle,comp);
+            flat_stable_sort(middle,last,comp);
+            flat_merge_without_buffer(first,middle,last,comp);
+        }
+
+        // one key and its value, swapping two entries swaps both
+        template<typename Key, typename Value>
+        struct flat_entry {
+            flat_entry(Key* key, Value* value):key(key),value(value){}
+            friend void swap(flat_entry lhs, flat_entry rhs){
+              using std::swap;
+              swap(*lhs.key,*rhs.key);
+              swap(*lhs.value,*rhs.value);
+            }
+            Key* key;
+            Value* value;
+        };
+
+        // orders entries by their keys
+        template<typename Key, typename Value, typename Compare>
+        struct flat_entry_compare {
+            explicit flat_entry_compare(const Compare& comp):comp(comp){}
+            bool operator()(const flat_entry<Key,Value>& lhs, const flat_entry<Key,Value>& rhs) const { return comp(*lhs.key,*rhs.key); }
+            const Compare& comp;
+        };
+
+        // walks the key and value arrays of a StaticFlatMap together, so that both are sorted
+        // and merged in place; only swaps through the flat_entry proxy move the elements
+        template<typename Key, typename Value>
+        class flat_entry_iterator {
+          public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef std::pair<Key,Value>            value_type;
+            typedef std::ptrdiff_t                  difference_type;
+            typedef flat_entry<Key,Value>           reference;
+            typedef void                            pointer;
+
+            flat_entry_iterator():m_key(0),m_value(0){}
+            flat_entry_iterator(Key* key, Value* value):m_key(key),m_value(value){}
+
+            reference operator*() const { return reference(m_key,m_value); }
+            reference operator[](difference_type n) const { return reference(m_key+n,m_value+n); }
+
+            flat_entry_iterator& operator++() { ++m_key; ++m_value; return *this; }
+            flat_entry_iterator& operator--() { --m_key; --m_value; return *this; }
+            flat_entry_iterator operator++(int) { flat_entry_iterator tmp(*this); ++*this; return tmp; }
+            flat_entry_iterator operator--(int) { flat_entry_iterator tmp(*this); --*this; return tmp; }
+            flat_entry_iterator& operator+=(difference_type n) { m_key += n; m_value += n; return *this; }
+            flat_entry_iterator& operator-=(difference_type n) { m_key -= n; m_value -= n; return *this; }
+            flat_entry_iterator operator+(difference_type n) const { return flat_entry_iterator(m_key+n,m_value+n); }
+            flat_entry_iterator operator-(difference_type n) const { return flat_entry_iterator(m_key-n,m_value-n); }
+            difference_type operator-(const flat_entry_iterator& rhs) const { return m_key - rhs.m_key; }
+
+            bool operator==(const flat_entry_iterator& rhs) const { return m_key == rhs.m_key; }
+            bool operator!=(const flat_entry_iterator& rhs) const { return m_key != rhs.m_key; }
+            bool operator<(const flat_entry_iterator& rhs) const { return m_key < rhs.m_key; }
+            bool operator>(const flat_entry_iterator& rhs) const { return m_key > rhs.m_key; }
+            bool operator<=(const flat_entry_iterator& rhs) const { return m_key <= rhs.m_key; }
+            bool operator>=(const flat_entry_iterator& rhs) const { return m_key >= rhs.m_key; }
+
+          private:
+            Key* m_key;
+            Value* m_value;
+        };
+  } // namespace detail
+
+    template<class Key, std::size_t N, class Compare = std::less<Key> >
+    class StaticFlatSet : private boost::empty_value<Compare> {
+        typedef boost::empty_value<Compare>                    compare_holder;
+      public:
+        // type definitions
+        typedef Key                                            key_type;
+        typedef Key                                            value_type;
+        typedef Compare                                        key_compare;
+        typedef Compare                                        value_compare;
+        typedef StaticVector<Key,N>                            container_type;
+        typedef typename container_type::size_type             size_type;
+        typedef typename container_type::difference_type       difference_type;
+        typedef const Key&                                     reference;
+        typedef const Key&                                     const_reference;
+        typedef const Key*                                     pointer;
+        typedef const Key*                                     const_pointer;
+        typedef typename container_type::const_iterator        iterator;
+        typedef typename container_type::const_iterator        const_iterator;
+        typedef typename container_type::const_reverse_iterator reverse_iterator;
+        typedef typename container_type::const_reverse_iterator const_reverse_iterator;
+
+        explicit StaticFlatSet(const Compare& comp = Compare()):
+          compare_holder(boost::empty_init_t(), comp)
+        {}
+
+        template<typename InputIterator>
+        StaticFlatSet(InputIterator first, InputIterator last, const Compare& comp = Compare()):
+          compare_holder(boost::empty_init_t(), comp)
+        {
+          insert(first,last);
+        }
+
+        // iterator support, the keys are always sorted and may not be modified in place
+        const_iterator begin() const { return m_keys.begin(); }
+        const_iterator cbegin() const { return m_keys.begin(); }
+        const_iterator end() const { return m_keys.end(); }
+        const_iterator cend() const { return m_keys.end(); }
+        const_reverse_iterator rbegin() const { return m_keys.rbegin(); }
+        const_reverse_iterator rend() const { return m_keys.rend(); }
+
+        // capacity is constant, size varies
+        size_type size() const { return m_keys.size(); }
+        bool empty() const { return m_keys.empty(); }
+        bool full() const { return m_keys.full(); }
+        static size_type capacity() { return N; }
+        static size_type max_size() { return N; }
+
+        std::pair<iterator,bool> insert(const value_type& x){
+          return insert_unique(x);
+        }
+
+        std::pair<iterator,bool> insert(value_type&& x){
+          return insert_unique(boost::move(x));
+        }
+
+        template<typename... Args>
+        std::pair<iterator,bool> emplace(Args&&... args){
+          value_type x(boost::forward<Args>(args)...);
+          return insert_unique(boost::move(x));
+        }
+
+        // append the range, sort it and merge it with the existing keys
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last){
+          size_type old_size = size();
+          BOOST_TRY {
+            for(; first != last && !m_keys.full(); ++first){
+              m_keys.push_back(*first);
+            }
+          } BOOST_CATCH(...) {
+            // the unsorted tail must not outlive a failed copy
+            m_keys.erase(m_keys.begin()+old_size,m_keys.end());
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+          if(first != last){
+            // the batch does not fit before removing duplicates, fall back to one key at a time
+            insert_one_by_one(old_size,first,last);
+            return;
+          }
+          merge_appended(old_size);
+        }
+
+        size_type erase(const key_type& key){
+          const_iterator pos = find(key);
+          if(pos == end()){
+            return 0;
+          }
+          erase(pos);
+          return 1;
+        }
+
+        iterator erase(const_iterator pos){
+          return m_keys.erase(mutable_iterator(pos));
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+          return m_keys.erase(mutable_iterator(first),mutable_iterator(last));
+        }
+
+        void clear(){
+          m_keys.clear();
+        }
+
+        void swap(StaticFlatSet& y){
+          m_keys.swap(y.m_keys);
+          std::swap(comp(),y.comp());
+        }
+
+        // lookup
+        const_iterator find(const key_type& key) const {
+          const_iterator pos = lower_bound(key);
+          return (pos != end() && !comp()(key,*pos)) ? pos : end();
+        }
+
+        size_type count(const key_type& key) const {
+          return find(key) != end() ? 1 : 0;
+        }
+
+        bool contains(const key_type& key) const {
+          return find(key) != end();
+        }
+
+        const_iterator lower_bound(const key_type& key) const {
+          return begin() + detail::flat_lower_bound<N>(begin(),end(),key,comp());
+        }
+
+        const_iterator upper_bound(const key_type& key) const {
+          return begin() + detail::flat_upper_bound<N>(begin(),end(),key,comp());
+        }
+
+        std::pair<const_iterator,const_iterator> equal_range(const key_type& key) const {
+          const_iterator first = lower_bound(key);
+          const_iterator last = (first != end() && !comp()(key,*first)) ? first+1 : first;
+          return std::make_pair(first,last);
+        }
+
+        key_compare key_comp() const { return comp(); }
+        value_compare value_comp() const { return comp(); }
+
+        // direct access to the sorted keys
+        const container_type& keys() const { return m_keys; }
+
+private:
+       const Compare& comp() const { return compare_holder::get(); }
+       Compare& comp() { return compare_holder::get(); }
+
+       typename container_type::iterator mutable_iterator(const_iterator pos){
+          return m_keys.begin() + (pos - m_keys.begin());
+       }
+
+       template<typename V>
+       std::pair<iterator,bool> insert_unique(V&& x){
+          iterator pos = lower_bound(x);
+          if(pos != end() && !comp()(x,*pos)){
+            return std::make_pair(pos,false);
+          }
+          return std::make_pair(iterator(m_keys.insert(mutable_iterator(pos),boost::forward<V>(x))),true);
+       }
+
+       template<typename InputIterator>
+       void insert_one_by_one(size_type old_size, InputIterator first, InputIterator last){
+          merge_appended(old_size);
+          for(; first != last; ++first){
+            insert(*first);
+          }
+       }
+
+       // sort keys [old_size,size()) into the sorted keys [0,old_size) and drop duplicates, keeping the first
+       void merge_appended(size_type old_size){
+          typename container_type::iterator middle = m_keys.begin()+old_size;
+          detail::flat_stable_sort(middle,m_keys.end(),comp());
+          detail::flat_merge_without_buffer(m_keys.begin(),middle,m_keys.end(),comp());
+          m_keys.erase(std::unique(m_keys.begin(),m_keys.end(),equivalent(comp())),m_keys.end());
+       }
+
+       struct equivalent {
+          explicit equivalent(const Compare& comp):comp(comp){}
+          bool operator()(const Key& lhs, const Key& rhs) const { return !comp(lhs,rhs) && !comp(rhs,lhs); }
+          const Compare& comp;
+       };
+
+       container_type m_keys;
+}; // class StaticFlatSet
+
+    template<class Key, std::size_t N, class Compare>
+    bool operator== (const StaticFlatSet<Key,N,Compare>& x, const StaticFlatSet<Key,N,Compare>& y) {
+        return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+    }
+    template<class Key, std::size_t N, class Compare>
+    bool operator!= (const StaticFlatSet<Key,N,Compare>& x, const StaticFlatSet<Key,N,Compare>& y) {
+        return !(x==y);
+    }
+    template<class Key, std::size_t N, class Compare>
+    bool operator< (const StaticFlatSet<Key,N,Compare>& x, const StaticFlatSet<Key,N,Compare>& y) {
+        return std::lexicographical_compare(x.begin(),x.end(),y.begin(),y.end());
+    }
+
+    template<class Key, std::size_t N, class Compare>
+    inline void swap (StaticFlatSet<Key,N,Compare>& x, StaticFlatSet<Key,N,Compare>& y) {
+        x.swap(y);
+    }
+
+  namespace detail {
+        // random access iterator over the parallel key and value arrays of a StaticFlatMap,
+        // dereferencing yields a std::pair of references
+        template<typename Key, typename Value>
+        class flat_map_iterator
+          : public boost::iterator_facade< flat_map_iterator<Key,Value>,
+                                           std::pair<const Key,Value>,
+                                           boost::random_access_traversal_tag,
+                                           std::pair<const Key&,Value&> >
+        {
+          public:
+            flat_map_iterator():m_key(0),m_value(0){}
+            flat_map_iterator(const Key* key, Value* value):m_key(key),m_value(value){}
+
+            // iterator to const_iterator conversion
+            template<typename OtherValue>
+            flat_map_iterator(const flat_map_iterator<Key,OtherValue>& rhs):m_key(rhs.key_ptr()),m_value(rhs.value_ptr()){}
+
+            const Key* key_ptr() const { return m_key; }
+            Value* value_ptr() const { return m_value; }
+
+          private:
+            friend class boost::iterator_core_access;
+
+            std::pair<const Key&,Value&> dereference() const { return std::pair<const Key&,Value&>(*m_key,*m_value); }
+            template<typename OtherValue>
+            bool equal(const flat_map_iterator<Key,OtherValue>& rhs) const { return m_key == rhs.key_ptr(); }
+            void increment() { ++m_key; ++m_value; }
+            void decrement() { --m_key; --m_value; }
+            void advance(std::ptrdiff_t n) { m_key += n; m_value += n; }
+            template<typename OtherValue>
+            std::ptrdiff_t distance_to(const flat_map_iterator<Key,OtherValue>& rhs) const { return rhs.key_ptr() - m_key; }
+
+            const Key* m_key;
+            Value* m_value;
+        };
+  } // namespace detail
+
+    template<class Key, class Value, std::size_t N, class Compare = std::less<Key> >
+    class StaticFlatMap : private boost::empty_value<Compare> {
+        typedef boost::empty_value<Compare>                    compare_holder;
+      public:
+        // type definitions
+        typedef Key                                            key_type;
+        typedef Value                                          mapped_type;
+        typedef std::pair<const Key,Value>                     value_type;
+        typedef Compare                                        key_compare;
+        typedef StaticVector<Key,N>                            key_container_type;
+        typedef StaticVector<Value,N>                          mapped_container_type;
+        typedef typename key_container_type::size_type         size_type;
+        typedef std::ptrdiff_t                                 difference_type;
+        typedef std::pair<const Key&,Value&>                   reference;
+        typedef std::pair<const Key&,const Value&>             const_reference;
+        typedef detail::flat_map_iterator<Key,Value>           iterator;
+        typedef detail::flat_map_iterator<Key,const Value>     const_iterator;
+        typedef std::reverse_iterator<iterator>                reverse_iterator;
+        typedef std::reverse_iterator<const_iterator>          const_reverse_iterator;
+
+        explicit StaticFlatMap(const Compare& comp = Compare()):
+          compare_holder(boost::empty_init_t(), comp)
+        {}
+
+        template<typename InputIterator>
+        StaticFlatMap(InputIterator first, InputIterator last, const Compare& comp = Compare()):
+          compare_holder(boost::empty_init_t(), comp)
+        {
+          insert(first,last);
+        }
+
+        // iterator support
+        iterator        begin()       { return iterator(m_keys.begin(),m_values.begin()); }
+        const_iterator  begin() const { return const_iterator(m_keys.begin(),m_values.begin()); }
+        const_iterator cbegin() const { return begin(); }
+        iterator        end()       { return iterator(m_keys.end(),m_values.end()); }
+        const_iterator  end() const { return const_iterator(m_keys.end(),m_values.end()); }
+        const_iterator cend() const { return end(); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+        // capacity is constant, size varies
+        size_type size() const { return m_keys.size(); }
+        bool empty() const { return m_keys.empty(); }
+        bool full() const { return m_keys.full(); }
+        static size_type capacity() { return N; }
+        static size_type max_size() { return N; }
+
+        // element access, operator[] value initializes missing entries
+        mapped_type& operator[](const key_type& key){
+          return try_emplace(key).first->second;
+        }
+
+        mapped_type& at(const key_type& key){
+          iterator pos = find(key);
+          if(pos == end()){
+            std::out_of_range e("StaticFlatMap<>: key not found");
+            BOOST_THROW_EXCEPTION(e);
+          }
+          return pos->second;
+        }
+
+        const mapped_type& at(const key_type& key) const {
+          size_type pos = find_index(key);
+          if(pos == size()){
+            std::out_of_range e("StaticFlatMap<>: key not found");
+            BOOST_THROW_EXCEPTION(e);
+          }
+          return m_values[pos];
+        }
+
+        std::pair<iterator,bool> insert(const std::pair<Key,Value>& x){
+          return try_emplace(x.first,x.second);
+        }
+
+        // inserts mapped_type(args...) under key unless the key is already present
+        template<typename... Args>
+        std::pair<iterator,bool> try_emplace(const key_type& key, Args&&... args){
+          size_type pos = lower_bound_index(key);
+          if(pos != size() && !comp()(key,m_keys[pos])){
+            return std::make_pair(begin()+pos,false);
+          }
+          capacitycheck(size()+1);
+          m_values.emplace(m_values.begin()+pos,boost::forward<Args>(args)...);
+          BOOST_TRY {
+            m_keys.insert(m_keys.begin()+pos,key);
+          } BOOST_CATCH(...) {
+            m_values.erase(m_values.begin()+pos);
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+          return std::make_pair(begin()+pos,true);
+        }
+
+        template<typename... Args>
+        std::pair<iterator,bool> emplace(const key_type& key, Args&&... args){
+          return try_emplace(key,boost::forward<Args>(args)...);
+        }
+
+        // insert or overwrite
+        template<typename M>
+        std::pair<iterator,bool> insert_or_assign(const key_type& key, M&& value){
+          std::pair<iterator,bool> result = try_emplace(key,boost::forward<M>(value));
+          if(!result.second){
+            result.first->second = boost::forward<M>(value);
+          }
+          return result;
+        }
+
+        // append the range, sort it and merge it with the existing entries
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last){
+          size_type old_size = size();
+          for(; first != last; ++first){
+            if(full()){
+              // the batch does not fit before removing duplicates, fall back to one entry at a time
+              merge_appended(old_size);
+              for(; first != last; ++first){
+                insert(*first);
+              }
+              return;
+            }
+            BOOST_TRY {
+              m_keys.push_back(first->first);
+              m_values.push_back(first->second);
+            } BOOST_CATCH(...) {
+              // the unsorted tail must not outlive a failed copy
+              m_keys.erase(m_keys.begin()+old_size,m_keys.end());
+              m_values.erase(m_values.begin()+old_size,m_values.end());
+              BOOST_RETHROW;
+            } BOOST_CATCH_END
+          }
+          merge_appended(old_size);
+        }
+
+        size_type erase(const key_type& key){
+          iterator pos = find(key);
+          if(pos == end()){
+            return 0;
+          }
+          erase(pos);
+          return 1;
+        }
+
+        iterator erase(const_iterator pos){
+          return erase(pos,pos+1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+          size_type f = first - cbegin();
+          size_type l = last - cbegin();
+          m_keys.erase(m_keys.begin()+f,m_keys.begin()+l);
+          m_values.erase(m_values.begin()+f,m_values.begin()+l);
+          return begin()+f;
+        }
+
+        void clear(){
+          m_keys.clear();
+          m_values.clear();
+        }
+
+        void swap(StaticFlatMap& y){
+          m_keys.swap(y.m_keys);
+          m_values.swap(y.m_values);
+          std::swap(comp(),y.comp());
+        }
+
+        // lookup
+        iterator find(const key_type& key){
+          return begin() + find_index(key);
+        }
+
+        const_iterator find(const key_type& key) const {
+          return begin() + find_index(key);
+        }
+
+        size_type count(const key_type& key) const {
+          return find_index(key) != size() ? 1 : 0;
+        }
+
+        bool contains(const key_type& key) const {
+          return find_index(key) != size();
+        }
+
+        iterator lower_bound(const key_type& key) { return begin() + lower_bound_index(key); }
+        const_iterator lower_bound(const key_type& key) const { return begin() + lower_bound_index(key); }
+
+        iterator upper_bound(const key_type& key) {
+          return begin() + detail::flat_upper_bound<N>(m_keys.begin(),m_keys.end(),key,comp());
+        }
+        const_iterator upper_bound(const key_type& key) const {
+          return begin() + detail::flat_upper_bound<N>(m_keys.begin(),m_keys.end(),key,comp());
+        }
+
+        key_compare key_comp() const { return comp(); }
+
+        // direct access to the sorted keys and the values in key order
+        const key_container_type& keys() const { return m_keys; }
+        const mapped_container_type& values() const { return m_values; }
+        mapped_container_type& values() { return m_values; }
+
+private:
+       const Compare& comp() const { return compare_holder::get(); }
+       Compare& comp() { return compare_holder::get(); }
+
+       inline static void capacitycheck(size_type n){
+         if (n > N) {
+            std::out_of_range e("StaticFlatMap<>: index out of capacity");
+            BOOST_THROW_EXCEPTION(e);
+         }
+       }
+
+       size_type lower_bound_index(const key_type& key) const {
+          return detail::flat_lower_bound<N>(m_keys.begin(),m_keys.end(),key,comp());
+       }
+
+       size_type find_index(const key_type& key) const {
+          size_type pos = lower_bound_index(key);
+          return (pos != size() && !comp()(key,m_keys[pos])) ? pos : size();
+       }
+
+       // sort entries [old_size,size()) into the sorted entries [0,old_size) and drop duplicate keys, keeping the first
+       void merge_appended(size_type old_size){
+          typedef detail::flat_entry_iterator<Key,Value> entry_iterator;
+          entry_iterator first(m_keys.begin(),m_values.begin());
+          entry_iterator middle = first + old_size;
+          entry_iterator last = first + size();
+          detail::flat_entry_compare<Key,Value,Compare> less(comp());
+          detail::flat_stable_sort(middle,last,less);
+          detail::flat_merge_without_buffer(first,middle,last,less);
+
+          // the keys are sorted, so an entry is kept if its key orders after the last one kept
+          size_type kept = 0;
+          for(size_type i = 1; i < size(); ++i){
+            if(comp()(m_keys[kept],m_keys[i]) && ++kept != i){
+              m_keys[kept] = boost::move(m_keys[i]);
+              m_values[kept] = boost::move(m_values[i]);
+            }
+          }
+          if(!empty()){
+            m_keys.erase(m_keys.begin()+kept+1,m_keys.end());
+            m_values.erase(m_values.begin()+kept+1,m_values.end());
+          }
+       }
+
+       key_container_type m_keys;
+       mapped_container_type m_values;
+}; // class StaticFlatMap
+
+    template<class Key, class Value, std::size_t N, class Compare>
+    bool operator== (const StaticFlatMap<Key,Value,N,Compare>& x, const StaticFlatMap<Key,Value,N,Compare>& y) {
+        return x.keys().size() == y.keys().size()
+            && std::equal(x.keys().begin(), x.keys().end(), y.keys().begin())
+            && std::equal(x.values().begin(), x.values().end(), y.values().begin());
+    }
+    template<class Key, class Value, std::size_t N, class Compare>
+    bool operator!= (const StaticFlatMap<Key,Value,N,Compare>& x, const StaticFlatMap<Key,Value,N,Compare>& y) {
+        return !(x==y);
+    }
+
+    template<class Key, class Value, std::size_t N, class Compare>
+    inline void swap (StaticFlatMap<Key,Value,N,Compare>& x, StaticFlatMap<Key,Value,N,Compare>& y) {
+        x.swap(y);
+    }
+
+} // namespace boost
+
+#endif /*BOOST_STATIC_FLAT_MAP_HPP*/
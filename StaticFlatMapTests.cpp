@@ -0,0 +1,226 @@
+/**
+ *  @file   StaticFlatMapTests.cpp
+ *  @brief  StaticFlatMapTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticFlatSet and StaticFlatMap are not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <StaticFlatMap.hpp>
+#include <StaticVectorTestTypes.hpp>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <new>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace boost;
+
+// counts every allocation of the test program, so bulk inserts can be checked to allocate nothing
+namespace {
+  std::size_t allocations = 0;
+}
+
+void* operator new(std::size_t n){
+  ++allocations;
+  if(void* p = std::malloc(n ? n : 1)){
+    return p;
+  }
+  throw std::bad_alloc();
+}
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+  ++allocations;
+  return std::malloc(n ? n : 1);
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+BOOST_AUTO_TEST_CASE(FlatSetInsertFind){
+  StaticFlatSet<int,8> set;
+  BOOST_CHECK(set.insert(5).second);
+  BOOST_CHECK(set.insert(1).second);
+  BOOST_CHECK(set.insert(3).second);
+  BOOST_CHECK(!set.insert(3).second);
+  BOOST_CHECK_EQUAL(set.size(),3);
+  int expected[] = {1,3,5};
+  BOOST_CHECK_EQUAL_COLLECTIONS(set.begin(),set.end(),expected,expected+3);
+  BOOST_CHECK(set.contains(3));
+  BOOST_CHECK(!set.contains(4));
+  BOOST_CHECK_EQUAL(set.count(5),1);
+  BOOST_CHECK(set.find(4) == set.end());
+  BOOST_CHECK_EQUAL(*set.lower_bound(4),5);
+  BOOST_CHECK_EQUAL(*set.upper_bound(3),5);
+  BOOST_CHECK_EQUAL(set.erase(3),1);
+  BOOST_CHECK_EQUAL(set.erase(3),0);
+  BOOST_CHECK_EQUAL(set.size(),2);
+}
+
+BOOST_AUTO_TEST_CASE(FlatSetBinarySearchMatchesStdSet){
+  // capacity above the linear search limit
+  StaticFlatSet<int,256,std::greater<int> > set;
+  std::set<int,std::greater<int> > stdset;
+  for(int i = 0; i < 200; i++){
+    int value = (i * 37) % 101;
+    BOOST_CHECK_EQUAL(set.insert(value).second,stdset.insert(value).second);
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(set.begin(),set.end(),stdset.begin(),stdset.end());
+  for(int i = -5; i < 110; i++){
+    BOOST_CHECK_EQUAL(set.count(i),stdset.count(i));
+    BOOST_CHECK_EQUAL(set.lower_bound(i)-set.begin(),std::distance(stdset.begin(),stdset.lower_bound(i)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FlatSetBulkInsert){
+  StaticFlatSet<std::string,8> set;
+  set.insert("m");
+  set.insert("c");
+  const char* words[] = {"z","c","a","m","q","a"};
+  set.insert(words,words+6);
+  const char* expected[] = {"a","c","m","q","z"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(set.begin(),set.end(),expected,expected+5);
+  
+  // more input than capacity, but few enough distinct keys to fit
+  StaticFlatSet<int,4> small;
+  int many[] = {3,3,3,1,1,2,2,2,3,1,4};
+  small.insert(many,many+11);
+  BOOST_CHECK_EQUAL(small.size(),4);
+  BOOST_CHECK_EQUAL(small.keys()[0],1);
+  BOOST_CHECK_EQUAL(small.keys()[3],4);
+  BOOST_CHECK_THROW(small.insert(5),std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(FlatMapAccess){
+  StaticFlatMap<int,std::string,16> map;
+  map[3] = "three";
+  map[1] = "one";
+  BOOST_CHECK(map.insert(std::make_pair(2,std::string("two"))).second);
+  BOOST_CHECK(!map.try_emplace(2,"deux").second);
+  BOOST_CHECK(!map.insert_or_assign(1,std::string("uno")).second);
+  BOOST_CHECK_EQUAL(map.size(),3);
+  BOOST_CHECK_EQUAL(map.at(1),"uno");
+  BOOST_CHECK_EQUAL(map.at(2),"two");
+  BOOST_CHECK_EQUAL(map.find(3)->second,"three");
+  BOOST_CHECK(map.find(4) == map.end());
+  BOOST_CHECK_THROW(map.at(4),std::out_of_range);
+  
+  int keys[] = {1,2,3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(map.keys().begin(),map.keys().end(),keys,keys+3);
+  int i = 0;
+  for(StaticFlatMap<int,std::string,16>::const_iterator it = map.begin(); it != map.end(); ++it, ++i){
+    BOOST_CHECK_EQUAL((*it).first,keys[i]);
+  }
+  
+  BOOST_CHECK_EQUAL(map.erase(2),1);
+  BOOST_CHECK_EQUAL(map.size(),2);
+  BOOST_CHECK_EQUAL(map.values()[1],"three");
+}
+
+BOOST_AUTO_TEST_CASE(FlatMapBulkInsertMatchesStdMap){
+  std::vector<std::pair<int,int> > input;
+  for(int i = 0; i < 40; i++){
+    input.push_back(std::make_pair((i * 7) % 23, i));
+  }
+  StaticFlatMap<int,int,32> map;
+  map[5] = -1;
+  std::map<int,int> stdmap;
+  stdmap[5] = -1;
+  map.insert(input.begin(),input.end());
+  stdmap.insert(input.begin(),input.end());
+  BOOST_CHECK_EQUAL(map.size(),stdmap.size());
+  std::map<int,int>::const_iterator expected = stdmap.begin();
+  for(StaticFlatMap<int,int,32>::iterator it = map.begin(); it != map.end(); ++it, ++expected){
+    BOOST_CHECK_EQUAL(it->first,expected->first);
+    BOOST_CHECK_EQUAL(it->second,expected->second);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FlatBulkInsertDoesNotAllocate){
+  int keys[40];
+  std::pair<int,int> entries[40];
+  for(int i = 0; i < 40; i++){
+    keys[i] = (i * 7) % 23;
+    entries[i] = std::make_pair(keys[i], i);
+  }
+  StaticFlatSet<int,32> set;
+  StaticFlatMap<int,int,32> map;
+  set.insert(3);
+  map[3] = -1;
+  std::size_t before = allocations;
+  set.insert(keys,keys+40);
+  map.insert(entries,entries+40);
+  BOOST_CHECK_EQUAL(allocations,before);
+  BOOST_CHECK_EQUAL(set.size(),23);
+  BOOST_CHECK_EQUAL(map.size(),23);
+  BOOST_CHECK_EQUAL(map.at(3),-1);
+}
+
+BOOST_AUTO_TEST_CASE(FlatBulkInsertPastInsertionSort){
+  // batches longer than the insertion sort limit go through the in-place merge sort
+  std::vector<std::pair<int,int> > input;
+  std::set<int> expected_keys;
+  std::map<int,int> expected;
+  std::srand(3);
+  for(int batch = 0; batch < 4; batch++){
+    StaticFlatSet<int,256> set(expected_keys.begin(),expected_keys.end());
+    StaticFlatMap<int,int,256> map(expected.begin(),expected.end());
+    input.clear();
+    for(int i = 0; i < 50; i++){
+      input.push_back(std::make_pair(std::rand() % 150, batch * 100 + i));
+    }
+    std::vector<int> keys;
+    for(std::size_t i = 0; i < input.size(); i++){
+      keys.push_back(input[i].first);
+    }
+    set.insert(keys.begin(),keys.end());
+    expected_keys.insert(keys.begin(),keys.end());
+    map.insert(input.begin(),input.end());
+    expected.insert(input.begin(),input.end());
+    BOOST_REQUIRE_EQUAL(set.size(),expected_keys.size());
+    BOOST_CHECK(std::equal(set.begin(),set.end(),expected_keys.begin()));
+    BOOST_REQUIRE_EQUAL(map.size(),expected.size());
+    std::map<int,int>::const_iterator it = expected.begin();
+    for(std::size_t i = 0; i < map.size(); i++, ++it){
+      BOOST_CHECK_EQUAL(map.keys()[i],it->first);
+      BOOST_CHECK_EQUAL(map.values()[i],it->second);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FlatBulkInsertThrowKeepsOrder){
+  std::vector<Tracked> keys;
+  Tracked::copies_left = 100;
+  for(int k : {9, 1, 7, 3}){
+    keys.push_back(Tracked(k));
+  }
+
+  Tracked::copies_left = 100;
+  StaticFlatSet<Tracked,8> set;
+  set.insert(Tracked(5));
+  Tracked::copies_left = 2;
+  BOOST_CHECK_THROW(set.insert(keys.begin(),keys.end()),std::runtime_error);
+  Tracked::copies_left = 100;
+  BOOST_CHECK_EQUAL(set.size(),1u);
+  BOOST_CHECK(set.find(Tracked(5)) != set.end());
+
+  std::vector<std::pair<int,Tracked> > entries;
+  for(std::size_t i = 0; i < keys.size(); ++i){
+    entries.push_back(std::make_pair(keys[i].value,keys[i]));
+  }
+  StaticFlatMap<int,Tracked,8> map;
+  map.insert(std::make_pair(5,Tracked(5)));
+  Tracked::copies_left = 2;
+  BOOST_CHECK_THROW(map.insert(entries.begin(),entries.end()),std::runtime_error);
+  Tracked::copies_left = 100;
+  BOOST_CHECK_EQUAL(map.size(),1u);
+  BOOST_CHECK_EQUAL(map.keys().size(),map.values().size());
+  BOOST_CHECK(map.find(5) != map.end());
+}
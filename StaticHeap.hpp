@@ -0,0 +1,386 @@
+/**
+ * @file   StaticHeap.hpp
+ * @brief  Fixed capacity priority queue with a cache line aligned d-ary heap layout.
+ *
+ * StaticHeap<T,N,Compare,Arity> keeps a heap of at most N elements in a
+ * fixed array of slots inside the object. Like std::priority_queue, top() is
+ * the largest element under Compare, so std::greater gives a min-heap for
+ * timers and deadlines.
+ *
+ * The children of the element at i are the Arity elements starting at
+ * Arity*i+1. They are contiguous, so picking the best child is one scan over
+ * adjacent memory, and the heap is only log(Arity) as deep as a binary heap.
+ * The default Arity is 4. The slot array is aligned to
+ * BOOST_STATIC_HEAP_CACHE_LINE_SIZE (64 unless defined otherwise) and the
+ * root is stored Arity-1 slots in, so every group of children starts on a
+ * multiple of Arity*sizeof(T) bytes. When that divides the line size, e.g.
+ * 4 or 8 children of 8 bytes, the siblings compared at each level share one
+ * cache line. This costs Arity-1 unused slots and the line alignment of the
+ * heap object. Sift up and sift down move a hole instead of swapping, so
+ * each level costs one move.
+ *
+ * Elements are addressed by their position in the heap array, as returned by
+ * begin() and the position overloads. decrease_key(i, x) moves an element
+ * towards the top, increase_key(i, x) away from it, update(i, x) either way.
+ * heapify(first, last) appends a range and restores the heap in O(n), and
+ * pop_push(x) replaces the top with one sift down.
+ *
+ *  StaticHeap is not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_HEAP_HPP
+#define BOOST_STATIC_HEAP_HPP
+
+#include "StaticVector.hpp"
+#include <boost/core/empty_value.hpp>
+#include <boost/static_assert.hpp>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#ifndef BOOST_STATIC_HEAP_CACHE_LINE_SIZE
+#define BOOST_STATIC_HEAP_CACHE_LINE_SIZE 64
+#endif
+
+namespace boost {
+
+  namespace detail {
+        // move the element x into the hole at i and up towards the root while it orders after its parent
+        template<std::size_t Arity, typename T, typename Compare>
+        inline void heap_sift_up(T* heap, std::size_t i, T x, const Compare& comp){
+            while(i > 0){
+              std::size_t parent = (i - 1) / Arity;
+              if(!comp(heap[parent], x)){
+                break;
+              }
+              heap[i] = boost::move(heap[parent]);
+              i = parent;
+            }
+            heap[i] = boost::move(x);
+        }
+
+        // move the element x into the hole at i and down while one of its children orders after it
+        template<std::size_t Arity, typename T, typename Compare>
+        inline void heap_sift_down(T* heap, std::size_t n, std::size_t i, T x, const Compare& comp){
+            for(;;){
+              std::size_t first = Arity * i + 1;
+              if(first >= n){
+                break;
+              }
+              std::size_t last = first + Arity < n ? first + Arity : n;
+              std::size_t best = first;
+              for(std::size_t c = first + 1; c < last; ++c){
+                if(comp(heap[best], heap[c])) best = c;
+              }
+              if(!comp(x, heap[best])){
+                break;
+              }
+              heap[i] = boost::move(heap[best]);
+              i = best;
+            }
+            heap[i] = boost::move(x);
+        }
+
+        // Floyd's bottom-up construction, sift down every parent starting with the last one
+        template<std::size_t Arity, typename T, typename Compare>
+        inline void heap_make(T* heap, std::size_t n, const Compare& comp){
+            if(n < 2){
+              return;
+            }
+            for(std::size_t i = (n - 2) / Arity + 1; i-- > 0; ){
+              T x(boost::move(heap[i]));
+              heap_sift_down<Arity>(heap, n, i, boost::move(x), comp);
+            }
+        }
+  } // namespace detail
+
+    template<class T, std::size_t N, class Compare = std::less<T>, std::size_t Arity = 4>
+    class StaticHeap : private boost::empty_value<Compare> {
+        BOOST_STATIC_ASSERT(Arity >= 2);
+        typedef boost::empty_value<Compare>                    compare_holder;
+      public:
+        // type definitions
+        typedef T                                              value_type;
+        typedef Compare                                        value_compare;
+        typedef typename boost::uint_value_t<N>::least         size_type;
+        typedef std::ptrdiff_t                                 difference_type;
+        typedef const T&                                       reference;
+        typedef const T&                                       const_reference;
+        typedef const T*                                       iterator;
+        typedef const T*                                       const_iterator;
+
+        enum { static_size = N };
+        enum { arity = Arity };
+
+      private:
+        // the root sits in the last slot of the first group, so the children of i start at slot Arity*(i+1)
+        enum { root_slot = Arity - 1 };
+
+        typedef typename boost::aligned_storage<
+                           sizeof(T),
+                           boost::alignment_of<T>::value
+                         >::type aligned_storage;
+
+        struct BOOST_ALIGNMENT(BOOST_STATIC_HEAP_CACHE_LINE_SIZE) slot_array {
+            aligned_storage elems[N + root_slot];
+        };
+
+        size_type m_size;     // fastest type that can accomodate N
+        slot_array m_slots;   // cache line aligned, the first root_slot slots stay unused
+
+      public:
+
+        explicit StaticHeap(const Compare& comp = Compare()):
+          compare_holder(boost::empty_init_t(), comp),
+          m_size(0)
+        {}
+
+        template<typename InputIterator>
+        StaticHeap(InputIterator first, InputIterator last, const Compare& comp = Compare()):
+          compare_holder(boost::empty_init_t(), comp),
+          m_size(0)
+        {
+          heapify(first,last);
+        }
+
+        StaticHeap(const StaticHeap& rhs):
+          compare_holder(boost::empty_init_t(), rhs.comp()),
+          m_size(0)
+        {
+          std::uninitialized_copy(rhs.begin(),rhs.end(),mutable_data());
+          m_size = rhs.m_size;
+        }
+
+        // rhs is left empty
+        StaticHeap(StaticHeap&& rhs) BOOST_NOEXCEPT_IF(std::is_nothrow_move_constructible<T>::value):
+          compare_holder(boost::empty_init_t(), rhs.comp()),
+          m_size(0)
+        {
+          boost::uninitialized_move(rhs.mutable_data(),rhs.mutable_data()+rhs.size(),mutable_data());
+          m_size = rhs.m_size;
+          rhs.clear();
+        }
+
+        ~StaticHeap(){
+          clear();
+        }
+
+        StaticHeap& operator= (const StaticHeap& rhs) {
+          if(this != &rhs){
+            clear();
+            comp() = rhs.comp();
+            std::uninitialized_copy(rhs.begin(),rhs.end(),mutable_data());
+            m_size = rhs.m_size;
+          }
+          return *this;
+        }
+
+        // rhs is left empty
+        StaticHeap& operator= (StaticHeap&& rhs) BOOST_NOEXCEPT_IF(std::is_nothrow_move_constructible<T>::value) {
+          if(this != &rhs){
+            clear();
+            comp() = rhs.comp();
+            boost::uninitialized_move(rhs.mutable_data(),rhs.mutable_data()+rhs.size(),mutable_data());
+            m_size = rhs.m_size;
+            rhs.clear();
+          }
+          return *this;
+        }
+
+        // iteration in heap order, begin()[0] is the top
+        const_iterator begin() const { return data(); }
+        const_iterator cbegin() const { return data(); }
+        const_iterator end() const { return data() + m_size; }
+        const_iterator cend() const { return data() + m_size; }
+
+        // capacity is constant, size varies
+        size_type size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        bool full() const { return m_size == N; }
+        static size_type capacity() { return N; }
+        static size_type max_size() { return N; }
+
+        const_reference top() const {
+          BOOST_ASSERT( !empty() && "top() of an empty heap" );
+          return *data();
+        }
+
+        // throws std::out_of_range if the heap is full
+        void push(const value_type& x){
+          capacitycheck(size()+1);
+          new (end_slot()) T(x);
+          m_size++;
+          sift_up_last();
+        }
+
+        void push(value_type&& x){
+          capacitycheck(size()+1);
+          new (end_slot()) T(boost::move(x));
+          m_size++;
+          sift_up_last();
+        }
+
+        template<typename... Args>
+        void emplace(Args&&... args){
+          capacitycheck(size()+1);
+          new (end_slot()) T(boost::forward<Args>(args)...);
+          m_size++;
+          sift_up_last();
+        }
+
+        void pop(){
+          BOOST_ASSERT( !empty() && "pop() of an empty heap" );
+          value_type x(boost::move(mutable_data()[size()-1]));
+          pop_back();
+          if(!empty()){
+            detail::heap_sift_down<Arity>(mutable_data(), size(), 0, boost::move(x), comp());
+          }
+        }
+
+        // replace the top with x, cheaper than pop() followed by push()
+        void pop_push(const value_type& x){
+          BOOST_ASSERT( !empty() && "pop_push() of an empty heap" );
+          detail::heap_sift_down<Arity>(mutable_data(), size(), 0, value_type(x), comp());
+        }
+
+        void pop_push(value_type&& x){
+          BOOST_ASSERT( !empty() && "pop_push() of an empty heap" );
+          detail::heap_sift_down<Arity>(mutable_data(), size(), 0, boost::move(x), comp());
+        }
+
+        // append the range and restore the heap, bottom-up in O(size()) unless only a few elements were added;
+        // throws std::out_of_range and leaves the heap unchanged if the range does not fit
+        template<typename InputIterator>
+        void heapify(InputIterator first, InputIterator last){
+          size_type old_size = size();
+          BOOST_TRY {
+            for(; first != last; ++first){
+              capacitycheck(size()+1);
+              new (end_slot()) T(*first);
+              m_size++;
+            }
+          } BOOST_CATCH(...) {
+            while(size() > old_size){
+              pop_back();
+            }
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+          size_type added = size() - old_size;
+          if(added <= old_size / Arity){
+            for(size_type i = old_size; i < size(); ++i){
+              value_type x(boost::move(mutable_data()[i]));
+              detail::heap_sift_up<Arity>(mutable_data(), i, boost::move(x), comp());
+            }
+          } else {
+            detail::heap_make<Arity>(mutable_data(), size(), comp());
+          }
+        }
+
+        // set the element at position i to x, which must not order before it, and move it towards the top
+        void decrease_key(size_type i, const value_type& x){
+          BOOST_ASSERT( i < size() && "position out of range" );
+          BOOST_ASSERT( !comp()(x, mutable_data()[i]) && "decrease_key() would move the element away from the top" );
+          detail::heap_sift_up<Arity>(mutable_data(), i, value_type(x), comp());
+        }
+
+        // set the element at position i to x, which must not order after it, and move it away from the top
+        void increase_key(size_type i, const value_type& x){
+          BOOST_ASSERT( i < size() && "position out of range" );
+          BOOST_ASSERT( !comp()(mutable_data()[i], x) && "increase_key() would move the element towards the top" );
+          detail::heap_sift_down<Arity>(mutable_data(), size(), i, value_type(x), comp());
+        }
+
+        // set the element at position i to x and move it whichever way restores the heap
+        void update(size_type i, const value_type& x){
+          BOOST_ASSERT( i < size() && "position out of range" );
+          if(comp()(mutable_data()[i], x)){
+            detail::heap_sift_up<Arity>(mutable_data(), i, value_type(x), comp());
+          } else {
+            detail::heap_sift_down<Arity>(mutable_data(), size(), i, value_type(x), comp());
+          }
+        }
+
+        // remove the element at position i
+        void erase(size_type i){
+          BOOST_ASSERT( i < size() && "position out of range" );
+          value_type x(boost::move(mutable_data()[size()-1]));
+          pop_back();
+          if(i < size()){
+            // the old last element may belong above or below the hole
+            if(i > 0 && comp()(mutable_data()[(i - 1) / Arity], x)){
+              detail::heap_sift_up<Arity>(mutable_data(), i, boost::move(x), comp());
+            } else {
+              detail::heap_sift_down<Arity>(mutable_data(), size(), i, boost::move(x), comp());
+            }
+          }
+        }
+
+        void clear(){
+          if(!boost::has_trivial_destructor<T>::value){
+            for(size_type i = 0; i < size(); ++i){
+              mutable_data()[i].~T();
+            }
+          }
+          m_size = 0;
+        }
+
+        // swap (note: linear in the larger size)
+        void swap(StaticHeap& y){
+          StaticHeap& longer = size() < y.size() ? y : *this;
+          StaticHeap& shorter = size() < y.size() ? *this : y;
+          size_type common = shorter.size();
+          for(size_type i = 0; i < common; ++i){
+            boost::swap(mutable_data()[i], y.mutable_data()[i]);
+          }
+          boost::uninitialized_move(longer.mutable_data()+common,longer.mutable_data()+longer.size(),shorter.mutable_data()+common);
+          shorter.m_size = longer.m_size;
+          while(longer.size() > common){
+            longer.pop_back();
+          }
+          boost::swap(comp(),y.comp());
+        }
+
+        value_compare value_comp() const { return comp(); }
+
+        // direct access to the heap array, mutable_data()[0] is the top
+        const T* data() const { return reinterpret_cast<const T*>(m_slots.elems + root_slot); }
+
+private:
+       const Compare& comp() const { return compare_holder::get(); }
+       Compare& comp() { return compare_holder::get(); }
+
+       T* mutable_data() { return reinterpret_cast<T*>(m_slots.elems + root_slot); }
+       void* end_slot() { return m_slots.elems + root_slot + m_size; }
+
+       void pop_back(){
+          m_size--;
+          mutable_data()[m_size].~T();
+       }
+
+       static void capacitycheck(std::size_t n){
+          if(n > N){
+            detail::static_vector_throw_out_of_range("StaticHeap<>: index out of capacity");
+          }
+       }
+
+       void sift_up_last(){
+          size_type i = size() - 1;
+          value_type x(boost::move(mutable_data()[i]));
+          detail::heap_sift_up<Arity>(mutable_data(), i, boost::move(x), comp());
+       }
+}; // class StaticHeap
+
+    template<class T, std::size_t N, class Compare, std::size_t Arity>
+    inline void swap (StaticHeap<T,N,Compare,Arity>& x, StaticHeap<T,N,Compare,Arity>& y) {
+        x.swap(y);
+    }
+
+} // namespace boost
+
+#endif /* BOOST_STATIC_HEAP_HPP */
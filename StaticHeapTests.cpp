@@ -0,0 +1,174 @@
+/**
+ *  @file   StaticHeapTests.cpp
+ *  @brief  StaticHeapTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticHeap is not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <StaticHeap.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace boost;
+
+namespace {
+  // every element orders at or before its parent
+  template<class Heap>
+  bool IsHeap(const Heap& heap){
+    typename Heap::value_compare comp = heap.value_comp();
+    for(std::size_t i = 1; i < heap.size(); ++i){
+      if(comp(heap.begin()[(i-1)/Heap::arity],heap.begin()[i])){
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template<std::size_t Arity>
+  void CheckMatchesPriorityQueue(){
+    typedef StaticHeap<int,300,std::greater<int>,Arity> Heap;
+    Heap heap;
+    std::priority_queue<int,std::vector<int>,std::greater<int> > expected;
+    std::srand(5);
+    for(int step = 0; step < 3000; ++step){
+      int op = std::rand() % 4;
+      if(op < 2 && !heap.full()){
+        int x = std::rand() % 1000;
+        heap.push(x);
+        expected.push(x);
+      } else if(op == 2 && !heap.empty()){
+        heap.pop();
+        expected.pop();
+      } else if(op == 3 && !heap.empty()){
+        int x = std::rand() % 1000;
+        heap.pop_push(x);
+        expected.pop();
+        expected.push(x);
+      }
+      BOOST_REQUIRE_EQUAL(heap.size(),expected.size());
+      if(!heap.empty()){
+        BOOST_REQUIRE_EQUAL(heap.top(),expected.top());
+      }
+    }
+    BOOST_CHECK(IsHeap(heap));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(HeapMatchesPriorityQueue){
+  CheckMatchesPriorityQueue<2>();
+  CheckMatchesPriorityQueue<4>();
+  CheckMatchesPriorityQueue<8>();
+}
+
+BOOST_AUTO_TEST_CASE(HeapifyRanges){
+  std::vector<int> values;
+  for(int i = 0; i < 200; i++){
+    values.push_back((i * 37) % 101);
+  }
+  StaticHeap<int,256,std::less<int>,8> heap(values.begin(),values.end());
+  BOOST_CHECK_EQUAL(heap.size(),200);
+  BOOST_CHECK(IsHeap(heap));
+
+  // a few more elements are sifted up one by one, a larger batch rebuilds the heap
+  heap.heapify(values.begin(),values.begin()+10);
+  BOOST_CHECK(IsHeap(heap));
+  StaticHeap<int,256,std::less<int>,8> small(values.begin(),values.begin()+3);
+  small.heapify(values.begin()+3,values.end());
+  BOOST_CHECK(IsHeap(small));
+  BOOST_CHECK_THROW(heap.heapify(values.begin(),values.end()),std::out_of_range);
+  BOOST_CHECK_EQUAL(heap.size(),210);
+
+  std::vector<int> drained;
+  while(!small.empty()){
+    drained.push_back(small.top());
+    small.pop();
+  }
+  std::sort(values.begin(),values.end(),std::greater<int>());
+  BOOST_CHECK(drained == values);
+}
+
+BOOST_AUTO_TEST_CASE(HeapKeysByPosition){
+  typedef StaticHeap<int,64,std::greater<int> > Timers;
+  Timers timers;
+  for(int i = 0; i < 40; i++){
+    timers.push(100 + i);
+  }
+  // an earlier deadline moves the timer to the top
+  Timers::const_iterator last = timers.end()-1;
+  timers.decrease_key(last-timers.begin(),5);
+  BOOST_CHECK_EQUAL(timers.top(),5);
+  BOOST_CHECK(IsHeap(timers));
+
+  timers.increase_key(0,1000);
+  BOOST_CHECK_EQUAL(timers.top(),100);
+  BOOST_CHECK(IsHeap(timers));
+
+  timers.update(20,1);
+  BOOST_CHECK_EQUAL(timers.top(),1);
+  timers.update(0,500);
+  BOOST_CHECK(IsHeap(timers));
+
+  std::size_t size = timers.size();
+  for(std::size_t i = 0; i < 10; i++){
+    timers.erase((i * 7) % timers.size());
+    BOOST_CHECK(IsHeap(timers));
+  }
+  BOOST_CHECK_EQUAL(timers.size(),size-10);
+  timers.erase(timers.size()-1);
+  BOOST_CHECK(IsHeap(timers));
+}
+
+BOOST_AUTO_TEST_CASE(HeapOfStrings){
+  StaticHeap<std::string,4> heap;
+  heap.emplace(3,'b');
+  heap.push("c");
+  heap.push(std::string("a"));
+  heap.emplace("d");
+  BOOST_CHECK(heap.full());
+  BOOST_CHECK_THROW(heap.push("e"),std::out_of_range);
+  BOOST_CHECK_EQUAL(heap.top(),"d");
+  heap.pop_push(std::string("aa"));
+  BOOST_CHECK_EQUAL(heap.top(),"c");
+
+  StaticHeap<std::string,4> other;
+  other.push("z");
+  swap(heap,other);
+  BOOST_CHECK_EQUAL(heap.size(),1);
+  BOOST_CHECK_EQUAL(other.top(),"c");
+  other.clear();
+  BOOST_CHECK(other.empty());
+}
+
+BOOST_AUTO_TEST_CASE(HeapSiblingsShareACacheLine){
+  typedef StaticHeap<double,200,std::less<double>,8> Heap;
+  Heap heap;
+  for(int i = 0; i < 200; i++){
+    heap.push((i * 37) % 101);
+  }
+  // the children of i start at Arity*i+1 and 8 doubles fill exactly one 64 byte line
+  for(std::size_t i = 0; 8*i+1 < heap.size(); ++i){
+    const double* first = heap.data() + 8*i + 1;
+    BOOST_REQUIRE_EQUAL(reinterpret_cast<std::size_t>(first) % 64,0u);
+  }
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::size_t>(&heap) % 64,0u);
+
+  // copies and moves land in their own aligned slots
+  Heap copy(heap);
+  BOOST_CHECK(std::equal(heap.begin(),heap.end(),copy.begin()));
+  Heap moved(std::move(copy));
+  BOOST_CHECK(copy.empty());
+  BOOST_CHECK_EQUAL(moved.size(),200);
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::size_t>(moved.data()+1) % 64,0u);
+  BOOST_CHECK(IsHeap(moved));
+}
@@ -0,0 +1,397 @@
+/**
+ * @file   StaticMatrix.hpp
+ * @brief  Matrix with runtime dimensions up to fixed bounds, stored in one StaticVector.
+ *
+ * StaticMatrix<T, MaxRows, MaxCols, Layout> holds rows() x cols() elements
+ * packed into a single StaticVector<T, MaxRows*MaxCols>: with
+ * matrix_row_major (the default) row i starts at element i*cols(), with
+ * matrix_column_major column j starts at element j*rows(). The active
+ * elements are therefore one contiguous run without gaps or per-row sizes,
+ * and the lines along the layout (rows for row major) are unit stride.
+ *
+ * resize(rows, cols) keeps the elements of the overlapping top left block
+ * in place, moving the lines within the block when the line length changes,
+ * and fills new elements with a value. row(i) and col(j) are strided views
+ * into the matrix.
+ *
+ * transpose() and multiply() / operator* work on tiles of
+ * BOOST_STATIC_MATRIX_BLOCK x BOOST_STATIC_MATRIX_BLOCK elements, and
+ * multiply orders its loops so the innermost one runs along unit stride
+ * lines of both the result and the right (row major) or left (column major)
+ * operand, where the compiler can vectorize it.
+ *
+ *   typedef boost::StaticMatrix<double, 8, 8> Jacobian;
+ *   Jacobian j(states, inputs);
+ *   ...
+ *   StaticMatrix<double, 8, 8> p = j * covariance * transpose(j);
+ *
+ *  StaticMatrix is not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_MATRIX_HPP
+#define BOOST_STATIC_MATRIX_HPP
+
+#include "StaticVector.hpp"
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+// edge length of the tiles used by transpose and multiply
+#ifndef BOOST_STATIC_MATRIX_BLOCK
+#define BOOST_STATIC_MATRIX_BLOCK 8
+#endif
+
+namespace boost {
+
+    // layouts of StaticMatrix
+    struct matrix_row_major {};
+    struct matrix_column_major {};
+
+  namespace detail {
+        // offsets of element (i,j) along and across the lines of a layout
+        template<class Layout>
+        struct matrix_layout {
+            // row major, lines are rows
+            static std::size_t index(std::size_t i, std::size_t j, std::size_t /*rows*/, std::size_t cols) { return i * cols + j; }
+            static std::size_t row_stride(std::size_t /*rows*/, std::size_t cols) { return cols; }
+            static std::size_t col_stride(std::size_t /*rows*/, std::size_t /*cols*/) { return 1; }
+            static std::size_t lines(std::size_t rows, std::size_t /*cols*/) { return rows; }
+            static std::size_t line_length(std::size_t /*rows*/, std::size_t cols) { return cols; }
+        };
+
+        template<>
+        struct matrix_layout<matrix_column_major> {
+            static std::size_t index(std::size_t i, std::size_t j, std::size_t rows, std::size_t /*cols*/) { return j * rows + i; }
+            static std::size_t row_stride(std::size_t /*rows*/, std::size_t /*cols*/) { return 1; }
+            static std::size_t col_stride(std::size_t rows, std::size_t /*cols*/) { return rows; }
+            static std::size_t lines(std::size_t /*rows*/, std::size_t cols) { return cols; }
+            static std::size_t line_length(std::size_t rows, std::size_t /*cols*/) { return rows; }
+        };
+
+        // random access iterator stepping over a fixed number of elements
+        template<class T>
+        class strided_iterator
+          : public boost::iterator_facade< strided_iterator<T>, T, boost::random_access_traversal_tag >
+        {
+          public:
+            strided_iterator():m_p(0),m_stride(0){}
+            strided_iterator(T* p, std::ptrdiff_t stride):m_p(p),m_stride(stride){}
+
+          private:
+            friend class boost::iterator_core_access;
+
+            T& dereference() const { return *m_p; }
+            bool equal(const strided_iterator& rhs) const { return m_p == rhs.m_p; }
+            void increment() { m_p += m_stride; }
+            void decrement() { m_p -= m_stride; }
+            void advance(std::ptrdiff_t n) { m_p += n * m_stride; }
+            std::ptrdiff_t distance_to(const strided_iterator& rhs) const { return (rhs.m_p - m_p) / m_stride; }
+
+            T*             m_p;
+            std::ptrdiff_t m_stride;
+        };
+  } // namespace detail
+
+    // a row or column of a StaticMatrix, valid until the matrix is resized
+    template<class T>
+    class StaticMatrixSlice {
+      public:
+        typedef T                                   value_type;
+        typedef T&                                  reference;
+        typedef detail::strided_iterator<T>         iterator;
+        typedef std::size_t                         size_type;
+
+        StaticMatrixSlice(T* first, std::size_t size, std::size_t stride):m_first(first),m_size(size),m_stride(stride){}
+
+        size_type size() const { return m_size; }
+        size_type stride() const { return m_stride; }
+        T* data() const { return m_first; }
+        reference operator[](std::size_t k) const { BOOST_ASSERT(k < m_size && "StaticMatrixSlice<>: out of range"); return m_first[k * m_stride]; }
+        iterator begin() const { return iterator(m_first, m_stride); }
+        iterator end() const { return iterator(m_first + m_size * m_stride, m_stride); }
+
+      private:
+        T*          m_first;
+        std::size_t m_size;
+        std::size_t m_stride;
+    };
+
+    template<class T, std::size_t MaxRows, std::size_t MaxCols, class Layout = matrix_row_major>
+    class StaticMatrix {
+        typedef detail::matrix_layout<Layout>                  layout;
+      public:
+        // type definitions
+        typedef T                                              value_type;
+        typedef T&                                             reference;
+        typedef const T&                                       const_reference;
+        typedef T*                                             pointer;
+        typedef const T*                                       const_pointer;
+        typedef Layout                                         layout_type;
+        typedef StaticVector<T, MaxRows*MaxCols>               container_type;
+        typedef typename container_type::iterator              iterator;
+        typedef typename container_type::const_iterator        const_iterator;
+        typedef typename boost::uint_value_t<MaxRows>::least   row_index_type;
+        typedef typename boost::uint_value_t<MaxCols>::least   col_index_type;
+        typedef StaticMatrixSlice<T>                           slice_type;
+        typedef StaticMatrixSlice<const T>                     const_slice_type;
+        typedef StaticMatrix<T, MaxCols, MaxRows, Layout>      transpose_type;
+
+        StaticMatrix():m_rows(0),m_cols(0){}
+
+        StaticMatrix(std::size_t rows, std::size_t cols, const T& value = T()):m_rows(0),m_cols(0){
+          resize(rows, cols, value);
+        }
+
+        // dimensions
+        std::size_t rows() const { return m_rows; }
+        std::size_t cols() const { return m_cols; }
+        std::size_t size() const { return m_elems.size(); }
+        bool empty() const { return m_elems.empty(); }
+        static std::size_t max_rows() { return MaxRows; }
+        static std::size_t max_cols() { return MaxCols; }
+
+        // element access
+        reference operator()(std::size_t i, std::size_t j){
+          BOOST_ASSERT(i < rows() && j < cols() && "StaticMatrix<>: out of range");
+          return m_elems.data()[layout::index(i, j, m_rows, m_cols)];
+        }
+        const_reference operator()(std::size_t i, std::size_t j) const {
+          BOOST_ASSERT(i < rows() && j < cols() && "StaticMatrix<>: out of range");
+          return m_elems.data()[layout::index(i, j, m_rows, m_cols)];
+        }
+        reference at(std::size_t i, std::size_t j) { rangecheck(i, j); return (*this)(i, j); }
+        const_reference at(std::size_t i, std::size_t j) const { rangecheck(i, j); return (*this)(i, j); }
+
+        // the rows()*cols() packed elements in layout order
+        pointer data() { return m_elems.data(); }
+        const_pointer data() const { return m_elems.data(); }
+        iterator begin() { return m_elems.begin(); }
+        const_iterator begin() const { return m_elems.begin(); }
+        iterator end() { return m_elems.end(); }
+        const_iterator end() const { return m_elems.end(); }
+
+        // distance between neighbours in a column (row_stride) and in a row (col_stride)
+        std::size_t row_stride() const { return layout::row_stride(m_rows, m_cols); }
+        std::size_t col_stride() const { return layout::col_stride(m_rows, m_cols); }
+
+        slice_type row(std::size_t i){
+          BOOST_ASSERT(i < rows());
+          return slice_type(data() + layout::index(i, 0, m_rows, m_cols), m_cols, col_stride());
+        }
+        const_slice_type row(std::size_t i) const {
+          BOOST_ASSERT(i < rows());
+          return const_slice_type(data() + layout::index(i, 0, m_rows, m_cols), m_cols, col_stride());
+        }
+        slice_type col(std::size_t j){
+          BOOST_ASSERT(j < cols());
+          return slice_type(data() + layout::index(0, j, m_rows, m_cols), m_rows, row_stride());
+        }
+        const_slice_type col(std::size_t j) const {
+          BOOST_ASSERT(j < cols());
+          return const_slice_type(data() + layout::index(0, j, m_rows, m_cols), m_rows, row_stride());
+        }
+
+        void fill(const T& value) { std::fill(begin(), end(), value); }
+
+        void clear(){
+          m_elems.clear();
+          m_rows = 0;
+          m_cols = 0;
+        }
+
+        // changes the dimensions, (i,j) keeps its value for i < min(rows) and j < min(cols),
+        // the other elements are copies of value
+        void resize(std::size_t rows, std::size_t cols, const T& value = T()){
+          if(rows > MaxRows || cols > MaxCols){
+            detail::static_vector_throw_out_of_range("StaticMatrix<>: dimensions out of capacity");
+          }
+          if(rows == 0 || cols == 0){
+            clear();
+            m_rows = static_cast<row_index_type>(rows);
+            m_cols = static_cast<col_index_type>(cols);
+            return;
+          }
+          std::size_t lines = layout::lines(m_rows, m_cols);
+          std::size_t length = layout::line_length(m_rows, m_cols);
+          std::size_t new_lines = layout::lines(rows, cols);
+          std::size_t new_length = layout::line_length(rows, cols);
+          // shorter lines: pack the kept prefixes of the lines to the front
+          if(new_length < length){
+            for(std::size_t l = 1; l < lines; ++l){
+              std::copy(begin() + l*length, begin() + l*length + new_length, begin() + l*new_length);
+            }
+            m_elems.resize(lines * new_length, value);
+            length = new_length;
+          }
+          if(new_lines < lines){
+            m_elems.resize(new_lines * length, value);
+            lines = new_lines;
+          }
+          // longer lines: spread the lines out from the back and fill the gaps
+          if(new_length > length){
+            m_elems.resize(lines * new_length, value);
+            for(std::size_t l = lines; l-- > 0;){
+              if(l > 0){
+                std::copy_backward(begin() + l*length, begin() + (l+1)*length, begin() + l*new_length + length);
+              }
+              std::fill(begin() + l*new_length + length, begin() + (l+1)*new_length, value);
+            }
+            length = new_length;
+          }
+          m_elems.resize(new_lines * length, value);
+          m_rows = static_cast<row_index_type>(rows);
+          m_cols = static_cast<col_index_type>(cols);
+        }
+
+        // cols() x rows() matrix of the same layout with (j,i) = (*this)(i,j)
+        transpose_type transpose() const {
+          transpose_type result(m_cols, m_rows);
+          const std::size_t block = BOOST_STATIC_MATRIX_BLOCK;
+          for(std::size_t i0 = 0; i0 < m_rows; i0 += block){
+            std::size_t i1 = (std::min)(i0 + block, std::size_t(m_rows));
+            for(std::size_t j0 = 0; j0 < m_cols; j0 += block){
+              std::size_t j1 = (std::min)(j0 + block, std::size_t(m_cols));
+              for(std::size_t i = i0; i < i1; ++i){
+                for(std::size_t j = j0; j < j1; ++j){
+                  result(j, i) = (*this)(i, j);
+                }
+              }
+            }
+          }
+          return result;
+        }
+
+        void swap(StaticMatrix& y){
+          m_elems.swap(y.m_elems);
+          std::swap(m_rows, y.m_rows);
+          std::swap(m_cols, y.m_cols);
+        }
+
+      private:
+        void rangecheck(std::size_t i, std::size_t j) const {
+          if(i >= rows() || j >= cols()){
+            detail::static_vector_throw_out_of_range("StaticMatrix<>: index out of range");
+          }
+        }
+
+        container_type m_elems;
+        row_index_type m_rows;
+        col_index_type m_cols;
+    };
+
+  namespace detail {
+        // c += a * b over the tile rows [i0,i1), inner [k0,k1), cols [j0,j1), innermost loop over j
+        template<class T>
+        inline void matrix_multiply_tile_j(const T* a, std::size_t a_rs, std::size_t a_cs,
+                                           const T* b, std::size_t b_rs,
+                                           T* c, std::size_t c_rs,
+                                           std::size_t i0, std::size_t i1, std::size_t k0, std::size_t k1,
+                                           std::size_t j0, std::size_t j1){
+          for(std::size_t i = i0; i < i1; ++i){
+            T* c_row = c + i * c_rs;
+            for(std::size_t k = k0; k < k1; ++k){
+              const T aik = a[i * a_rs + k * a_cs];
+              const T* b_row = b + k * b_rs;
+              for(std::size_t j = j0; j < j1; ++j){
+                c_row[j] += aik * b_row[j];
+              }
+            }
+          }
+        }
+
+        // the same with the innermost loop over i, for column major results
+        template<class T>
+        inline void matrix_multiply_tile_i(const T* a, std::size_t a_cs,
+                                           const T* b, std::size_t b_rs, std::size_t b_cs,
+                                           T* c, std::size_t c_cs,
+                                           std::size_t i0, std::size_t i1, std::size_t k0, std::size_t k1,
+                                           std::size_t j0, std::size_t j1){
+          for(std::size_t j = j0; j < j1; ++j){
+            T* c_col = c + j * c_cs;
+            for(std::size_t k = k0; k < k1; ++k){
+              const T bkj = b[k * b_rs + j * b_cs];
+              const T* a_col = a + k * a_cs;
+              for(std::size_t i = i0; i < i1; ++i){
+                c_col[i] += a_col[i] * bkj;
+              }
+            }
+          }
+        }
+
+        template<class T, std::size_t R, std::size_t K, std::size_t K2, std::size_t C>
+        inline void matrix_multiply(const StaticMatrix<T,R,K,matrix_row_major>& a,
+                                    const StaticMatrix<T,K2,C,matrix_row_major>& b,
+                                    StaticMatrix<T,R,C,matrix_row_major>& c,
+                                    std::size_t i0, std::size_t i1, std::size_t k0, std::size_t k1,
+                                    std::size_t j0, std::size_t j1){
+          matrix_multiply_tile_j(a.data(), a.row_stride(), a.col_stride(), b.data(), b.row_stride(),
+                                 c.data(), c.row_stride(), i0, i1, k0, k1, j0, j1);
+        }
+
+        template<class T, std::size_t R, std::size_t K, std::size_t K2, std::size_t C>
+        inline void matrix_multiply(const StaticMatrix<T,R,K,matrix_column_major>& a,
+                                    const StaticMatrix<T,K2,C,matrix_column_major>& b,
+                                    StaticMatrix<T,R,C,matrix_column_major>& c,
+                                    std::size_t i0, std::size_t i1, std::size_t k0, std::size_t k1,
+                                    std::size_t j0, std::size_t j1){
+          matrix_multiply_tile_i(a.data(), a.col_stride(), b.data(), b.row_stride(), b.col_stride(),
+                                 c.data(), c.col_stride(), i0, i1, k0, k1, j0, j1);
+        }
+  } // namespace detail
+
+    // a.rows() x b.cols() product, a.cols() must equal b.rows()
+    template<class T, std::size_t R, std::size_t K, std::size_t K2, std::size_t C, class Layout>
+    StaticMatrix<T,R,C,Layout> multiply(const StaticMatrix<T,R,K,Layout>& a, const StaticMatrix<T,K2,C,Layout>& b){
+      if(a.cols() != b.rows()){
+        std::invalid_argument e("StaticMatrix<>: inner dimensions differ");
+        BOOST_THROW_EXCEPTION(e);
+      }
+      StaticMatrix<T,R,C,Layout> c(a.rows(), b.cols(), T());
+      const std::size_t block = BOOST_STATIC_MATRIX_BLOCK;
+      for(std::size_t i0 = 0; i0 < a.rows(); i0 += block){
+        std::size_t i1 = (std::min)(i0 + block, a.rows());
+        for(std::size_t k0 = 0; k0 < a.cols(); k0 += block){
+          std::size_t k1 = (std::min)(k0 + block, a.cols());
+          for(std::size_t j0 = 0; j0 < b.cols(); j0 += block){
+            std::size_t j1 = (std::min)(j0 + block, b.cols());
+            detail::matrix_multiply(a, b, c, i0, i1, k0, k1, j0, j1);
+          }
+        }
+      }
+      return c;
+    }
+
+    template<class T, std::size_t R, std::size_t K, std::size_t K2, std::size_t C, class Layout>
+    StaticMatrix<T,R,C,Layout> operator* (const StaticMatrix<T,R,K,Layout>& a, const StaticMatrix<T,K2,C,Layout>& b){
+      return multiply(a, b);
+    }
+
+    template<class T, std::size_t R, std::size_t C, class Layout>
+    typename StaticMatrix<T,R,C,Layout>::transpose_type transpose(const StaticMatrix<T,R,C,Layout>& m){
+      return m.transpose();
+    }
+
+    // equal dimensions and elements
+    template<class T, std::size_t R, std::size_t C, class Layout>
+    bool operator== (const StaticMatrix<T,R,C,Layout>& x, const StaticMatrix<T,R,C,Layout>& y){
+      return x.rows() == y.rows() && x.cols() == y.cols() && std::equal(x.begin(), x.end(), y.begin());
+    }
+
+    template<class T, std::size_t R, std::size_t C, class Layout>
+    bool operator!= (const StaticMatrix<T,R,C,Layout>& x, const StaticMatrix<T,R,C,Layout>& y){
+      return !(x == y);
+    }
+
+    template<class T, std::size_t R, std::size_t C, class Layout>
+    inline void swap (StaticMatrix<T,R,C,Layout>& x, StaticMatrix<T,R,C,Layout>& y){
+      x.swap(y);
+    }
+
+} // namespace boost
+
+#endif /* BOOST_STATIC_MATRIX_HPP */
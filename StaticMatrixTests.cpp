@@ -0,0 +1,148 @@
+/**
+ *  @file   StaticMatrixTests.cpp
+ *  @brief  StaticMatrixTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticMatrix is not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <StaticMatrix.hpp>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+using namespace boost;
+
+namespace {
+  template<class Matrix>
+  void Number(Matrix& m){
+    for(std::size_t i = 0; i < m.rows(); ++i){
+      for(std::size_t j = 0; j < m.cols(); ++j){
+        m(i,j) = int(10*i + j);
+      }
+    }
+  }
+
+  template<class Matrix>
+  bool NumberedBlock(const Matrix& m, std::size_t rows, std::size_t cols, int fill){
+    bool ok = true;
+    for(std::size_t i = 0; i < m.rows(); ++i){
+      for(std::size_t j = 0; j < m.cols(); ++j){
+        ok = ok && m(i,j) == (i < rows && j < cols ? int(10*i + j) : fill);
+      }
+    }
+    return ok;
+  }
+
+  template<class Layout>
+  void CheckResize(){
+    StaticMatrix<int,6,7,Layout> m(3,4);
+    Number(m);
+    BOOST_CHECK_EQUAL(m.size(),12u);
+    std::size_t shapes[][2] = { {5,6}, {2,3}, {6,2}, {1,7}, {4,4}, {0,3}, {2,2} };
+    std::size_t rows = 3, cols = 4;
+    for(std::size_t s = 0; s < 7; ++s){
+      m.resize(shapes[s][0],shapes[s][1],-1);
+      BOOST_CHECK_EQUAL(m.rows(),shapes[s][0]);
+      BOOST_CHECK_EQUAL(m.cols(),shapes[s][1]);
+      BOOST_CHECK_EQUAL(m.size(),shapes[s][0]*shapes[s][1]);
+      rows = (std::min)(rows,shapes[s][0]);
+      cols = (std::min)(cols,shapes[s][1]);
+      BOOST_CHECK(NumberedBlock(m,rows,cols,-1));
+      if(s == 4){
+        Number(m);
+        rows = 4;
+        cols = 4;
+      }
+    }
+    BOOST_CHECK_THROW(m.resize(7,1),std::out_of_range);
+    BOOST_CHECK_THROW(m.at(2,0),std::out_of_range);
+  }
+
+  template<class Layout>
+  void CheckMultiply(std::size_t n, std::size_t k, std::size_t p){
+    typedef StaticMatrix<double,20,20,Layout> Matrix;
+    Matrix a(n,k), b(k,p);
+    for(std::size_t i = 0; i < a.size(); ++i){
+      a.data()[i] = std::rand() % 7 - 3;
+    }
+    for(std::size_t i = 0; i < b.size(); ++i){
+      b.data()[i] = std::rand() % 5 - 2;
+    }
+    Matrix c = a * b;
+    BOOST_REQUIRE_EQUAL(c.rows(),n);
+    BOOST_REQUIRE_EQUAL(c.cols(),p);
+    bool ok = true;
+    for(std::size_t i = 0; i < n; ++i){
+      for(std::size_t j = 0; j < p; ++j){
+        double expected = 0;
+        for(std::size_t x = 0; x < k; ++x){
+          expected += a(i,x) * b(x,j);
+        }
+        ok = ok && c(i,j) == expected;
+      }
+    }
+    BOOST_CHECK(ok);
+    BOOST_CHECK(transpose(c) == transpose(b) * transpose(a));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MatrixLayoutAndSlices){
+  BOOST_CHECK(sizeof(StaticMatrix<double,8,8>) <= 64*sizeof(double) + 2*sizeof(double));
+  StaticMatrix<int,4,4> rows(2,3);
+  StaticMatrix<int,4,4,matrix_column_major> cols(2,3);
+  Number(rows);
+  Number(cols);
+  // packed, without gaps for the unused capacity
+  int row_major[] = {0,1,2,10,11,12};
+  int column_major[] = {0,10,1,11,2,12};
+  BOOST_CHECK(std::equal(rows.begin(),rows.end(),row_major));
+  BOOST_CHECK(std::equal(cols.begin(),cols.end(),column_major));
+  
+  StaticMatrixSlice<int> r = rows.row(1);
+  BOOST_CHECK_EQUAL(r.size(),3u);
+  BOOST_CHECK_EQUAL(r.stride(),1u);
+  BOOST_CHECK_EQUAL(std::accumulate(r.begin(),r.end(),0),33);
+  StaticMatrixSlice<int> c = cols.row(1);
+  BOOST_CHECK_EQUAL(c.stride(),2u);
+  BOOST_CHECK_EQUAL(std::accumulate(c.begin(),c.end(),0),33);
+  cols.col(2)[1] = 99;
+  BOOST_CHECK_EQUAL(cols(1,2),99);
+  const StaticMatrix<int,4,4>& constant = rows;
+  BOOST_CHECK_EQUAL(constant.col(2).end() - constant.col(2).begin(),2);
+  BOOST_CHECK_EQUAL(constant.col(2)[1],12);
+}
+
+BOOST_AUTO_TEST_CASE(MatrixResizeKeepsElements){
+  CheckResize<matrix_row_major>();
+  CheckResize<matrix_column_major>();
+  StaticMatrix<std::string,3,3> names(1,1,"a");
+  names.resize(3,2,"b");
+  names.resize(2,3,"c");
+  BOOST_CHECK_EQUAL(names(0,0),"a");
+  BOOST_CHECK_EQUAL(names(1,1),"b");
+  BOOST_CHECK_EQUAL(names(1,2),"c");
+}
+
+BOOST_AUTO_TEST_CASE(MatrixTransposeMultiply){
+  std::srand(5);
+  // sizes on and across the tile edges
+  CheckMultiply<matrix_row_major>(3,4,5);
+  CheckMultiply<matrix_row_major>(17,9,20);
+  CheckMultiply<matrix_column_major>(3,4,5);
+  CheckMultiply<matrix_column_major>(16,20,11);
+  
+  StaticMatrix<int,4,3> m(2,3);
+  Number(m);
+  StaticMatrix<int,3,4> t = m.transpose();
+  BOOST_CHECK_EQUAL(t.rows(),3u);
+  BOOST_CHECK_EQUAL(t(2,1),12);
+  StaticMatrix<int,4,4> wrong(2,2);
+  BOOST_CHECK_THROW(m * wrong,std::invalid_argument);
+}
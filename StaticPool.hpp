@@ -0,0 +1,401 @@
+/**
+ * @file   StaticPool.hpp
+ * @brief  Fixed capacity object pool and inline arena allocator.
+ *
+ * StaticPool<T, N> keeps N slots in an aligned_storage block like StaticVector,
+ * but objects never move once created: allocate() constructs an object in a
+ * free slot and deallocate() destroys it and returns the slot, both in O(1).
+ * Free slots are chained through an intrusive free list stored in the slot
+ * memory itself, so the pool has no bookkeeping beyond one generation counter
+ * per slot.
+ *
+ * allocate() returns a handle of slot index and generation. The generation of
+ * a slot is odd while it holds an object and is incremented on every
+ * allocate and deallocate, so a handle kept after its object was deallocated
+ * is detected: get() returns 0, at() throws and deallocate() returns false.
+ * begin()/end() iterate over the live objects in slot order.
+ *
+ * StaticArena<Bytes> is an inline buffer handing out memory with a bump
+ * pointer, and StaticArenaAllocator<T, Bytes> is a standard allocator over
+ * an arena, so std::vector, std::map and friends can take their memory from
+ * it. Only the most recent allocation is given back on deallocate, the rest
+ * is reclaimed when the arena is reset or destroyed. Requests that do not
+ * fit fall back to ::operator new, with the alignment of T, so the arena is
+ * sized for the common case the way SmallVector is.
+ *
+ *  StaticPool and StaticArena are not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_POOL_HPP
+#define BOOST_STATIC_POOL_HPP
+
+#include "StaticVector.hpp"
+#include <boost/cstdint.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_const.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace boost {
+
+  namespace detail {
+        template<typename Pool>
+        class pool_iterator;
+  } // namespace detail
+
+    template<class T, std::size_t N>
+    class StaticPool : private boost::noncopyable {
+        BOOST_STATIC_ASSERT(N > 0);
+      public:
+        // type definitions
+        typedef T                                              value_type;
+        typedef T*                                             pointer;
+        typedef const T*                                       const_pointer;
+        typedef T&                                             reference;
+        typedef const T&                                       const_reference;
+        typedef typename boost::uint_value_t<N>::least         size_type;
+        typedef boost::uint32_t                                generation_type;
+        typedef detail::pool_iterator<StaticPool>              iterator;
+        typedef detail::pool_iterator<const StaticPool>        const_iterator;
+
+        // identifies one object for its whole lifetime, a default constructed handle is never valid
+        struct handle {
+            handle():index(0),generation(0){}
+            handle(size_type i, generation_type g):index(i),generation(g){}
+            bool operator==(const handle& rhs) const { return index == rhs.index && generation == rhs.generation; }
+            bool operator!=(const handle& rhs) const { return !(*this == rhs); }
+            size_type       index;
+            generation_type generation;
+        };
+
+        enum { static_size = N };
+
+      private:
+        // a slot holds either a T or, while free, the index of the next free slot
+        typedef typename boost::aligned_storage<
+                           (sizeof(T) > sizeof(size_type) ? sizeof(T) : sizeof(size_type)),
+                           (boost::alignment_of<T>::value > boost::alignment_of<size_type>::value
+                              ? boost::alignment_of<T>::value : boost::alignment_of<size_type>::value)
+                         >::type aligned_storage;
+
+        size_type m_size;                   // number of live objects
+        size_type m_free;                   // first free slot, or N if there is none
+        generation_type m_generation[N];    // odd while the slot holds an object
+        aligned_storage elems[N];           // N memory aligned slots
+
+      public:
+
+        StaticPool():m_size(0),m_free(0){
+          for(size_type i = 0; i < N; ++i){
+            m_generation[i] = 0;
+            next_free(i) = size_type(i + 1);
+          }
+        }
+
+        ~StaticPool(){
+          clear();
+        }
+
+        // construct an object from args in a free slot, throws std::out_of_range if the pool is full
+        template<class... Args>
+        handle allocate(Args&&... args){
+          capacitycheck(size()+1);
+          size_type i = m_free;
+          size_type next = next_free(i);
+          BOOST_TRY {
+            new (&elems[i]) T(boost::forward<Args>(args)...);
+          } BOOST_CATCH(...) {
+            next_free(i) = next;
+            BOOST_RETHROW;
+          }
+          BOOST_CATCH_END
+          m_free = next;
+          ++m_size;
+          return handle(i, ++m_generation[i]);
+        }
+
+        // destroy the object of h and free its slot, false if h is stale or invalid
+        bool deallocate(handle h){
+          if(!valid(h)){
+            return false;
+          }
+          release(h.index);
+          return true;
+        }
+
+        // destroy the object at p, which must be a live object of this pool
+        void deallocate(T* p){
+          size_type i = index_of(p);
+          BOOST_ASSERT( is_live(i) && "object is not live" );
+          release(i);
+        }
+
+        bool valid(handle h) const {
+          return h.index < N && (h.generation & 1) && m_generation[h.index] == h.generation;
+        }
+
+        // the object of h, or 0 if h is stale or invalid
+        T* get(handle h) { return valid(h) ? to_object(h.index) : 0; }
+        const T* get(handle h) const { return valid(h) ? to_object(h.index) : 0; }
+
+        reference operator[](handle h) {
+          BOOST_ASSERT( valid(h) && "stale handle" );
+          return *to_object(h.index);
+        }
+        const_reference operator[](handle h) const {
+          BOOST_ASSERT( valid(h) && "stale handle" );
+          return *to_object(h.index);
+        }
+
+        reference at(handle h) { handlecheck(h); return *to_object(h.index); }
+        const_reference at(handle h) const { handlecheck(h); return *to_object(h.index); }
+
+        // handle of a live object of this pool
+        handle get_handle(const T* p) const {
+          size_type i = index_of(p);
+          BOOST_ASSERT( is_live(i) && "object is not live" );
+          return handle(i, m_generation[i]);
+        }
+
+        // iteration over the live objects in slot order
+        iterator        begin()       { return iterator(this, first_live(0)); }
+        const_iterator  begin() const { return const_iterator(this, first_live(0)); }
+        const_iterator cbegin() const { return begin(); }
+        iterator        end()       { return iterator(this, N); }
+        const_iterator  end() const { return const_iterator(this, N); }
+        const_iterator cend() const { return end(); }
+
+        // destroy every live object, outstanding handles become stale
+        void clear(){
+          for(size_type i = 0; i < N; ++i){
+            if(is_live(i)){
+              release(i);
+            }
+          }
+        }
+
+        size_type size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        bool full() const { return m_size == N; }
+        static size_type capacity() { return N; }
+        static size_type max_size() { return N; }
+
+      private:
+        template<typename Pool> friend class detail::pool_iterator;
+
+        bool is_live(std::size_t i) const { return (m_generation[i] & 1) != 0; }
+        std::size_t first_live(std::size_t i) const {
+          while(i < N && !is_live(i)) ++i;
+          return i;
+        }
+        T* to_object(std::size_t i) { return reinterpret_cast<T*>(&elems[i]); }
+        const T* to_object(std::size_t i) const { return reinterpret_cast<const T*>(&elems[i]); }
+
+        size_type& next_free(size_type i) { return *reinterpret_cast<size_type*>(&elems[i]); }
+
+        size_type index_of(const T* p) const {
+          std::size_t i = reinterpret_cast<const aligned_storage*>(p) - elems;
+          BOOST_ASSERT( i < N && "object is not part of this pool" );
+          return size_type(i);
+        }
+
+        void release(size_type i){
+          to_object(i)->~T();
+          ++m_generation[i];
+          next_free(i) = m_free;
+          m_free = i;
+          --m_size;
+        }
+
+        static void capacitycheck(std::size_t i){
+          if(i > N){
+            std::out_of_range e("StaticPool<>: out of capacity");
+            BOOST_THROW_EXCEPTION(e);
+          }
+        }
+
+        void handlecheck(handle h) const {
+          if(!valid(h)){
+            std::out_of_range e("StaticPool<>: stale handle");
+            BOOST_THROW_EXCEPTION(e);
+          }
+        }
+    };
+
+  namespace detail {
+        // forward iterator over the live objects of a StaticPool
+        template<typename Pool>
+        class pool_iterator
+          : public boost::iterator_facade< pool_iterator<Pool>,
+                                           typename boost::mpl::if_c< boost::is_const<Pool>::value,
+                                                                      const typename Pool::value_type,
+                                                                      typename Pool::value_type >::type,
+                                           boost::forward_traversal_tag >
+        {
+            typedef typename boost::mpl::if_c< boost::is_const<Pool>::value,
+                                               const typename Pool::value_type,
+                                               typename Pool::value_type >::type element_type;
+          public:
+            pool_iterator():m_pool(0),m_index(0){}
+            pool_iterator(Pool* pool, std::size_t index):m_pool(pool),m_index(index){}
+
+            // iterator to const_iterator conversion
+            template<typename Other>
+            pool_iterator(const pool_iterator<Other>& rhs):m_pool(rhs.pool()),m_index(rhs.index()){}
+
+            Pool* pool() const { return m_pool; }
+            std::size_t index() const { return m_index; }
+
+          private:
+            friend class boost::iterator_core_access;
+
+            element_type& dereference() const { return *m_pool->to_object(m_index); }
+            template<typename Other>
+            bool equal(const pool_iterator<Other>& rhs) const { return m_index == rhs.index(); }
+            void increment() { m_index = m_pool->first_live(m_index + 1); }
+
+            Pool* m_pool;
+            std::size_t m_index;
+        };
+  } // namespace detail
+
+  namespace detail {
+        // ::operator new for requests that do not fit an arena, honouring alignments above the default
+        inline void* arena_operator_new(std::size_t n, std::size_t align){
+#if defined(__cpp_aligned_new)
+          if(align > __STDCPP_DEFAULT_NEW_ALIGNMENT__){
+            return ::operator new(n, std::align_val_t(align));
+          }
+#endif
+          (void)align;
+          return ::operator new(n);
+        }
+
+        inline void arena_operator_delete(void* p, std::size_t align){
+#if defined(__cpp_aligned_new)
+          if(align > __STDCPP_DEFAULT_NEW_ALIGNMENT__){
+            ::operator delete(p, std::align_val_t(align));
+            return;
+          }
+#endif
+          (void)align;
+          ::operator delete(p);
+        }
+  } // namespace detail
+
+    // inline buffer of Bytes bytes handing out memory with a bump pointer
+    template<std::size_t Bytes, std::size_t Alignment = boost::alignment_of<std::max_align_t>::value>
+    class StaticArena : private boost::noncopyable {
+      public:
+        enum { static_size = Bytes };
+        enum { alignment = Alignment };
+
+        StaticArena():m_ptr(buffer()){}
+
+        // n bytes aligned to align, from the buffer if they fit and align is at most Alignment,
+        // otherwise from ::operator new with the same alignment
+        void* allocate(std::size_t n, std::size_t align = Alignment){
+          std::size_t offset = m_ptr - buffer();
+          std::size_t start = (offset + align - 1) / align * align;
+          if(align <= Alignment && start <= Bytes && n <= Bytes - start){
+            m_ptr = buffer() + start + n;
+            return buffer() + start;
+          }
+          return detail::arena_operator_new(n, align);
+        }
+
+        // give back memory from allocate with the same n and align, the buffer only takes back the most recent allocation
+        void deallocate(void* p, std::size_t n, std::size_t align = Alignment){
+          char* c = static_cast<char*>(p);
+          if(contains(p)){
+            if(c + n == m_ptr){
+              m_ptr = c;
+            }
+          } else {
+            detail::arena_operator_delete(p, align);
+          }
+        }
+
+        // true if p points into the inline buffer
+        bool contains(const void* p) const {
+          const char* c = static_cast<const char*>(p);
+          return buffer() <= c && c < buffer() + Bytes;
+        }
+
+        // forget all allocations from the buffer, memory from ::operator new is unaffected
+        void reset() { m_ptr = buffer(); }
+
+        std::size_t used() const { return m_ptr - buffer(); }
+        static std::size_t capacity() { return Bytes; }
+
+      private:
+        char* buffer() { return reinterpret_cast<char*>(&m_buffer); }
+        const char* buffer() const { return reinterpret_cast<const char*>(&m_buffer); }
+
+        typename boost::aligned_storage<Bytes, Alignment>::type m_buffer;
+        char* m_ptr;
+    };
+
+    // standard allocator taking its memory from a StaticArena<Bytes>
+    template<class T, std::size_t Bytes>
+    class StaticArenaAllocator {
+#if !defined(__cpp_aligned_new)
+        // without aligned ::operator new the fallback only guarantees the default alignment
+        BOOST_STATIC_ASSERT(boost::alignment_of<T>::value <= boost::alignment_of<std::max_align_t>::value);
+#endif
+      public:
+        typedef T                                              value_type;
+        typedef StaticArena<Bytes>                             arena_type;
+
+        template<class U>
+        struct rebind { typedef StaticArenaAllocator<U, Bytes> other; };
+
+        // an assigned-to container keeps using the arena it was built with and copies or moves the
+        // elements into it, like std::pmr; swapping containers on different arenas is undefined
+        typedef std::false_type propagate_on_container_copy_assignment;
+        typedef std::false_type propagate_on_container_move_assignment;
+        typedef std::false_type propagate_on_container_swap;
+
+        explicit StaticArenaAllocator(arena_type& arena):m_arena(&arena){}
+
+        template<class U>
+        StaticArenaAllocator(const StaticArenaAllocator<U, Bytes>& rhs):m_arena(&rhs.arena()){}
+
+        T* allocate(std::size_t n){
+          if(n > std::size_t(-1) / sizeof(T)){
+            std::bad_alloc e;
+            BOOST_THROW_EXCEPTION(e);
+          }
+          return static_cast<T*>(m_arena->allocate(n * sizeof(T), boost::alignment_of<T>::value));
+        }
+
+        void deallocate(T* p, std::size_t n){
+          m_arena->deallocate(p, n * sizeof(T), boost::alignment_of<T>::value);
+        }
+
+        arena_type& arena() const { return *m_arena; }
+
+      private:
+        arena_type* m_arena;
+    };
+
+    template<class T, class U, std::size_t Bytes>
+    bool operator== (const StaticArenaAllocator<T,Bytes>& x, const StaticArenaAllocator<U,Bytes>& y) {
+        return &x.arena() == &y.arena();
+    }
+    template<class T, class U, std::size_t Bytes>
+    bool operator!= (const StaticArenaAllocator<T,Bytes>& x, const StaticArenaAllocator<U,Bytes>& y) {
+        return !(x == y);
+    }
+
+} // namespace boost
+
+#endif /* BOOST_STATIC_POOL_HPP */
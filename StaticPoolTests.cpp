@@ -0,0 +1,159 @@
+/**
+ *  @file   StaticPoolTests.cpp
+ *  @brief  StaticPoolTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticPool and StaticArena are not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <StaticPool.hpp>
+#include <map>
+#include <string>
+#include <vector>
+using namespace boost;
+
+#define POOL_SIZE 5
+
+BOOST_AUTO_TEST_CASE(PoolAllocateDeallocate){
+  typedef StaticPool<std::string,POOL_SIZE> Pool;
+  Pool pool;
+  std::vector<Pool::handle> handles;
+  for(std::size_t i = 0; i < POOL_SIZE; i++){
+    handles.push_back(pool.allocate(i+1,'x'));
+  }
+  BOOST_CHECK(pool.full());
+  BOOST_CHECK_THROW(pool.allocate(),std::out_of_range);
+  
+  std::string* third = &pool[handles[2]];
+  BOOST_CHECK(pool.deallocate(handles[1]));
+  BOOST_CHECK(pool.deallocate(handles[3]));
+  BOOST_CHECK_EQUAL(pool.size(),3);
+  
+  // slots are reused last freed first, objects that stay live do not move
+  Pool::handle reused = pool.allocate("reused");
+  BOOST_CHECK_EQUAL(reused.index,handles[3].index);
+  BOOST_CHECK(&pool[handles[2]] == third);
+  BOOST_CHECK_EQUAL(*third,"xxx");
+  BOOST_CHECK(pool.get_handle(third) == handles[2]);
+  
+  pool.deallocate(third);
+  BOOST_CHECK_EQUAL(pool.size(),3);
+}
+
+BOOST_AUTO_TEST_CASE(PoolStaleHandles){
+  StaticPool<int,POOL_SIZE> pool;
+  StaticPool<int,POOL_SIZE>::handle h = pool.allocate(1);
+  BOOST_CHECK(pool.valid(h));
+  BOOST_CHECK(pool.deallocate(h));
+  BOOST_CHECK(!pool.valid(h));
+  BOOST_CHECK(!pool.deallocate(h));
+  BOOST_CHECK(pool.get(h) == 0);
+  BOOST_CHECK_THROW(pool.at(h),std::out_of_range);
+  
+  // the same slot holding a new object does not revive the old handle
+  StaticPool<int,POOL_SIZE>::handle again = pool.allocate(2);
+  BOOST_CHECK_EQUAL(again.index,h.index);
+  BOOST_CHECK(again != h);
+  BOOST_CHECK(pool.get(h) == 0);
+  BOOST_CHECK_EQUAL(pool.at(again),2);
+  BOOST_CHECK(!pool.valid(StaticPool<int,POOL_SIZE>::handle()));
+}
+
+BOOST_AUTO_TEST_CASE(PoolIteration){
+  typedef StaticPool<char,POOL_SIZE> Pool;
+  Pool pool;
+  BOOST_CHECK(pool.begin() == pool.end());
+  std::vector<Pool::handle> handles;
+  for(char c = 'a'; c < 'a'+POOL_SIZE; c++){
+    handles.push_back(pool.allocate(c));
+  }
+  pool.deallocate(handles[0]);
+  pool.deallocate(handles[2]);
+  pool.deallocate(handles[4]);
+  std::string live;
+  const Pool& cpool = pool;
+  for(Pool::const_iterator it = cpool.begin(); it != cpool.end(); ++it){
+    live += *it;
+  }
+  BOOST_CHECK_EQUAL(live,"bd");
+  for(Pool::iterator it = pool.begin(); it != pool.end(); ++it){
+    *it = 'z';
+  }
+  BOOST_CHECK_EQUAL(pool[handles[3]],'z');
+  pool.clear();
+  BOOST_CHECK(pool.empty());
+  BOOST_CHECK(!pool.valid(handles[1]));
+}
+
+BOOST_AUTO_TEST_CASE(ArenaAllocatorContainers){
+  typedef StaticArena<4096> Arena;
+  Arena arena;
+  {
+    std::vector<int,StaticArenaAllocator<int,4096> > vec((StaticArenaAllocator<int,4096>(arena)));
+    vec.reserve(64);
+    for(int i = 0; i < 64; i++){
+      vec.push_back(i);
+    }
+    BOOST_CHECK(arena.contains(vec.data()));
+    std::size_t used = arena.used();
+    vec.clear();
+    vec.shrink_to_fit();
+    // the most recent allocation goes back to the arena
+    BOOST_CHECK_LT(arena.used(),used);
+  }
+  
+  typedef std::map<int,int,std::less<int>,StaticArenaAllocator<std::pair<const int,int>,4096> > Map;
+  Map map((Map::allocator_type(arena)));
+  for(int i = 0; i < 32; i++){
+    map[i] = i*i;
+  }
+  BOOST_CHECK(arena.contains(&*map.find(31)));
+  BOOST_CHECK_EQUAL(map[7],49);
+  
+  // requests that no longer fit come from the heap
+  std::vector<char,StaticArenaAllocator<char,4096> > big(8192,'x',StaticArenaAllocator<char,4096>(arena));
+  BOOST_CHECK(!arena.contains(big.data()));
+  BOOST_CHECK((map.get_allocator() == StaticArenaAllocator<char,4096>(arena)));
+}
+
+// before C++17 the arena allocator only accepts types with at most the default alignment
+#if defined(__cpp_aligned_new)
+struct alignas(64) CacheLine {
+  char bytes[64];
+};
+
+BOOST_AUTO_TEST_CASE(ArenaAllocatorOverAligned){
+  StaticArena<256> arena;
+  StaticArenaAllocator<CacheLine,256> alloc(arena);
+  // more than the arena alignment, so it comes from the heap with the alignment of CacheLine
+  CacheLine* line = alloc.allocate(2);
+  BOOST_CHECK(!arena.contains(line));
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::size_t>(line) % 64,0u);
+  alloc.deallocate(line,2);
+
+  std::vector<CacheLine,StaticArenaAllocator<CacheLine,256> > lines(8,CacheLine(),alloc);
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::size_t>(lines.data()) % 64,0u);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(ArenaAllocatorDoesNotPropagate){
+  typedef StaticArenaAllocator<int,1024> Alloc;
+  StaticArena<1024> first;
+  StaticArena<1024> second;
+  std::vector<int,Alloc> a(16,1,Alloc(first));
+  std::vector<int,Alloc> b((Alloc(second)));
+  b = a;
+  BOOST_CHECK(&b.get_allocator().arena() == &second);
+  BOOST_CHECK(second.contains(b.data()));
+  std::vector<int,Alloc> c((Alloc(second)));
+  c = std::move(a);
+  BOOST_CHECK(&c.get_allocator().arena() == &second);
+  BOOST_CHECK(second.contains(c.data()));
+  BOOST_CHECK_EQUAL(c.size(),16u);
+}
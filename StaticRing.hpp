@@ -0,0 +1,266 @@
+/**
+ * @file   StaticRing.hpp
+ * @brief  Fixed capacity circular queue with inline storage.
+ *
+ * StaticRing<T, N> stores up to N elements in an aligned_storage slot array,
+ * like StaticVector, and indexes it with the uint_value_t<N> sized integer
+ * type. The slot array is rounded up to a power of two so positions are
+ * computed with a mask, and head and tail count up freely, wrapping in their
+ * integer type; their difference is the number of elements.
+ *
+ * The Concurrency template parameter selects how head and tail are shared:
+ *
+ *   ring_spsc            one producer thread and one consumer thread, lock-free (default)
+ *   ring_unsynchronized  plain integers, for use as a circular buffer by a single thread
+ *
+ * In ring_spsc mode the producer owns tail and the consumer owns head. Each
+ * side keeps its index on its own cache line together with a cached copy of
+ * the other side's index, so the other index is only re-read with an acquire
+ * load when the queue looks full (or empty). Publishing an element, or a batch
+ * of them with push_n/pop_n, is a single release store.
+ *
+ * try_push/try_emplace/push_n may only be called by the producer,
+ * try_pop/pop_n/clear only by the consumer. size(), empty() and full() may be
+ * called by either side and are exact only when the other side is idle.
+ *
+ *  StaticRing is not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_RING_HPP
+#define BOOST_STATIC_RING_HPP
+
+#include "StaticVector.hpp"
+#include <boost/atomic.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/noncopyable.hpp>
+
+#ifndef BOOST_STATIC_RING_CACHE_LINE_SIZE
+#define BOOST_STATIC_RING_CACHE_LINE_SIZE 64
+#endif
+
+namespace boost {
+
+    // concurrency policies for StaticRing
+
+    // single producer, single consumer, indices are atomics published with release stores
+    struct ring_spsc {
+        template<class Index>
+        class index {
+          public:
+            index():m_value(0){}
+            Index load_relaxed() const { return m_value.load(boost::memory_order_relaxed); }
+            Index load_acquire() const { return m_value.load(boost::memory_order_acquire); }
+            void store_release(Index value) { m_value.store(value, boost::memory_order_release); }
+          private:
+            boost::atomic<Index> m_value;
+        };
+    };
+
+    // no synchronization, the ring is used from one thread only
+    struct ring_unsynchronized {
+        template<class Index>
+        class index {
+          public:
+            index():m_value(0){}
+            Index load_relaxed() const { return m_value; }
+            Index load_acquire() const { return m_value; }
+            void store_release(Index value) { m_value = value; }
+          private:
+            Index m_value;
+        };
+    };
+
+  namespace detail {
+        // smallest power of two >= N
+        template<std::size_t N, std::size_t P = 1, bool Done = (P >= N)>
+        struct ring_slot_count {
+            static const std::size_t value = ring_slot_count<N, P * 2>::value;
+        };
+        template<std::size_t N, std::size_t P>
+        struct ring_slot_count<N, P, true> {
+            static const std::size_t value = P;
+        };
+  } // namespace detail
+
+    template<class T, std::size_t N, class Concurrency = ring_spsc>
+    class StaticRing : private boost::noncopyable {
+        BOOST_STATIC_ASSERT(N > 0);
+      public:
+        // type definitions
+        typedef T                                              value_type;
+        typedef T&                                             reference;
+        typedef const T&                                       const_reference;
+        typedef typename boost::uint_value_t<N>::least         size_type;
+
+        enum { static_size = N };
+        enum { slot_count = detail::ring_slot_count<N>::value };
+
+      private:
+        typedef typename boost::aligned_storage<
+                           sizeof(T),
+                           boost::alignment_of<T>::value
+                         >::type aligned_storage;
+        typedef typename Concurrency::template index<size_type> index_type;
+
+        // head and tail wrap in size_type, which can hold slot_count, so masking
+        // the running index with slot_count-1 gives the slot
+        BOOST_STATIC_ASSERT(slot_count - 1 <= size_type(~size_type(0)));
+
+        // written by the consumer
+        struct BOOST_ALIGNMENT(BOOST_STATIC_RING_CACHE_LINE_SIZE) consumer_side {
+            consumer_side():cached_tail(0){}
+            index_type head;
+            size_type  cached_tail;
+        };
+
+        // written by the producer
+        struct BOOST_ALIGNMENT(BOOST_STATIC_RING_CACHE_LINE_SIZE) producer_side {
+            producer_side():cached_head(0){}
+            index_type tail;
+            size_type  cached_head;
+        };
+
+        consumer_side m_consumer;
+        producer_side m_producer;
+        aligned_storage elems[slot_count]; // slot_count memory aligned elements of type T
+
+      public:
+
+        StaticRing(){}
+
+        ~StaticRing(){
+          clear();
+        }
+
+        // ---------- producer -------------------------
+
+        // append a copy of x, false if the ring is full
+        bool try_push(const T& x){
+          return try_emplace(x);
+        }
+
+        bool try_push(BOOST_RV_REF(T) x){
+          return try_emplace(boost::move(x));
+        }
+
+        template<class... Args>
+        bool try_emplace(Args&&... args){
+          size_type tail = m_producer.tail.load_relaxed();
+          if(free_slots(tail) == 0){
+            return false;
+          }
+          new (slot(tail)) T(boost::forward<Args>(args)...);
+          m_producer.tail.store_release(size_type(tail + 1));
+          return true;
+        }
+
+        // append up to n elements starting at first, returns the number appended
+        template<class InputIterator>
+        std::size_t push_n(InputIterator first, std::size_t n){
+          size_type tail = m_producer.tail.load_relaxed();
+          std::size_t count = (std::min)(n, free_slots(tail, n));
+          std::size_t i = 0;
+          BOOST_TRY {
+            for(; i < count; ++i, ++first){
+              new (slot(size_type(tail + i))) T(*first);
+            }
+          } BOOST_CATCH(...) {
+            destroy(tail, size_type(tail + i));
+            BOOST_RETHROW;
+          }
+          BOOST_CATCH_END
+          m_producer.tail.store_release(size_type(tail + count));
+          return count;
+        }
+
+        // ---------- consumer -------------------------
+
+        // move the oldest element into x and remove it, false if the ring is empty
+        bool try_pop(T& x){
+          size_type head = m_consumer.head.load_relaxed();
+          if(used_slots(head) == 0){
+            return false;
+          }
+          T* p = slot(head);
+          x = boost::move(*p);
+          p->~T();
+          m_consumer.head.store_release(size_type(head + 1));
+          return true;
+        }
+
+        // move up to n of the oldest elements to result and remove them, returns the number removed
+        template<class OutputIterator>
+        std::size_t pop_n(OutputIterator result, std::size_t n){
+          size_type head = m_consumer.head.load_relaxed();
+          std::size_t count = (std::min)(n, used_slots(head, n));
+          for(std::size_t i = 0; i < count; ++i, ++result){
+            T* p = slot(size_type(head + i));
+            *result = boost::move(*p);
+            p->~T();
+          }
+          m_consumer.head.store_release(size_type(head + count));
+          return count;
+        }
+
+        // remove all elements currently visible to the consumer
+        void clear(){
+          size_type head = m_consumer.head.load_relaxed();
+          size_type tail = m_producer.tail.load_acquire();
+          destroy(head, tail);
+          m_consumer.cached_tail = tail;
+          m_consumer.head.store_release(tail);
+        }
+
+        // ---------- either side -------------------------
+
+        std::size_t size() const {
+          return size_type(m_producer.tail.load_acquire() - m_consumer.head.load_acquire());
+        }
+        bool empty() const { return size() == 0; }
+        bool full() const { return size() == N; }
+
+        static std::size_t capacity() { return N; }
+        static std::size_t max_size() { return N; }
+
+      private:
+
+        T* slot(size_type index){
+          return reinterpret_cast<T*>(&elems[index & (slot_count - 1)]);
+        }
+
+        // producer side, only reloads head when the cached copy has fewer than wanted free slots
+        std::size_t free_slots(size_type tail, std::size_t wanted = 1){
+          std::size_t available = N - size_type(tail - m_producer.cached_head);
+          if(available < wanted){
+            m_producer.cached_head = m_consumer.head.load_acquire();
+            available = N - size_type(tail - m_producer.cached_head);
+          }
+          return available;
+        }
+
+        // consumer side, only reloads tail when the cached copy has fewer than wanted elements
+        std::size_t used_slots(size_type head, std::size_t wanted = 1){
+          std::size_t available = size_type(m_consumer.cached_tail - head);
+          if(available < wanted){
+            m_consumer.cached_tail = m_producer.tail.load_acquire();
+            available = size_type(m_consumer.cached_tail - head);
+          }
+          return available;
+        }
+
+        void destroy(size_type first, size_type last){
+          if(!boost::has_trivial_destructor<T>::value){
+            for(; first != last; ++first){
+              slot(first)->~T();
+            }
+          }
+        }
+    };
+
+} // namespace boost
+
+#endif /* BOOST_STATIC_RING_HPP */
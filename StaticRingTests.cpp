@@ -0,0 +1,129 @@
+/**
+ *  @file   StaticRingTests.cpp
+ *  @brief  StaticRingTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticRing is not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <boost/thread/thread.hpp>
+#include <StaticRing.hpp>
+#include <string>
+#include <vector>
+using namespace boost;
+
+#define RING_SIZE 5
+
+BOOST_AUTO_TEST_CASE(RingFifoAndWrapAround){
+  StaticRing<std::size_t,RING_SIZE> ring;
+  BOOST_CHECK_EQUAL(static_cast<std::size_t>(ring.slot_count),8u);
+  BOOST_CHECK(ring.empty());
+  std::size_t next = 0;
+  std::size_t expected = 0;
+  // cycle through the slots many times so head and tail wrap in their 8 bit index type
+  for(int round = 0; round < 200; round++){
+    while(ring.try_push(next)){
+      next++;
+    }
+    BOOST_CHECK(ring.full());
+    BOOST_CHECK_EQUAL(ring.size(),RING_SIZE);
+    std::size_t value = 0;
+    for(int i = 0; i < 3; i++){
+      BOOST_REQUIRE(ring.try_pop(value));
+      BOOST_CHECK_EQUAL(value,expected++);
+    }
+  }
+  std::size_t value = 0;
+  while(ring.try_pop(value)){
+    BOOST_CHECK_EQUAL(value,expected++);
+  }
+  BOOST_CHECK_EQUAL(expected,next);
+  BOOST_CHECK(ring.empty());
+}
+
+BOOST_AUTO_TEST_CASE(RingBatch){
+  StaticRing<int,RING_SIZE,ring_unsynchronized> ring;
+  int input[] = {0,1,2,3,4,5,6};
+  BOOST_CHECK_EQUAL(ring.push_n(input,3),3u);
+  std::vector<int> output;
+  BOOST_CHECK_EQUAL(ring.pop_n(std::back_inserter(output),2),2u);
+  // crosses the end of the slot array
+  BOOST_CHECK_EQUAL(ring.push_n(input+3,4),4u);
+  BOOST_CHECK(ring.full());
+  BOOST_CHECK_EQUAL(ring.push_n(input,1),0u);
+  BOOST_CHECK_EQUAL(ring.pop_n(std::back_inserter(output),10),5u);
+  BOOST_CHECK_EQUAL(output.size(),7u);
+  for(int i = 0; i < 7; i++){
+    BOOST_CHECK_EQUAL(output[i],i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RingNonTrivialElements){
+  StaticRing<std::string,RING_SIZE> ring;
+  BOOST_CHECK(ring.try_push(std::string("a fairly long string that is heap allocated")));
+  BOOST_CHECK(ring.try_emplace(3,'x'));
+  std::string value;
+  BOOST_CHECK(ring.try_pop(value));
+  BOOST_CHECK_EQUAL(value,"a fairly long string that is heap allocated");
+  BOOST_CHECK(ring.try_push(value));
+  BOOST_CHECK_EQUAL(ring.size(),2u);
+  ring.clear();
+  BOOST_CHECK(ring.empty());
+  BOOST_CHECK(ring.try_push("left for the destructor"));
+}
+
+namespace {
+  const std::size_t transfer_count = 200000;
+
+  template<class Ring>
+  void produce(Ring* ring, bool batched){
+    std::size_t next = 0;
+    std::size_t batch[7];
+    while(next < transfer_count){
+      if(batched){
+        std::size_t n = (std::min)(transfer_count - next, std::size_t(7));
+        for(std::size_t i = 0; i < n; i++){
+          batch[i] = next + i;
+        }
+        std::size_t pushed = ring->push_n(batch,n);
+        next += pushed;
+        if(!pushed){
+          boost::this_thread::yield();
+        }
+      } else if(ring->try_push(next)){
+        next++;
+      } else {
+        boost::this_thread::yield();
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RingSpscThreads){
+  for(int batched = 0; batched < 2; batched++){
+    StaticRing<std::size_t,64> ring;
+    boost::thread producer(&produce<StaticRing<std::size_t,64> >,&ring,batched != 0);
+    std::size_t expected = 0;
+    bool ordered = true;
+    std::size_t batch[5];
+    while(expected < transfer_count){
+      std::size_t n = ring.pop_n(batch,5);
+      if(!n){
+        boost::this_thread::yield();
+      }
+      for(std::size_t i = 0; i < n; i++){
+        ordered = ordered && batch[i] == expected;
+        expected++;
+      }
+    }
+    producer.join();
+    BOOST_CHECK(ordered);
+    BOOST_CHECK(ring.empty());
+  }
+}
@@ -0,0 +1,223 @@
+/**
+ * @file   StaticSlotMap.hpp
+ * @brief  Fixed capacity slot map with dense storage and stable handles.
+ *
+ * StaticSlotMap<T, N> keeps its values packed at the front of a
+ * StaticVector<T, N>, so iteration is a plain walk over contiguous memory.
+ * insert() returns a handle of slot index and generation like StaticPool.
+ * The slot maps through an indirection table to the current dense index of
+ * the value, and erase() moves the last value into the hole and updates the
+ * slot of the moved value, so both insert and erase are O(1) and handles
+ * stay valid while other values come and go.
+ *
+ * The generation of a slot is odd while it refers to a value and is
+ * incremented on every insert and erase, so a handle kept after its value
+ * was erased is detected: get() returns 0, at() throws and erase() returns
+ * false. Free slots are chained through the indirection table.
+ *
+ * Iteration order is the dense order, which changes on erase. Iterators,
+ * references and pointers to values are invalidated by erase, handles are not.
+ *
+ *  StaticSlotMap is not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_SLOT_MAP_HPP
+#define BOOST_STATIC_SLOT_MAP_HPP
+
+#include "StaticVector.hpp"
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <cstddef>
+
+namespace boost {
+
+    template<class T, std::size_t N>
+    class StaticSlotMap {
+        BOOST_STATIC_ASSERT(N > 0);
+      public:
+        // type definitions
+        typedef T                                              value_type;
+        typedef T*                                             pointer;
+        typedef const T*                                       const_pointer;
+        typedef T&                                             reference;
+        typedef const T&                                       const_reference;
+        typedef typename boost::uint_value_t<N>::least         size_type;
+        typedef boost::uint32_t                                generation_type;
+        typedef StaticVector<T,N>                              storage_type;
+        typedef typename storage_type::iterator                iterator;
+        typedef typename storage_type::const_iterator          const_iterator;
+        typedef typename storage_type::reverse_iterator        reverse_iterator;
+        typedef typename storage_type::const_reverse_iterator  const_reverse_iterator;
+
+        // identifies one value for its whole lifetime, a default constructed handle is never valid
+        struct handle {
+            handle():index(0),generation(0){}
+            handle(size_type i, generation_type g):index(i),generation(g){}
+            bool operator==(const handle& rhs) const { return index == rhs.index && generation == rhs.generation; }
+            bool operator!=(const handle& rhs) const { return !(*this == rhs); }
+            size_type       index;
+            generation_type generation;
+        };
+
+        enum { static_size = N };
+
+      private:
+        storage_type    m_values;           // the values, densely packed
+        size_type       m_slot[N];          // slot of the value at each dense index
+        size_type       m_index[N];         // dense index of a live slot, next free slot of a free one
+        generation_type m_generation[N];    // odd while the slot refers to a value
+        size_type       m_free;             // first free slot, or N if there is none
+
+      public:
+
+        StaticSlotMap():m_free(0){
+          for(size_type i = 0; i < N; ++i){
+            m_generation[i] = 0;
+            m_index[i] = size_type(i + 1);
+          }
+        }
+
+        // construct a value from args at the end of the dense storage, throws std::out_of_range if the map is full
+        template<class... Args>
+        handle emplace(Args&&... args){
+          capacitycheck(size()+1);
+          size_type i = m_free;
+          size_type dense = size();
+          m_values.emplace_back(boost::forward<Args>(args)...);
+          m_free = m_index[i];
+          m_index[i] = dense;
+          m_slot[dense] = i;
+          return handle(i, ++m_generation[i]);
+        }
+
+        handle insert(const T& x){ return emplace(x); }
+        handle insert(BOOST_RV_REF(T) x){ return emplace(boost::move(x)); }
+
+        // erase the value of h by moving the last value into its place, false if h is stale or invalid
+        bool erase(handle h){
+          if(!valid(h)){
+            return false;
+          }
+          release(m_index[h.index]);
+          return true;
+        }
+
+        // erase the value at pos, the returned iterator refers to the value moved into its place
+        iterator erase(const_iterator pos){
+          size_type dense = size_type(pos - m_values.cbegin());
+          BOOST_ASSERT( dense < size() && "iterator out of range" );
+          release(dense);
+          return m_values.begin() + dense;
+        }
+
+        bool valid(handle h) const {
+          return h.index < N && (h.generation & 1) && m_generation[h.index] == h.generation;
+        }
+
+        // the value of h, or 0 if h is stale or invalid
+        T* get(handle h) { return valid(h) ? &m_values[m_index[h.index]] : 0; }
+        const T* get(handle h) const { return valid(h) ? &m_values[m_index[h.index]] : 0; }
+
+        reference operator[](handle h) {
+          BOOST_ASSERT( valid(h) && "stale handle" );
+          return m_values[m_index[h.index]];
+        }
+        const_reference operator[](handle h) const {
+          BOOST_ASSERT( valid(h) && "stale handle" );
+          return m_values[m_index[h.index]];
+        }
+
+        reference at(handle h) { handlecheck(h); return m_values[m_index[h.index]]; }
+        const_reference at(handle h) const { handlecheck(h); return m_values[m_index[h.index]]; }
+
+        // current dense index of the value of h, which must be valid
+        size_type index_of(handle h) const {
+          BOOST_ASSERT( valid(h) && "stale handle" );
+          return m_index[h.index];
+        }
+
+        // handle of the value at dense index i
+        handle handle_of(size_type i) const {
+          BOOST_ASSERT( i < size() && "index out of range" );
+          size_type slot = m_slot[i];
+          return handle(slot, m_generation[slot]);
+        }
+        handle handle_of(const_iterator pos) const {
+          return handle_of(size_type(pos - m_values.cbegin()));
+        }
+
+        // iteration over the values in dense order
+        iterator        begin()       { return m_values.begin(); }
+        const_iterator  begin() const { return m_values.begin(); }
+        const_iterator cbegin() const { return m_values.cbegin(); }
+        iterator        end()       { return m_values.end(); }
+        const_iterator  end() const { return m_values.end(); }
+        const_iterator cend() const { return m_values.cend(); }
+
+        reverse_iterator rbegin() { return m_values.rbegin(); }
+        const_reverse_iterator rbegin() const { return m_values.rbegin(); }
+        reverse_iterator rend() { return m_values.rend(); }
+        const_reverse_iterator rend() const { return m_values.rend(); }
+
+        T* data() { return m_values.data(); }
+        const T* data() const { return m_values.data(); }
+
+        // the dense storage, for algorithms over all values
+        const storage_type& values() const { return m_values; }
+
+        // erase every value, outstanding handles become stale
+        void clear(){
+          for(size_type d = 0; d < size(); ++d){
+            size_type slot = m_slot[d];
+            ++m_generation[slot];
+            m_index[slot] = m_free;
+            m_free = slot;
+          }
+          m_values.clear();
+        }
+
+        size_type size() const { return size_type(m_values.size()); }
+        bool empty() const { return m_values.empty(); }
+        bool full() const { return m_values.full(); }
+        static size_type capacity() { return N; }
+        static size_type max_size() { return N; }
+
+      private:
+        // erase the value at dense index dense and free its slot
+        void release(size_type dense){
+          size_type slot = m_slot[dense];
+          size_type last = size_type(size() - 1);
+          if(dense != last){
+            m_values[dense] = boost::move(m_values[last]);
+            size_type moved = m_slot[last];
+            m_slot[dense] = moved;
+            m_index[moved] = dense;
+          }
+          m_values.pop_back();
+          ++m_generation[slot];
+          m_index[slot] = m_free;
+          m_free = slot;
+        }
+
+        static void capacitycheck(std::size_t i){
+          if(i > N){
+            std::out_of_range e("StaticSlotMap<>: out of capacity");
+            BOOST_THROW_EXCEPTION(e);
+          }
+        }
+
+        void handlecheck(handle h) const {
+          if(!valid(h)){
+            std::out_of_range e("StaticSlotMap<>: stale handle");
+            BOOST_THROW_EXCEPTION(e);
+          }
+        }
+    };
+
+} // namespace boost
+
+#endif /* BOOST_STATIC_SLOT_MAP_HPP */
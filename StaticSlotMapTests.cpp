@@ -0,0 +1,118 @@
+/**
+ *  @file   StaticSlotMapTests.cpp
+ *  @brief  StaticSlotMapTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticSlotMap is not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <StaticSlotMap.hpp>
+#include <cstdlib>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+using namespace boost;
+
+#define SLOT_MAP_SIZE 5
+
+BOOST_AUTO_TEST_CASE(SlotMapEraseKeepsValuesDense){
+  typedef StaticSlotMap<std::string,SLOT_MAP_SIZE> Map;
+  Map map;
+  std::vector<Map::handle> handles;
+  for(std::size_t i = 0; i < SLOT_MAP_SIZE; i++){
+    handles.push_back(map.emplace(i+1,'x'));
+  }
+  BOOST_CHECK(map.full());
+  BOOST_CHECK_THROW(map.insert("more"),std::out_of_range);
+
+  // the last value moves into the hole, its handle follows it
+  BOOST_CHECK(map.erase(handles[1]));
+  BOOST_CHECK_EQUAL(map.size(),4);
+  BOOST_CHECK_EQUAL(map.begin()[1],"xxxxx");
+  BOOST_CHECK_EQUAL(map.index_of(handles[4]),1);
+  BOOST_CHECK(map.handle_of(1) == handles[4]);
+  BOOST_CHECK_EQUAL(map[handles[4]],"xxxxx");
+  BOOST_CHECK_EQUAL(map[handles[2]],"xxx");
+
+  // slots are reused last freed first
+  Map::handle reused = map.insert("reused");
+  BOOST_CHECK_EQUAL(reused.index,handles[1].index);
+  BOOST_CHECK(reused != handles[1]);
+  BOOST_CHECK_EQUAL(map.index_of(reused),4);
+
+  // erase while iterating, the returned iterator holds the value moved into place
+  for(Map::iterator it = map.begin(); it != map.end(); ){
+    if(it->size() % 2 == 1){
+      it = map.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  BOOST_CHECK_EQUAL(map.size(),2);
+  BOOST_CHECK(!map.valid(handles[0]));
+  BOOST_CHECK(!map.valid(handles[2]));
+  BOOST_CHECK_EQUAL(map.at(handles[3]),"xxxx");
+  BOOST_CHECK_EQUAL(map.at(reused),"reused");
+}
+
+BOOST_AUTO_TEST_CASE(SlotMapStaleHandles){
+  StaticSlotMap<int,SLOT_MAP_SIZE> map;
+  StaticSlotMap<int,SLOT_MAP_SIZE>::handle none;
+  BOOST_CHECK(!map.valid(none));
+  StaticSlotMap<int,SLOT_MAP_SIZE>::handle h = map.insert(1);
+  BOOST_CHECK(map.valid(h));
+  BOOST_CHECK(map.erase(h));
+  BOOST_CHECK(!map.valid(h));
+  BOOST_CHECK(!map.erase(h));
+  BOOST_CHECK(map.get(h) == 0);
+  BOOST_CHECK_THROW(map.at(h),std::out_of_range);
+
+  // the same slot holding a new value does not revive the old handle
+  StaticSlotMap<int,SLOT_MAP_SIZE>::handle again = map.insert(2);
+  BOOST_CHECK_EQUAL(again.index,h.index);
+  BOOST_CHECK(!map.valid(h));
+  BOOST_CHECK_EQUAL(*map.get(again),2);
+
+  map.insert(3);
+  map.clear();
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(!map.valid(again));
+  for(int i = 0; i < SLOT_MAP_SIZE; i++){
+    map.insert(i);
+  }
+  BOOST_CHECK_EQUAL(std::accumulate(map.begin(),map.end(),0),10);
+}
+
+BOOST_AUTO_TEST_CASE(SlotMapMatchesMap){
+  typedef StaticSlotMap<int,64> Map;
+  Map map;
+  std::map<int,Map::handle> expected;
+  std::vector<Map::handle> erased;
+  std::srand(11);
+  for(int step = 0; step < 3000; ++step){
+    if(std::rand() % 2 == 0 && !map.full()){
+      expected[step] = map.insert(step);
+    } else if(!expected.empty()){
+      std::map<int,Map::handle>::iterator it = expected.begin();
+      std::advance(it,std::rand() % expected.size());
+      BOOST_REQUIRE(map.erase(it->second));
+      erased.push_back(it->second);
+      expected.erase(it);
+    }
+    BOOST_REQUIRE_EQUAL(map.size(),expected.size());
+    for(std::map<int,Map::handle>::const_iterator it = expected.begin(); it != expected.end(); ++it){
+      BOOST_REQUIRE_EQUAL(map[it->second],it->first);
+      BOOST_REQUIRE(map.handle_of(map.index_of(it->second)) == it->second);
+    }
+  }
+  for(std::size_t i = 0; i < erased.size(); ++i){
+    BOOST_REQUIRE(!map.valid(erased[i]));
+  }
+}
@@ -0,0 +1,462 @@
+/**
+ * @file   StaticSoAVector.hpp
+ * @brief  Fixed capacity vector of records stored as one array per field.
+ *
+ * StaticSoAVector<N, Fields...> has the capacity and size semantics of
+ * StaticVector, but instead of one aligned_storage elems[N] array of whole
+ * records it keeps a separate aligned_storage array of N elements for every
+ * field. Scanning one field, e.g. every price, then only loads the bytes of that
+ * field and the loop can be vectorized over a plain contiguous array.
+ *
+ * Rows are accessed through proxy references, std::tuple<Fields&...>, so
+ *   std::get<1>(quotes[i]) = 10.5;
+ * writes the second field of row i, and get<1>(i) does the same without the
+ * tuple. column<I>() returns a boost::iterator_range over the live elements of
+ * field I.
+ *
+ * Inserting or erasing rows shifts every column, using memmove for relocatable
+ * field types (see boost::is_trivially_relocatable).
+ *
+ *  StaticSoAVector is not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_SOA_VECTOR_HPP
+#define BOOST_STATIC_SOA_VECTOR_HPP
+
+#include "StaticVector.hpp"
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_const.hpp>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+
+  namespace detail {
+        // C++11 stand-in for std::index_sequence, used to expand the fields of a row
+        template<std::size_t... I>
+        struct soa_index_sequence {};
+
+        template<std::size_t N, std::size_t... I>
+        struct soa_make_index_sequence : soa_make_index_sequence<N-1, N-1, I...> {};
+
+        template<std::size_t... I>
+        struct soa_make_index_sequence<0, I...> {
+            typedef soa_index_sequence<I...> type;
+        };
+
+        // true if every field type has a nothrow move constructor
+        template<class... Fields>
+        struct soa_nothrow_move_constructible : boost::true_type {};
+
+        template<class Field, class... Fields>
+        struct soa_nothrow_move_constructible<Field, Fields...>
+          : boost::integral_constant<bool, std::is_nothrow_move_constructible<Field>::value
+                                           && soa_nothrow_move_constructible<Fields...>::value> {};
+
+        // raw storage for one field of a StaticSoAVector
+        template<typename T, std::size_t N>
+        struct soa_column {
+            typedef typename boost::aligned_storage<
+                               sizeof(T),
+                               boost::alignment_of<T>::value
+                             >::type aligned_storage;
+
+            T* data() { return reinterpret_cast<T*>(elems); }
+            const T* data() const { return reinterpret_cast<const T*>(elems); }
+
+            void destroy(std::size_t first, std::size_t last){
+              if(!boost::has_trivial_destructor<T>::value){
+                for(T* p = data()+first; p != data()+last; ++p){
+                  p->~T();
+                }
+              }
+            }
+
+            // remove [first,last) from the size live elements, shifting the tail down
+            void erase(std::size_t first, std::size_t last, std::size_t size){
+              T* f = data()+first;
+              T* l = data()+last;
+              T* e = data()+size;
+              if(is_trivially_relocatable<T>::value){
+                destroy(first,last);
+                std::memmove(static_cast<void*>(f), static_cast<const void*>(l), sizeof(T)*(e-l));
+              } else {
+                T* new_end = boost::move(l,e,f);
+                destroy(new_end-data(),size);
+              }
+            }
+
+            // move the last of the size live elements to pos, shifting [pos,size-1) up by one
+            void rotate_last_to(std::size_t pos, std::size_t size){
+              T* p = data()+pos;
+              T* last = data()+size-1;
+              if(is_trivially_relocatable<T>::value){
+                aligned_storage tmp;
+                std::memcpy(static_cast<void*>(&tmp), static_cast<const void*>(last), sizeof(T));
+                std::memmove(static_cast<void*>(p+1), static_cast<const void*>(p), sizeof(T)*(last-p));
+                std::memcpy(static_cast<void*>(p), static_cast<const void*>(&tmp), sizeof(T));
+              } else {
+                std::rotate(p,last,last+1);
+              }
+            }
+
+            aligned_storage elems[N];
+        };
+
+        template<typename Vector>
+        class soa_row_iterator;
+  } // namespace detail
+
+    template<std::size_t N, class... Fields>
+    class StaticSoAVector {
+        BOOST_STATIC_ASSERT(sizeof...(Fields) > 0);
+      public:
+        // type definitions
+        typedef std::tuple<Fields...>                          value_type;
+        typedef std::tuple<Fields&...>                         reference;
+        typedef std::tuple<const Fields&...>                   const_reference;
+        typedef typename boost::uint_value_t<N>::least         size_type;
+        typedef std::ptrdiff_t                                 difference_type;
+        typedef detail::soa_row_iterator<StaticSoAVector>       iterator;
+        typedef detail::soa_row_iterator<const StaticSoAVector> const_iterator;
+
+        // type of field I
+        template<std::size_t I>
+        struct field {
+            typedef typename std::tuple_element<I,value_type>::type type;
+        };
+
+        // contiguous view over the live elements of field I
+        template<std::size_t I>
+        struct column_range {
+            typedef boost::iterator_range<typename field<I>::type*> type;
+            typedef boost::iterator_range<const typename field<I>::type*> const_type;
+        };
+
+        enum { field_count = sizeof...(Fields) };
+
+      private:
+        typedef std::tuple<detail::soa_column<Fields,N>...> columns_type;
+        typedef typename detail::soa_make_index_sequence<sizeof...(Fields)>::type field_indices;
+
+        size_type m_size;        // fastest type that can accomodate N
+        columns_type m_columns;  // one array of N memory aligned elements per field
+
+      public:
+
+        StaticSoAVector():m_size(0){}
+
+        // the destructor does not run for a partially constructed vector, so the rows built before a throw are destroyed here
+        StaticSoAVector(const StaticSoAVector& rhs):m_size(0){
+          BOOST_TRY {
+            for(size_type i = 0; i < rhs.size(); ++i){
+              push_back_row(rhs[i],field_indices());
+            }
+          } BOOST_CATCH(...) {
+            clear();
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+        }
+
+        // rhs keeps its size, but its elements are left in a moved-from state
+        StaticSoAVector(StaticSoAVector&& rhs)
+          BOOST_NOEXCEPT_IF(detail::soa_nothrow_move_constructible<Fields...>::value):m_size(0){
+          BOOST_TRY {
+            for(size_type i = 0; i < rhs.size(); ++i){
+              move_back_row(rhs,i,field_indices());
+            }
+          } BOOST_CATCH(...) {
+            clear();
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+        }
+
+        ~StaticSoAVector(){
+          clear();
+        }
+
+        StaticSoAVector& operator= (const StaticSoAVector& rhs) {
+            if(this != &rhs){
+              clear();
+              for(size_type i = 0; i < rhs.size(); ++i){
+                push_back_row(rhs[i],field_indices());
+              }
+            }
+            return *this;
+        }
+
+        StaticSoAVector& operator= (StaticSoAVector&& rhs)
+          BOOST_NOEXCEPT_IF(detail::soa_nothrow_move_constructible<Fields...>::value) {
+            if(this != &rhs){
+              clear();
+              for(size_type i = 0; i < rhs.size(); ++i){
+                move_back_row(rhs,i,field_indices());
+              }
+            }
+            return *this;
+        }
+
+        // iterator support, iterators dereference to row proxies
+        iterator        begin()       { return iterator(this,0); }
+        const_iterator  begin() const { return const_iterator(this,0); }
+        const_iterator cbegin() const { return const_iterator(this,0); }
+        iterator        end()       { return iterator(this,m_size); }
+        const_iterator  end() const { return const_iterator(this,m_size); }
+        const_iterator cend() const { return const_iterator(this,m_size); }
+
+        // append a row, one argument per field
+        template<class... Args>
+        void push_back(Args&&... args){
+          BOOST_STATIC_ASSERT(sizeof...(Args) == sizeof...(Fields));
+          capacitycheck(size()+1);
+          unchecked_push_back(boost::forward<Args>(args)...);
+        }
+
+        template<class... Args>
+        void unchecked_push_back(Args&&... args){
+          construct_row<0>(m_size,boost::forward<Args>(args)...);
+          m_size++;
+        }
+
+        // insert a row in front of pos, one argument per field
+        template<class... Args>
+        void insert(size_type pos, Args&&... args){
+          BOOST_ASSERT(pos <= size());
+          push_back(boost::forward<Args>(args)...);
+          rotate_last_to(pos,field_indices());
+        }
+
+        void pop_back(){
+          BOOST_ASSERT(!empty());
+          m_size--;
+          destroy_rows(m_size,m_size+1,field_indices());
+        }
+
+        void erase(size_type pos){
+          erase(pos,pos+1);
+        }
+
+        void erase(size_type first, size_type last){
+          BOOST_ASSERT(first <= last && last <= size());
+          erase_rows(first,last,field_indices());
+          m_size -= last-first;
+        }
+
+        void clear(){
+          destroy_rows(0,m_size,field_indices());
+          m_size = 0;
+        }
+
+        // grow with value initialized rows or shrink
+        void resize(size_type n){
+          capacitycheck(n);
+          while(size() < n){
+            construct_row<0>(m_size,Fields()...);
+            m_size++;
+          }
+          if(n < size()){
+            erase(n,size());
+          }
+        }
+
+        // row access through tuples of references
+        reference operator[](size_type i){
+          BOOST_ASSERT( i < size() && "StaticSoAVector<>: out of range" );
+          return row(i,field_indices());
+        }
+
+        const_reference operator[](size_type i) const {
+          BOOST_ASSERT( i < size() && "StaticSoAVector<>: out of range" );
+          return row(i,field_indices());
+        }
+
+        reference at(size_type i) { rangecheck(i); return (*this)[i]; }
+        const_reference at(size_type i) const { rangecheck(i); return (*this)[i]; }
+
+        reference front() { return (*this)[0]; }
+        const_reference front() const { return (*this)[0]; }
+        reference back() { return (*this)[size()-1]; }
+        const_reference back() const { return (*this)[size()-1]; }
+
+        // field I of row i
+        template<std::size_t I>
+        typename field<I>::type& get(size_type i){
+          BOOST_ASSERT( i < size() && "StaticSoAVector<>: out of range" );
+          return data<I>()[i];
+        }
+
+        template<std::size_t I>
+        const typename field<I>::type& get(size_type i) const {
+          BOOST_ASSERT( i < size() && "StaticSoAVector<>: out of range" );
+          return data<I>()[i];
+        }
+
+        // contiguous array holding field I of every row
+        template<std::size_t I>
+        typename field<I>::type* data(){ return std::get<I>(m_columns).data(); }
+
+        template<std::size_t I>
+        const typename field<I>::type* data() const { return std::get<I>(m_columns).data(); }
+
+        template<std::size_t I>
+        typename column_range<I>::type column(){
+          return typename column_range<I>::type(data<I>(),data<I>()+size());
+        }
+
+        template<std::size_t I>
+        typename column_range<I>::const_type column() const {
+          return typename column_range<I>::const_type(data<I>(),data<I>()+size());
+        }
+
+        // capacity is constant, size varies
+        inline size_type size() const { return m_size; }
+        inline static size_type capacity() { return N; }
+        bool empty() const { return size() == 0; }
+        bool full() const { return size() >= capacity(); }
+        static size_type max_size() { return N; }
+        enum { static_size = N };
+
+        void swap(StaticSoAVector& y){
+          StaticSoAVector tmp(boost::move(y));
+          y = boost::move(*this);
+          *this = boost::move(tmp);
+        }
+
+        // check range (may not be private because it is not static)
+        // throws on failure
+        // returns: 0 on success, 1 otherwise when exceptions are disabled
+        bool rangecheck (size_type i) const {
+          bool failure(i >= size());
+          if (failure) {
+              std::out_of_range e("StaticSoAVector<>: index out of range");
+              BOOST_THROW_EXCEPTION(e);
+          }
+          return failure;
+        }
+
+private:
+       // check capacity (may be private because it is static)
+       inline static bool capacitycheck (std::size_t i) {
+         bool failure(i > N);
+         if (failure) {
+            std::out_of_range e("StaticSoAVector<>: index out of capacity");
+            BOOST_THROW_EXCEPTION(e);
+         }
+         return failure;
+       }
+
+       template<std::size_t... I>
+       reference row(size_type i, detail::soa_index_sequence<I...>){
+          return reference(data<I>()[i]...);
+       }
+
+       template<std::size_t... I>
+       const_reference row(size_type i, detail::soa_index_sequence<I...>) const {
+          return const_reference(data<I>()[i]...);
+       }
+
+       // construct field I onwards of row i, destroying the fields already built if one throws
+       template<std::size_t I, class Arg, class... Args>
+       void construct_row(size_type i, Arg&& arg, Args&&... args){
+          typedef typename field<I>::type T;
+          new (data<I>()+i) T(boost::forward<Arg>(arg));
+          BOOST_TRY {
+            construct_row<I+1>(i,boost::forward<Args>(args)...);
+          } BOOST_CATCH(...) {
+            std::get<I>(m_columns).destroy(i,i+1);
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+       }
+
+       template<std::size_t I>
+       void construct_row(size_type){}
+
+       template<class Row, std::size_t... I>
+       void push_back_row(const Row& row, detail::soa_index_sequence<I...>){
+          unchecked_push_back(std::get<I>(row)...);
+       }
+
+       template<std::size_t... I>
+       void move_back_row(StaticSoAVector& rhs, size_type i, detail::soa_index_sequence<I...>){
+          unchecked_push_back(boost::move(rhs.template data<I>()[i])...);
+       }
+
+       template<std::size_t... I>
+       void destroy_rows(size_type first, size_type last, detail::soa_index_sequence<I...>){
+          int expand[] = { 0, (std::get<I>(m_columns).destroy(first,last), 0)... };
+          (void)expand;
+       }
+
+       template<std::size_t... I>
+       void erase_rows(size_type first, size_type last, detail::soa_index_sequence<I...>){
+          int expand[] = { 0, (std::get<I>(m_columns).erase(first,last,m_size), 0)... };
+          (void)expand;
+       }
+
+       template<std::size_t... I>
+       void rotate_last_to(size_type pos, detail::soa_index_sequence<I...>){
+          int expand[] = { 0, (std::get<I>(m_columns).rotate_last_to(pos,m_size), 0)... };
+          (void)expand;
+       }
+}; // class StaticSoAVector
+
+  namespace detail {
+        // random access iterator over the rows of a StaticSoAVector
+        template<typename Vector>
+        class soa_row_iterator
+          : public boost::iterator_facade< soa_row_iterator<Vector>,
+                                           typename Vector::value_type,
+                                           boost::random_access_traversal_tag,
+                                           typename boost::mpl::if_c< boost::is_const<Vector>::value,
+                                                                      typename Vector::const_reference,
+                                                                      typename Vector::reference >::type >
+        {
+            typedef typename boost::mpl::if_c< boost::is_const<Vector>::value,
+                                               typename Vector::const_reference,
+                                               typename Vector::reference >::type row_reference;
+          public:
+            soa_row_iterator():m_vector(0),m_index(0){}
+            soa_row_iterator(Vector* vector, std::size_t index):m_vector(vector),m_index(index){}
+
+            // iterator to const_iterator conversion
+            template<typename Other>
+            soa_row_iterator(const soa_row_iterator<Other>& rhs):m_vector(rhs.vector()),m_index(rhs.index()){}
+
+            Vector* vector() const { return m_vector; }
+            std::size_t index() const { return m_index; }
+
+          private:
+            friend class boost::iterator_core_access;
+
+            row_reference dereference() const { return (*m_vector)[m_index]; }
+            template<typename Other>
+            bool equal(const soa_row_iterator<Other>& rhs) const { return m_index == rhs.index(); }
+            void increment() { ++m_index; }
+            void decrement() { --m_index; }
+            void advance(std::ptrdiff_t n) { m_index += n; }
+            template<typename Other>
+            std::ptrdiff_t distance_to(const soa_row_iterator<Other>& rhs) const {
+              return static_cast<std::ptrdiff_t>(rhs.index()) - static_cast<std::ptrdiff_t>(m_index);
+            }
+
+            Vector* m_vector;
+            std::size_t m_index;
+        };
+  } // namespace detail
+
+    template<std::size_t N, class... Fields>
+    inline void swap (StaticSoAVector<N,Fields...>& x, StaticSoAVector<N,Fields...>& y) {
+        x.swap(y);
+    }
+
+} // namespace boost
+
+#endif /*BOOST_STATIC_SOA_VECTOR_HPP*/
@@ -0,0 +1,134 @@
+/**
+ *  @file   StaticSoAVectorTests.cpp
+ *  @brief  StaticSoAVectorTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticSoAVector is not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <StaticSoAVector.hpp>
+#include <StaticVectorTestTypes.hpp>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+using namespace boost;
+
+// symbol, price, quantity
+typedef StaticSoAVector<8,std::string,double,int> QuoteVector;
+
+BOOST_AUTO_TEST_CASE(SoAPushBackAndRows){
+  QuoteVector quotes;
+  quotes.push_back("AAA",10.5,100);
+  quotes.push_back(std::string("BBB"),20.25,200);
+  BOOST_CHECK_EQUAL(quotes.size(),2);
+  BOOST_CHECK_EQUAL(std::get<0>(quotes[1]),"BBB");
+  BOOST_CHECK_EQUAL(quotes.get<1>(0),10.5);
+  
+  std::get<2>(quotes[0]) = 150;
+  BOOST_CHECK_EQUAL(quotes.get<2>(0),150);
+  BOOST_CHECK_EQUAL(std::get<2>(quotes.front()),150);
+  BOOST_CHECK_EQUAL(std::get<0>(quotes.back()),"BBB");
+  BOOST_CHECK_THROW(quotes.at(2),std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(SoAColumnsAreContiguous){
+  QuoteVector quotes;
+  for(int i = 0; i < 5; i++){
+    quotes.push_back(std::string(1,'a'+i),i*1.5,i);
+  }
+  QuoteVector::column_range<1>::type prices = quotes.column<1>();
+  BOOST_CHECK_EQUAL(prices.size(),5);
+  BOOST_CHECK_EQUAL(prices.begin(),quotes.data<1>());
+  BOOST_CHECK_EQUAL(std::accumulate(prices.begin(),prices.end(),0.0),15.0);
+  
+  const QuoteVector& cquotes = quotes;
+  BOOST_CHECK_EQUAL(std::accumulate(cquotes.column<2>().begin(),cquotes.column<2>().end(),0),10);
+  BOOST_CHECK_EQUAL(static_cast<std::size_t>(quotes.data<2>()+4-quotes.data<2>()),4u);
+}
+
+BOOST_AUTO_TEST_CASE(SoAInsertErase){
+  QuoteVector quotes;
+  quotes.push_back("a",1.0,1);
+  quotes.push_back("c",3.0,3);
+  quotes.insert(1,"b",2.0,2);
+  quotes.insert(0,"z",0.0,0);
+  BOOST_CHECK_EQUAL(quotes.size(),4);
+  const char* symbols[] = {"z","a","b","c"};
+  for(std::size_t i = 0; i < quotes.size(); i++){
+    BOOST_CHECK_EQUAL(quotes.get<0>(i),symbols[i]);
+    BOOST_CHECK_EQUAL(quotes.get<2>(i),static_cast<int>(quotes.get<1>(i)));
+  }
+  quotes.erase(0);
+  quotes.erase(1,3);
+  BOOST_CHECK_EQUAL(quotes.size(),1);
+  BOOST_CHECK_EQUAL(quotes.get<0>(0),"a");
+  quotes.resize(3);
+  BOOST_CHECK_EQUAL(quotes.get<0>(2),"");
+  BOOST_CHECK_EQUAL(quotes.get<1>(2),0.0);
+}
+
+BOOST_AUTO_TEST_CASE(SoAIterateCopyAndSwap){
+  QuoteVector quotes;
+  quotes.push_back("a",1.0,1);
+  quotes.push_back("b",2.0,2);
+  int sum = 0;
+  for(QuoteVector::iterator it = quotes.begin(); it != quotes.end(); ++it){
+    std::get<2>(*it) *= 10;
+    sum += std::get<2>(*it);
+  }
+  BOOST_CHECK_EQUAL(sum,30);
+  BOOST_CHECK_EQUAL(quotes.end()-quotes.begin(),2);
+  
+  QuoteVector copy(quotes);
+  QuoteVector other;
+  other.push_back("x",9.0,9);
+  copy.swap(other);
+  BOOST_CHECK_EQUAL(copy.size(),1);
+  BOOST_CHECK_EQUAL(other.size(),2);
+  BOOST_CHECK_EQUAL(other.get<0>(1),"b");
+  BOOST_CHECK_EQUAL(other.get<2>(1),20);
+  
+  other.resize(QuoteVector::capacity());
+  BOOST_CHECK_THROW(other.push_back("",0.0,0),std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(SoAMovesAreNoexcept){
+  BOOST_STATIC_ASSERT(std::is_nothrow_move_constructible<QuoteVector>::value);
+  BOOST_STATIC_ASSERT(std::is_nothrow_move_assignable<QuoteVector>::value);
+  BOOST_STATIC_ASSERT(!(std::is_nothrow_move_constructible<StaticSoAVector<8,std::string,Tracked> >::value));
+  
+  std::vector<QuoteVector> books(1);
+  books[0].push_back(std::string(40,'a'),1.5,2);
+  const char* symbol = std::get<0>(books[0][0]).data();
+  for(std::size_t i = 0; i < 100; i++){
+    books.push_back(QuoteVector());
+  }
+  BOOST_CHECK(std::get<0>(books[0][0]).data() == symbol);
+}
+
+BOOST_AUTO_TEST_CASE(SoACopyConstructionIsExceptionSafe){
+  typedef StaticSoAVector<8,std::string,Tracked> TrackedVector;
+  {
+    TrackedVector rows;
+    Tracked::copies_left = 4;
+    for(int i = 0; i < 4; i++){
+      rows.push_back(std::string(20,'a'+i),Tracked());
+    }
+    BOOST_CHECK_EQUAL(Tracked::live,4);
+    Tracked::copies_left = 2;
+    BOOST_CHECK_THROW(TrackedVector copy(rows),std::runtime_error);
+    BOOST_CHECK_EQUAL(Tracked::live,4);
+    Tracked::copies_left = 4;
+    TrackedVector copy(rows);
+    BOOST_CHECK_EQUAL(Tracked::live,8);
+  }
+  BOOST_CHECK_EQUAL(Tracked::live,0);
+}
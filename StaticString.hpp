@@ -0,0 +1,365 @@
+/**
+ * @file   StaticString.hpp
+ * @brief  String with fixed capacity and inline storage, stored in StaticVector.
+ *
+ * BasicStaticString<CharT,N> holds up to N characters in a
+ * StaticVector<CharT,N+1> whose size type is uint_value_t<N>::least, so a
+ * StaticString<31> is 33 bytes: the length and 32 characters. The slot
+ * after the last character always holds CharT(), so c_str() never copies.
+ *
+ * Operations that add characters check the capacity once up front and copy
+ * with one memcpy (append, operator+=, push_back, resize). If the result
+ * would not fit, std::out_of_range is thrown and the string is left as it
+ * was. format_to() appends printf style output in place with vsnprintf.
+ * find, rfind, compare, starts_with and ends_with go through
+ * boost::basic_string_view, whose char_traits use memchr and memcmp for char,
+ * so the header only needs C++11. Where <string_view> is available the
+ * strings also convert to std::basic_string_view. The hash is the one of the
+ * equal boost::basic_string_view, and hash_value() makes the strings usable
+ * with boost::hash.
+ *
+ *   boost::StaticString<64> line("fill ");
+ *   line += symbol;
+ *   boost::format_to(line, " %d@%.2f", quantity, price);
+ *   write(fd, line.data(), line.size());
+ *
+ *  BasicStaticString is not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_STRING_HPP
+#define BOOST_STATIC_STRING_HPP
+
+#include "StaticVector.hpp"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <boost/container_hash/hash.hpp>
+#include <boost/utility/string_view.hpp>
+#if !defined(BOOST_NO_CXX17_HDR_STRING_VIEW)
+#include <string_view>
+#endif
+
+namespace boost {
+
+    template<class CharT, std::size_t N, class Traits = std::char_traits<CharT> >
+    class BasicStaticString {
+        typedef StaticVector<CharT, N+1, typename boost::uint_value_t<N>::least> container_type;
+      public:
+        // type definitions
+        typedef Traits                                         traits_type;
+        typedef CharT                                          value_type;
+        typedef CharT*                                         pointer;
+        typedef const CharT*                                   const_pointer;
+        typedef CharT&                                         reference;
+        typedef const CharT&                                   const_reference;
+        typedef CharT*                                         iterator;
+        typedef const CharT*                                   const_iterator;
+        typedef std::reverse_iterator<iterator>                reverse_iterator;
+        typedef std::reverse_iterator<const_iterator>          const_reverse_iterator;
+        typedef typename boost::uint_value_t<N>::least         size_type;
+        typedef std::ptrdiff_t                                 difference_type;
+        typedef boost::basic_string_view<CharT, Traits>        view_type;
+
+        static const std::size_t npos = std::size_t(-1);
+
+        BasicStaticString() { terminate(); }
+        BasicStaticString(const CharT* s) { terminate(); append(s); }
+        BasicStaticString(const CharT* s, std::size_t n) { terminate(); append(s, n); }
+        BasicStaticString(std::size_t n, CharT c) { terminate(); append(n, c); }
+        explicit BasicStaticString(view_type s) { terminate(); append(s); }
+        template<class Allocator>
+        explicit BasicStaticString(const std::basic_string<CharT, Traits, Allocator>& s) { terminate(); append(s.data(), s.size()); }
+
+        // StaticVector copies only the characters, the terminator is written again
+        BasicStaticString(const BasicStaticString& rhs):m_chars(rhs.m_chars) { terminate(); }
+        BasicStaticString& operator= (const BasicStaticString& rhs) {
+          m_chars = rhs.m_chars;
+          terminate();
+          return *this;
+        }
+
+        BasicStaticString& operator= (const CharT* s) { return assign(view_type(s)); }
+        BasicStaticString& operator= (view_type s) { return assign(s); }
+        BasicStaticString& operator= (CharT c) { return assign(1, c); }
+
+        BasicStaticString& assign(view_type s){
+          capacitycheck(s.size());
+          // s may be a part of this string
+          traits_type::move(m_chars.data(), s.data(), s.size());
+          m_chars.resize_uninitialized(s.size());
+          terminate();
+          return *this;
+        }
+
+        BasicStaticString& assign(std::size_t n, CharT c){
+          clear();
+          return append(n, c);
+        }
+
+        // iterator support
+        iterator        begin()       { return m_chars.begin(); }
+        const_iterator  begin() const { return m_chars.begin(); }
+        const_iterator cbegin() const { return m_chars.begin(); }
+        iterator        end()       { return m_chars.end(); }
+        const_iterator  end() const { return m_chars.end(); }
+        const_iterator cend() const { return m_chars.end(); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+        // capacity is constant, size varies
+        size_type size() const { return m_chars.size(); }
+        size_type length() const { return m_chars.size(); }
+        bool empty() const { return m_chars.empty(); }
+        bool full() const { return size() == N; }
+        static size_type capacity() { return N; }
+        static size_type max_size() { return N; }
+
+        // element access, c_str()[size()] is CharT()
+        reference operator[](std::size_t i) { BOOST_ASSERT(i < size() && "BasicStaticString<>: out of range"); return data()[i]; }
+        const_reference operator[](std::size_t i) const { BOOST_ASSERT(i <= size() && "BasicStaticString<>: out of range"); return data()[i]; }
+        reference at(std::size_t i) { return m_chars.at(i); }
+        const_reference at(std::size_t i) const { return m_chars.at(i); }
+        reference front() { return m_chars.front(); }
+        const_reference front() const { return m_chars.front(); }
+        reference back() { return m_chars.back(); }
+        const_reference back() const { return m_chars.back(); }
+        pointer data() { return m_chars.data(); }
+        const_pointer data() const { return m_chars.data(); }
+        const_pointer c_str() const { return m_chars.data(); }
+
+        view_type view() const { return view_type(data(), size()); }
+        operator view_type() const { return view(); }
+#if !defined(BOOST_NO_CXX17_HDR_STRING_VIEW)
+        operator std::basic_string_view<CharT, Traits>() const { return std::basic_string_view<CharT, Traits>(data(), size()); }
+#endif
+        std::basic_string<CharT, Traits> str() const { return std::basic_string<CharT, Traits>(data(), size()); }
+
+        void clear(){
+          m_chars.clear();
+          terminate();
+        }
+
+        void push_back(CharT c){
+          capacitycheck(size()+std::size_t(1));
+          m_chars.unchecked_push_back(c);
+          terminate();
+        }
+
+        void pop_back(){
+          m_chars.pop_back();
+          terminate();
+        }
+
+        void resize(std::size_t n, CharT c = CharT()){
+          capacitycheck(n);
+          m_chars.resize(n, c);
+          terminate();
+        }
+
+        // append with one capacity check and one copy
+        BasicStaticString& append(const CharT* s, std::size_t n){
+          capacitycheck(size()+n);
+          // s may be a part of this string, the characters after size() are free
+          traits_type::copy(end(), s, n);
+          m_chars.resize_uninitialized(size()+n);
+          terminate();
+          return *this;
+        }
+
+        BasicStaticString& append(const CharT* s) { return append(s, traits_type::length(s)); }
+        BasicStaticString& append(view_type s) { return append(s.data(), s.size()); }
+
+        BasicStaticString& append(std::size_t n, CharT c){
+          capacitycheck(size()+n);
+          m_chars.unchecked_append_n(n, c);
+          terminate();
+          return *this;
+        }
+
+        BasicStaticString& operator+= (const CharT* s) { return append(s); }
+        BasicStaticString& operator+= (view_type s) { return append(s); }
+        BasicStaticString& operator+= (CharT c) { push_back(c); return *this; }
+
+        // removes up to n characters starting at pos
+        BasicStaticString& erase(std::size_t pos = 0, std::size_t n = npos){
+          rangecheck(pos);
+          n = (std::min)(n, size()-pos);
+          m_chars.erase(begin()+pos, begin()+pos+n);
+          terminate();
+          return *this;
+        }
+
+        BasicStaticString substr(std::size_t pos = 0, std::size_t n = npos) const {
+          rangecheck(pos);
+          return BasicStaticString(data()+pos, (std::min)(n, size()-pos));
+        }
+
+        // appends the output of vsnprintf, throws and leaves the string unchanged if it does not fit
+        BasicStaticString& vformat_to(const char* format, std::va_list args){
+          BOOST_STATIC_ASSERT_MSG(sizeof(CharT) == 1, "BasicStaticString<>::format_to writes narrow characters");
+          std::size_t room = N - size();
+          // the terminator slot is part of the buffer vsnprintf may use
+          int written = std::vsnprintf(reinterpret_cast<char*>(end()), room+1, format, args);
+          if(written < 0 || std::size_t(written) > room){
+            terminate();
+            capacitycheck(written < 0 ? std::size_t(-1) : size()+std::size_t(written));
+          }
+          m_chars.resize_uninitialized(size()+written);
+          return *this;
+        }
+
+        // searches, pos and the results are positions as for std::basic_string
+        std::size_t find(view_type s, std::size_t pos = 0) const { return view().find(s, pos); }
+        std::size_t find(CharT c, std::size_t pos = 0) const { return view().find(c, pos); }
+        std::size_t rfind(view_type s, std::size_t pos = npos) const { return view().rfind(s, pos); }
+        std::size_t rfind(CharT c, std::size_t pos = npos) const { return view().rfind(c, pos); }
+        bool contains(view_type s) const { return find(s) != npos; }
+        bool contains(CharT c) const { return find(c) != npos; }
+
+        bool starts_with(view_type s) const { return size() >= s.size() && traits_type::compare(data(), s.data(), s.size()) == 0; }
+        bool ends_with(view_type s) const { return size() >= s.size() && traits_type::compare(end()-s.size(), s.data(), s.size()) == 0; }
+
+        int compare(view_type s) const { return view().compare(s); }
+
+        void swap(BasicStaticString& y){
+          BasicStaticString tmp(*this);
+          *this = y;
+          y = tmp;
+        }
+
+      private:
+        static void capacitycheck(std::size_t n){
+          if(n > N){
+            detail::static_vector_throw_out_of_range("BasicStaticString<>: size out of capacity");
+          }
+        }
+
+        void rangecheck(std::size_t pos) const {
+          if(pos > size()){
+            detail::static_vector_throw_out_of_range("BasicStaticString<>: position out of range");
+          }
+        }
+
+        // the slot behind the last character, StaticVector<CharT,N+1> always has one
+        void terminate(){
+          traits_type::assign(m_chars.data()[size()], CharT());
+        }
+
+        container_type m_chars;
+    };
+
+    template<class CharT, std::size_t N, class Traits>
+    const std::size_t BasicStaticString<CharT,N,Traits>::npos;
+
+    template<std::size_t N> using StaticString = BasicStaticString<char, N>;
+    template<std::size_t N> using StaticWString = BasicStaticString<wchar_t, N>;
+
+    // appends printf style output to s, see BasicStaticString::vformat_to
+    template<std::size_t N, class Traits>
+    BasicStaticString<char,N,Traits>& format_to(BasicStaticString<char,N,Traits>& s, const char* format, ...){
+      std::va_list args;
+      va_start(args, format);
+      BOOST_TRY {
+        s.vformat_to(format, args);
+      } BOOST_CATCH(...) {
+        va_end(args);
+        BOOST_RETHROW;
+      } BOOST_CATCH_END
+      va_end(args);
+      return s;
+    }
+
+    // comparisons with other strings of any capacity, string views and C strings
+    template<class CharT, std::size_t N, std::size_t M, class Traits>
+    bool operator== (const BasicStaticString<CharT,N,Traits>& x, const BasicStaticString<CharT,M,Traits>& y) { return x.view() == y.view(); }
+    template<class CharT, std::size_t N, std::size_t M, class Traits>
+    bool operator!= (const BasicStaticString<CharT,N,Traits>& x, const BasicStaticString<CharT,M,Traits>& y) { return x.view() != y.view(); }
+    template<class CharT, std::size_t N, std::size_t M, class Traits>
+    bool operator< (const BasicStaticString<CharT,N,Traits>& x, const BasicStaticString<CharT,M,Traits>& y) { return x.view() < y.view(); }
+    template<class CharT, std::size_t N, std::size_t M, class Traits>
+    bool operator> (const BasicStaticString<CharT,N,Traits>& x, const BasicStaticString<CharT,M,Traits>& y) { return x.view() > y.view(); }
+    template<class CharT, std::size_t N, std::size_t M, class Traits>
+    bool operator<= (const BasicStaticString<CharT,N,Traits>& x, const BasicStaticString<CharT,M,Traits>& y) { return x.view() <= y.view(); }
+    template<class CharT, std::size_t N, std::size_t M, class Traits>
+    bool operator>= (const BasicStaticString<CharT,N,Traits>& x, const BasicStaticString<CharT,M,Traits>& y) { return x.view() >= y.view(); }
+
+    template<class CharT, std::size_t N, class Traits>
+    bool operator== (const BasicStaticString<CharT,N,Traits>& x, const CharT* y) { return x.view() == boost::basic_string_view<CharT,Traits>(y); }
+    template<class CharT, std::size_t N, class Traits>
+    bool operator== (const CharT* x, const BasicStaticString<CharT,N,Traits>& y) { return y == x; }
+    template<class CharT, std::size_t N, class Traits>
+    bool operator!= (const BasicStaticString<CharT,N,Traits>& x, const CharT* y) { return !(x == y); }
+    template<class CharT, std::size_t N, class Traits>
+    bool operator!= (const CharT* x, const BasicStaticString<CharT,N,Traits>& y) { return !(y == x); }
+    template<class CharT, std::size_t N, class Traits>
+    bool operator== (const BasicStaticString<CharT,N,Traits>& x, boost::basic_string_view<CharT,Traits> y) { return x.view() == y; }
+    template<class CharT, std::size_t N, class Traits>
+    bool operator!= (const BasicStaticString<CharT,N,Traits>& x, boost::basic_string_view<CharT,Traits> y) { return x.view() != y; }
+
+    // concatenation keeps the capacity of the left operand
+    template<class CharT, std::size_t N, class Traits>
+    BasicStaticString<CharT,N,Traits> operator+ (const BasicStaticString<CharT,N,Traits>& x, boost::basic_string_view<CharT,Traits> y) {
+      BasicStaticString<CharT,N,Traits> result(x);
+      result.append(y);
+      return result;
+    }
+    template<class CharT, std::size_t N, std::size_t M, class Traits>
+    BasicStaticString<CharT,N,Traits> operator+ (const BasicStaticString<CharT,N,Traits>& x, const BasicStaticString<CharT,M,Traits>& y) {
+      BasicStaticString<CharT,N,Traits> result(x);
+      result.append(y.data(), y.size());
+      return result;
+    }
+    template<class CharT, std::size_t N, class Traits, class Allocator>
+    BasicStaticString<CharT,N,Traits> operator+ (const BasicStaticString<CharT,N,Traits>& x, const std::basic_string<CharT,Traits,Allocator>& y) {
+      BasicStaticString<CharT,N,Traits> result(x);
+      result.append(y.data(), y.size());
+      return result;
+    }
+    template<class CharT, std::size_t N, class Traits>
+    BasicStaticString<CharT,N,Traits> operator+ (const BasicStaticString<CharT,N,Traits>& x, const CharT* y) {
+      BasicStaticString<CharT,N,Traits> result(x);
+      result.append(y);
+      return result;
+    }
+    template<class CharT, std::size_t N, class Traits>
+    BasicStaticString<CharT,N,Traits> operator+ (const BasicStaticString<CharT,N,Traits>& x, CharT y) {
+      BasicStaticString<CharT,N,Traits> result(x);
+      result.push_back(y);
+      return result;
+    }
+
+    template<class CharT, std::size_t N, class Traits>
+    std::basic_ostream<CharT,Traits>& operator<< (std::basic_ostream<CharT,Traits>& os, const BasicStaticString<CharT,N,Traits>& s) {
+      return os << s.view();
+    }
+
+    template<class CharT, std::size_t N, class Traits>
+    inline void swap (BasicStaticString<CharT,N,Traits>& x, BasicStaticString<CharT,N,Traits>& y) {
+      x.swap(y);
+    }
+
+    // for boost::hash, equal to boost::hash of the same characters in a boost::basic_string_view
+    template<class CharT, std::size_t N, class Traits>
+    std::size_t hash_value(const BasicStaticString<CharT,N,Traits>& s) {
+      return boost::hash_range(s.begin(), s.end());
+    }
+
+} // namespace boost
+
+namespace std {
+    template<class CharT, std::size_t N, class Traits>
+    struct hash<boost::BasicStaticString<CharT,N,Traits> > {
+        std::size_t operator()(const boost::BasicStaticString<CharT,N,Traits>& s) const { return boost::hash_value(s); }
+    };
+}
+
+#endif /* BOOST_STATIC_STRING_HPP */
@@ -0,0 +1,124 @@
+/**
+ *  @file   StaticStringTests.cpp
+ *  @brief  StaticStringTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  BasicStaticString is not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <boost/functional/hash.hpp>
+#include <StaticString.hpp>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+using namespace boost;
+
+BOOST_AUTO_TEST_CASE(StaticStringLayout){
+  BOOST_CHECK_EQUAL(sizeof(StaticString<31>),33u);
+  BOOST_CHECK_EQUAL(sizeof(StaticString<31>::size_type),1u);
+  StaticString<31> symbol;
+  BOOST_CHECK(symbol.empty());
+  BOOST_CHECK_EQUAL(symbol.c_str()[0],'\0');
+  BOOST_CHECK_EQUAL(StaticString<255>::capacity(),255u);
+}
+
+BOOST_AUTO_TEST_CASE(StaticStringAppend){
+  StaticString<16> tag("35=");
+  tag += 'D';
+  tag += "|49=";
+  tag.append("ABCDEFGHIJ",0).append(3,'x');
+  BOOST_CHECK_EQUAL(tag,"35=D|49=xxx");
+  BOOST_CHECK_EQUAL(std::strlen(tag.c_str()),tag.size());
+  
+  // too long, nothing changes
+  BOOST_CHECK_THROW(tag.append("0123456"),std::out_of_range);
+  BOOST_CHECK_THROW(tag.append(6,'y'),std::out_of_range);
+  BOOST_CHECK_EQUAL(tag.size(),11u);
+  tag.append("01234");
+  BOOST_CHECK(tag.full());
+  BOOST_CHECK_THROW(tag.push_back('!'),std::out_of_range);
+  BOOST_CHECK_EQUAL(tag.c_str()[16],'\0');
+  
+  // appending a part of itself
+  StaticString<16> twice("abc");
+  twice.append(twice.view());
+  BOOST_CHECK_EQUAL(twice,"abcabc");
+  twice.assign(twice.view().substr(2));
+  BOOST_CHECK_EQUAL(twice,"cabc");
+  
+  StaticString<16> copy(twice);
+  copy.pop_back();
+  twice = copy;
+  BOOST_CHECK_EQUAL(std::string(twice.c_str()),"cab");
+  BOOST_CHECK_EQUAL((copy + "de" + 'f').str(),"cabdef");
+  StaticString<4> other("gh");
+  BOOST_CHECK_EQUAL(copy + twice,"cabcab");
+  BOOST_CHECK_EQUAL(copy + other,"cabgh");
+  BOOST_CHECK_EQUAL(copy + std::string("xyz"),"cabxyz");
+  BOOST_CHECK_THROW(copy + std::string(14,'y'),std::out_of_range);
+  BOOST_CHECK_THROW(tag + other,std::out_of_range);
+  copy.resize(5,'z');
+  BOOST_CHECK_EQUAL(copy,"cabzz");
+  copy.erase(1,2);
+  BOOST_CHECK_EQUAL(copy,"czz");
+  BOOST_CHECK_EQUAL(copy.substr(1),"zz");
+  BOOST_CHECK_THROW(copy.substr(4),std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(StaticStringFormat){
+  StaticString<32> line("fill ");
+  format_to(line,"%s %d@%.2f","IBM",100,12.5);
+  BOOST_CHECK_EQUAL(line,"fill IBM 100@12.50");
+  format_to(line,"%d",12345678);
+  BOOST_CHECK_EQUAL(line.size(),26u);
+  BOOST_CHECK_THROW(format_to(line,"%s","1234567"),std::out_of_range);
+  BOOST_CHECK_EQUAL(line,"fill IBM 100@12.5012345678");
+  BOOST_CHECK_EQUAL(std::strlen(line.c_str()),line.size());
+  format_to(line,"%s","123456");
+  BOOST_CHECK(line.full());
+  
+  std::ostringstream out;
+  out << line.substr(5,3);
+  BOOST_CHECK_EQUAL(out.str(),"IBM");
+}
+
+BOOST_AUTO_TEST_CASE(StaticStringSearchCompareHash){
+  StaticString<32> s("BTC-USD.PERP");
+  BOOST_CHECK_EQUAL(s.find('-'),3u);
+  BOOST_CHECK_EQUAL(s.find("USD"),4u);
+  BOOST_CHECK_EQUAL(s.rfind('P'),11u);
+  BOOST_CHECK_EQUAL(s.find('X'),StaticString<32>::npos);
+  BOOST_CHECK(s.starts_with("BTC") && s.ends_with(".PERP") && !s.ends_with("USD"));
+  BOOST_CHECK(s.contains("USD.") && !s.contains('x'));
+  
+  StaticString<8> shorter("BTC");
+  BOOST_CHECK(shorter < s);
+  BOOST_CHECK(s != shorter);
+  BOOST_CHECK(s.compare("BTC-USD.PERP") == 0);
+  BOOST_CHECK(StaticString<16>("BTC") == shorter);
+  
+  boost::string_view view = s;
+  BOOST_CHECK_EQUAL(view.size(),12u);
+  BOOST_CHECK_EQUAL(std::hash<StaticString<32> >()(s),boost::hash<boost::string_view>()(view));
+  BOOST_CHECK_EQUAL(boost::hash<StaticString<32> >()(s),hash_value(s));
+#if !defined(BOOST_NO_CXX17_HDR_STRING_VIEW)
+  std::string_view std_view = s;
+  BOOST_CHECK(std_view == "BTC-USD.PERP");
+#endif
+  std::unordered_set<StaticString<32> > symbols;
+  symbols.insert(s);
+  symbols.insert(StaticString<32>("ETH-USD"));
+  BOOST_CHECK_EQUAL(symbols.count(StaticString<32>(view)),1u);
+  
+  StaticWString<8> wide(L"wide");
+  BOOST_CHECK_EQUAL(wide.size(),4u);
+  BOOST_CHECK(wide == L"wide");
+}
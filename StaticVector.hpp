@@ -43,6 +43,7 @@
 #define BOOST_STATIC_VECTOR_HPP
 
 #include <boost/config.hpp>
+#include <boost/version.hpp>
 #include <boost/detail/workaround.hpp>
 
 #if BOOST_WORKAROUND(BOOST_MSVC, >= 1400)  
@@ -55,6 +56,7 @@
 #include <cstddef>
 #include <stdexcept>
 #include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
 #if ((BOOST_VERSION / 100) % 1000) > 44
 #include <boost/swap.hpp>
 #endif
@@ -63,7 +65,14 @@
 // Handles broken standard libraries better than <iterator>
 #include <boost/detail/iterator.hpp>
 #include <boost/throw_exception.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+#include <boost/move/utility_core.hpp>
+#include <boost/move/algo/move.hpp>
 #include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <cstring>
 
 // FIXES for broken compilers
 #include <boost/config.hpp>
@@ -71,22 +80,189 @@
 // Selection of types for internal storage
 #include <boost/integer.hpp>
 #include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
 #include <boost/type_traits/aligned_storage.hpp>
 #include <boost/type_traits/has_nothrow_copy.hpp>
 #include <boost/type_traits/has_nothrow_assign.hpp>
 #include <boost/type_traits/has_trivial_assign.hpp>
+#include <boost/type_traits/has_trivial_move_assign.hpp>
+#include <boost/type_traits/has_trivial_move_constructor.hpp>
 #include <boost/type_traits/has_trivial_constructor.hpp>
 #include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include "StaticVectorSimd.hpp"
+
+// C++20 lets StaticVector<T,N> with trivially destructible T be used in constant expressions:
+// its slots are then a union over T[N] instead of aligned_storage, and the memcpy, memmove and
+// placement new fast paths fall back to std::construct_at and std algorithms while the compiler
+// evaluates them. Other element types and older standards ignore BOOST_STATIC_VECTOR_CONSTEXPR.
+#if __cplusplus >= 202002L
+#include <version>
+#endif
+#if defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_constexpr_dynamic_alloc) \
+    && defined(__cpp_lib_is_constant_evaluated) && defined(__cpp_lib_constexpr_algorithms)
+#include <type_traits>
+#define BOOST_STATIC_VECTOR_HAS_CONSTEXPR 1
+#define BOOST_STATIC_VECTOR_CONSTEXPR constexpr
+#else
+#define BOOST_STATIC_VECTOR_HAS_CONSTEXPR 0
+#define BOOST_STATIC_VECTOR_CONSTEXPR
+#endif
+
+// C++20 iterators that declare themselves contiguous, e.g. std::vector<T>::iterator, are copied with memcpy like pointers
+#if defined(__cpp_lib_concepts) && defined(__cpp_lib_to_address)
+#include <iterator>
+#define BOOST_STATIC_VECTOR_HAS_CONTIGUOUS_ITERATORS 1
+#else
+#define BOOST_STATIC_VECTOR_HAS_CONTIGUOUS_ITERATORS 0
+#endif
 
 
 namespace boost {
 
+    // Trait telling StaticVector that a T can be moved to another address with memmove,
+    // after which the source bytes are simply abandoned without running a destructor.
+    // It is detected for trivially copyable types. Types with pointer semantics that
+    // never point into themselves, such as std::unique_ptr, may opt in by specializing it:
+    //
+    //   namespace boost { template<> struct is_trivially_relocatable<Handle> : boost::true_type {}; }
+    template<class T>
+    struct is_trivially_relocatable : boost::integral_constant<bool,
+        boost::has_trivial_copy<T>::value && boost::has_trivial_destructor<T>::value > {};
+
   namespace detail { // forward declarations
         template< typename InputIterator, typename OutputIterator >
         static void uninitialized_copy_backward(InputIterator begin, InputIterator end, OutputIterator result);
   }
 
-    template<class T, std::size_t N, typename size_type_t = typename boost::uint_value_t<N>::least>
+  namespace detail {
+        // true while the compiler evaluates a constant expression, the memcpy and placement new paths must be avoided then
+        BOOST_STATIC_VECTOR_CONSTEXPR inline bool static_vector_constant_evaluated() {
+#if BOOST_STATIC_VECTOR_HAS_CONSTEXPR
+          return std::is_constant_evaluated();
+#else
+          return false;
+#endif
+        }
+
+        // address of the element an iterator into contiguous storage refers to
+        template<class T>
+        BOOST_STATIC_VECTOR_CONSTEXPR inline T* static_vector_to_address(T* p) { return p; }
+#if BOOST_STATIC_VECTOR_HAS_CONTIGUOUS_ITERATORS
+        template<class ContiguousIterator>
+        constexpr inline auto static_vector_to_address(const ContiguousIterator& it) { return std::to_address(it); }
+#endif
+
+        template<class T>
+        struct static_vector_equal_to {
+            explicit static_vector_equal_to(const T& value):m_value(value){}
+            bool operator()(const T& x) const { return x == m_value; }
+            const T& m_value;
+        };
+
+        // arithmetic T, compact with detail::simd::remove and cut off the tail
+        template<class Vector, class T>
+        std::size_t static_vector_erase_value(Vector& x, const T& value, const boost::true_type&){
+            std::size_t n = simd::remove(x.begin(), x.size(), value);
+            std::size_t erased = x.size() - n;
+            if(erased){
+              x.erase(x.begin()+n, x.end());
+            }
+            return erased;
+        }
+
+        template<class Vector, class T>
+        std::size_t static_vector_erase_value(Vector& x, const T& value, const boost::false_type&){
+            return x.erase_if(static_vector_equal_to<T>(value));
+        }
+
+        // kept out of the checks so they stay usable in constant expressions
+        BOOST_NORETURN inline void static_vector_throw_out_of_range(const char* what) {
+          std::out_of_range e(what);
+          BOOST_THROW_EXCEPTION(e);
+        }
+
+        // element slots of a StaticVector, raw memory turned into T* with reinterpret_cast
+        template<class T, std::size_t N, bool ConstexprSlots>
+        struct static_vector_storage {
+            typedef typename boost::aligned_storage<
+                               sizeof(T),
+                               boost::alignment_of<T>::value
+                             >::type aligned_storage;
+
+            T* slot(std::size_t i) { return reinterpret_cast<T*>(elems+i); }
+            const T* slot(std::size_t i) const { return reinterpret_cast<const T*>(elems+i); }
+
+            aligned_storage elems[N];
+        };
+
+#if BOOST_STATIC_VECTOR_HAS_CONSTEXPR
+        // the same slots as a union over T[N], which constant evaluation can address without reinterpret_cast.
+        // A StaticVector stored in a constexpr variable may not hold uninitialized bytes past size(),
+        // so while the compiler evaluates, every slot of a default constructible T is value-initialized up front.
+        template<class T, std::size_t N>
+        struct static_vector_storage<T,N,true> {
+            constexpr static_vector_storage(){
+              if constexpr (std::is_default_constructible<T>::value){
+                if(std::is_constant_evaluated()){
+                  for(std::size_t i = 0; i < N; ++i){
+                    std::construct_at(values+i);
+                  }
+                }
+              }
+            }
+
+            constexpr T* slot(std::size_t i) { return values+i; }
+            constexpr const T* slot(std::size_t i) const { return values+i; }
+
+            union { T values[N]; };
+        };
+#endif
+  }
+
+    // stats policy of StaticVector that records nothing, every hook compiles away.
+    // StaticVectorStats.hpp has static_vector_stats, which counts them.
+    struct static_vector_no_stats {
+        BOOST_STATIC_VECTOR_CONSTEXPR static void grow(std::size_t /*size*/, std::size_t /*capacity*/) {}
+        BOOST_STATIC_VECTOR_CONSTEXPR static void overflow(std::size_t /*requested*/, std::size_t /*capacity*/) {}
+        BOOST_STATIC_VECTOR_CONSTEXPR static void middle_insert() {}
+        BOOST_STATIC_VECTOR_CONSTEXPR static void erase() {}
+        BOOST_STATIC_VECTOR_CONSTEXPR static void copy() {}
+    };
+
+    // error policies of StaticVector, consulted when an operation needs more than the capacity
+    // (overflow) or at() is given an index past the end (out_of_range).
+    //
+    // static_vector_throw_on_error, the default, throws std::out_of_range. With the other policies,
+    // static_vector_assert_on_error below and static_vector_saturate_on_error in StaticVectorSaturate.hpp,
+    // nothing is thrown and an operation that does not fit is dropped: the vector is left unchanged,
+    // push_back/insert/append/resize return without effect. at() cannot drop its result, for these
+    // policies it only asserts like operator[]. Independent of the policy, try_push_back,
+    // try_emplace_back and try_insert report a full vector by returning false.
+    struct static_vector_throw_on_error {
+        BOOST_NORETURN static void overflow(std::size_t /*requested*/, std::size_t /*capacity*/) {
+          detail::static_vector_throw_out_of_range("StaticVector<>: index out of capacity");
+        }
+        BOOST_NORETURN static void out_of_range(std::size_t /*index*/, std::size_t /*size*/) {
+          detail::static_vector_throw_out_of_range("StaticVector<>: index out of range");
+        }
+    };
+
+    // for code built without exceptions: a failed check is a programming error caught by BOOST_ASSERT,
+    // release builds drop the operation
+    struct static_vector_assert_on_error {
+        static void overflow(std::size_t /*requested*/, std::size_t /*capacity*/) {
+          BOOST_ASSERT_MSG(false, "StaticVector<>: index out of capacity");
+        }
+        static void out_of_range(std::size_t /*index*/, std::size_t /*size*/) {
+          BOOST_ASSERT_MSG(false, "StaticVector<>: index out of range");
+        }
+    };
+
+    template<class T, std::size_t N, typename size_type_t = typename boost::uint_value_t<N>::least,
+             class StatsPolicy = static_vector_no_stats, class ErrorPolicy = static_vector_throw_on_error>
     class StaticVector {
       public:
         // type definitions
@@ -104,6 +280,8 @@ namespace boost {
         typedef size_type_t                                    size_type;
         typedef size_type                                      max_size_type;
         typedef std::ptrdiff_t                                 difference_type;
+        typedef StatsPolicy                                    stats_policy;
+        typedef ErrorPolicy                                    error_policy;
         typedef typename boost::mpl::if_c< boost::has_trivial_assign<T>::value
                                            && sizeof(T) <= sizeof(long double),
                                           const value_type, 
@@ -111,19 +289,22 @@ namespace boost {
                                                       optimized_const_reference;
         
       private:
+        typedef detail::static_vector_storage<T, N,
+                  BOOST_STATIC_VECTOR_HAS_CONSTEXPR && boost::has_trivial_destructor<T>::value> storage_type;
+
         size_type m_size; // fastest type that can accomodate N
-        aligned_storage elems[N];    // fixed-size array of memory aligned elements of type T
+        storage_type elems;    // fixed-size array of memory aligned elements of type T
 
       public:
 
         // iterator support
-        iterator        begin()       { return reinterpret_cast<iterator>(elems); }
-        const_iterator  begin() const { return reinterpret_cast<const_iterator>(elems); }
-        const_iterator cbegin() const { return reinterpret_cast<const_iterator>(elems); }
+        BOOST_STATIC_VECTOR_CONSTEXPR iterator        begin()       { return to_object(0); }
+        BOOST_STATIC_VECTOR_CONSTEXPR const_iterator  begin() const { return to_object(0); }
+        BOOST_STATIC_VECTOR_CONSTEXPR const_iterator cbegin() const { return to_object(0); }
         
-        iterator        end()       { return to_object(m_size); }
-        const_iterator  end() const { return to_object(m_size); }
-        const_iterator cend() const { return to_object(m_size); }
+        BOOST_STATIC_VECTOR_CONSTEXPR iterator        end()       { return to_object(m_size); }
+        BOOST_STATIC_VECTOR_CONSTEXPR const_iterator  end() const { return to_object(m_size); }
+        BOOST_STATIC_VECTOR_CONSTEXPR const_iterator cend() const { return to_object(m_size); }
 
         // reverse iterator support
 #if !defined(BOOST_NO_TEMPLATE_PARTIAL_SPECIALIZATION) && !defined(BOOST_MSVC_STD_ITERATOR) && !defined(BOOST_NO_STD_ITERATOR_TRAITS)
@@ -146,429 +327,1032 @@ namespace boost {
         typedef std::reverse_iterator<const_iterator,T> const_reverse_iterator;
 #endif
 
-        reverse_iterator rbegin() { return reverse_iterator(end()); }
-        const_reverse_iterator rbegin() const {
+        BOOST_STATIC_VECTOR_CONSTEXPR reverse_iterator rbegin() { return reverse_iterator(end()); }
+        BOOST_STATIC_VECTOR_CONSTEXPR const_reverse_iterator rbegin() const {
             return const_reverse_iterator(end());
         }
-        const_reverse_iterator crbegin() const {
+        BOOST_STATIC_VECTOR_CONSTEXPR const_reverse_iterator crbegin() const {
             return const_reverse_iterator(end());
         }
 
-        reverse_iterator rend() { return reverse_iterator(begin()); }
-        const_reverse_iterator rend() const {
+        BOOST_STATIC_VECTOR_CONSTEXPR reverse_iterator rend() { return reverse_iterator(begin()); }
+        BOOST_STATIC_VECTOR_CONSTEXPR const_reverse_iterator rend() const {
             return const_reverse_iterator(begin());
         }
-        const_reverse_iterator crend() const {
+        BOOST_STATIC_VECTOR_CONSTEXPR const_reverse_iterator crend() const {
             return const_reverse_iterator(begin());
         }
 
-        StaticVector():m_size(0){}
+        BOOST_STATIC_VECTOR_CONSTEXPR StaticVector():m_size(0){}
 
-        StaticVector(size_type n, const_reference value):
-          m_size(n)
+        BOOST_STATIC_VECTOR_CONSTEXPR StaticVector(size_type n, const_reference value):
+          m_size(0)
         {
-          insert(begin(),n,value);
+          insert(end(),n,value);
         }
 
+        // [first,last) may be a single pass range, two integers are a count and a value as in std::vector
         template<typename InputIterator>
-        StaticVector(InputIterator first, InputIterator last):
-          m_size(last-first)
+        BOOST_STATIC_VECTOR_CONSTEXPR StaticVector(InputIterator first, InputIterator last):
+          m_size(0)
         {
-          // TODO: have this function call two versions of this function, one for foward iteration only and the other for random access
-          capacitycheck(size());
-          copy_impl(first,last,begin());
+          BOOST_TRY {
+            append_dispatch(first,last,boost::is_integral<InputIterator>());
+          } BOOST_CATCH(...) {
+            clear();
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
         }
 
         template<std::size_t SizeRHS>
-        StaticVector(const StaticVector<T,SizeRHS>& rhs):
-          m_size(rhs.size())
+        BOOST_STATIC_VECTOR_CONSTEXPR StaticVector(const StaticVector<T,SizeRHS>& rhs):
+          m_size(0)
+        {
+          StatsPolicy::copy();
+          if(capacitycheck(rhs.size())){
+            return;
+          }
+          uninitialized_copy_impl(rhs.begin(),rhs.end(),begin());
+          m_size = rhs.size();
+          grown();
+        }
+
+        BOOST_STATIC_VECTOR_CONSTEXPR StaticVector(const StaticVector& rhs):
+          m_size(0)
         {
-          capacitycheck(rhs.size());
-          copy_impl<StaticVector<T,SizeRHS>::iterator,T,N>(rhs.begin(),rhs.end(),begin());
+          StatsPolicy::copy();
+          uninitialized_copy_impl(rhs.begin(),rhs.end(),begin());
+          m_size = rhs.size();
+          grown();
         }
-//*
-        StaticVector(const StaticVector<T,N>& rhs):
-          m_size(rhs.size())
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+        // rhs keeps its size, but its elements are left in a moved-from state
+        BOOST_STATIC_VECTOR_CONSTEXPR StaticVector(StaticVector&& rhs)
+          BOOST_NOEXCEPT_IF(std::is_nothrow_move_constructible<T>::value):
+          m_size(0)
         {
-          copy_impl(rhs.begin(),rhs.end(),begin());
+          uninitialized_move_impl(rhs.begin(),rhs.end(),begin());
+          m_size = rhs.size();
+          grown();
         }
+#endif
 
-        ~StaticVector(){
+        BOOST_STATIC_VECTOR_CONSTEXPR ~StaticVector(){
           destroy_array(::boost::has_trivial_destructor<T>());
         }
 
-        void push_back (const_reference x){
-          capacitycheck(size()+1);
+        BOOST_STATIC_VECTOR_CONSTEXPR void push_back (const_reference x){
+          if(capacitycheck(size()+1)){
+            return;
+          }
+          unchecked_push_back(x);
+        }
+
+        // push_back that returns false instead of failing through the error policy when the vector is full
+        BOOST_STATIC_VECTOR_CONSTEXPR bool try_push_back (const_reference x){
+          if(capacity_exceeded(size()+1)){
+            return false;
+          }
           unchecked_push_back(x);
+          return true;
         }
 
-        void unchecked_push_back (const_reference x){
-          new (to_object(size())) T(x);
+        BOOST_STATIC_VECTOR_CONSTEXPR void unchecked_push_back (const_reference x){
+          construct(to_object(size()),x);
           m_size++;
+          grown();
         }
 
-        void pop_back(){
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+        BOOST_STATIC_VECTOR_CONSTEXPR void push_back (value_type&& x){
+          if(capacitycheck(size()+1)){
+            return;
+          }
+          unchecked_push_back(std::move(x));
+        }
+
+        BOOST_STATIC_VECTOR_CONSTEXPR bool try_push_back (value_type&& x){
+          if(capacity_exceeded(size()+1)){
+            return false;
+          }
+          unchecked_push_back(std::move(x));
+          return true;
+        }
+
+        BOOST_STATIC_VECTOR_CONSTEXPR void unchecked_push_back (value_type&& x){
+          construct(to_object(size()),std::move(x));
+          m_size++;
+          grown();
+        }
+#endif
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+        // construct a new element in place at the end, when the error policy drops the
+        // operation the vector is full and the old back() is returned
+        template<typename... Args>
+        BOOST_STATIC_VECTOR_CONSTEXPR reference emplace_back (Args&&... args){
+          if(!capacitycheck(size()+1)){
+            construct(to_object(size()),std::forward<Args>(args)...);
+            m_size++;
+            grown();
+          }
+          return back();
+        }
+
+        // emplace_back that returns false when the vector is full, args are left untouched then
+        template<typename... Args>
+        BOOST_STATIC_VECTOR_CONSTEXPR bool try_emplace_back (Args&&... args){
+          if(capacity_exceeded(size()+1)){
+            return false;
+          }
+          construct(to_object(size()),std::forward<Args>(args)...);
+          m_size++;
+          grown();
+          return true;
+        }
+
+        // construct a new element in front of pos
+        template<typename... Args>
+        BOOST_STATIC_VECTOR_CONSTEXPR iterator emplace (iterator pos, Args&&... args){
+          if(pos == end()){
+            emplace_back(std::forward<Args>(args)...);
+            return pos;
+          }
+          // args may refer to an element that is about to be shifted
+          value_type x(std::forward<Args>(args)...);
+          return insert_moved(pos,x);
+        }
+#endif
+
+        // bulk appends check the capacity once, construct the new elements in one pass
+        // (a memcpy or fill for trivial T) and update the size once
+        //
+        // [first,last) may be a single pass range, two integers are a count and a value as in std::vector.
+        // If the range does not fit, std::out_of_range is thrown and the vector is left unchanged.
+        template<typename InputIterator>
+        BOOST_STATIC_VECTOR_CONSTEXPR void append(InputIterator first, InputIterator last){
+          append_dispatch(first,last,boost::is_integral<InputIterator>());
+        }
+
+        BOOST_STATIC_VECTOR_CONSTEXPR void append_n(max_size_type n, const_reference x){
+          if(capacitycheck(size()+n)){
+            return;
+          }
+          unchecked_append_n(n,x);
+        }
+
+        // the caller guarantees that std::distance(first,last) <= capacity()-size()
+        template<typename ForwardIterator>
+        BOOST_STATIC_VECTOR_CONSTEXPR void unchecked_append(ForwardIterator first, ForwardIterator last){
+          std::size_t n = std::distance(first,last);
+          BOOST_ASSERT( size()+n <= N && "StaticVector<>: unchecked_append past the capacity" );
+          append_constructed(first,last,n);
+        }
+
+        // the caller guarantees that n <= capacity()-size()
+        BOOST_STATIC_VECTOR_CONSTEXPR void unchecked_append_n(max_size_type n, const_reference x){
+          BOOST_ASSERT( size()+std::size_t(n) <= N && "StaticVector<>: unchecked_append_n past the capacity" );
+          // x may be an element of this vector, the new elements are constructed behind it
+          uninitialized_fill_impl(end(),n,x);
+          m_size += n;
+          grown();
+        }
+
+        BOOST_STATIC_VECTOR_CONSTEXPR void pop_back(){
           BOOST_ASSERT(!empty());
           m_size--;
           to_object(size())->~T();
         }
 
-        iterator insert(iterator pos, const_reference x){
-          BOOST_ASSERT(!capacitycheck(size()+1));
-          copy_backward_impl(pos,end(),end()+1);
-          *pos = x;
-          m_size++;
-          return pos;
+        BOOST_STATIC_VECTOR_CONSTEXPR iterator insert(iterator pos, const_reference x){
+          // x may refer to an element that is about to be shifted
+          value_type copy(x);
+          return insert_moved(pos,copy);
         }
 
-        void insert(iterator pos, max_size_type n, const_reference x){
-          capacitycheck(size()+n);
-          copy_backward_impl(pos,end(),end()+n);
-          std::fill(pos,pos+n,x);
-          m_size+=n;
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+        BOOST_STATIC_VECTOR_CONSTEXPR iterator insert(iterator pos, value_type&& x){
+          return insert_moved(pos,x);
+        }
+#endif
+
+        // insert that returns false instead of failing through the error policy when the vector is full
+        BOOST_STATIC_VECTOR_CONSTEXPR bool try_insert(iterator pos, const_reference x){
+          if(capacity_exceeded(size()+1)){
+            return false;
+          }
+          value_type copy(x);
+          insert_moved_unchecked(pos,copy);
+          return true;
+        }
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+        BOOST_STATIC_VECTOR_CONSTEXPR bool try_insert(iterator pos, value_type&& x){
+          if(capacity_exceeded(size()+1)){
+            return false;
+          }
+          insert_moved_unchecked(pos,x);
+          return true;
+        }
+#endif
+
+        BOOST_STATIC_VECTOR_CONSTEXPR void insert(iterator pos, max_size_type n, const_reference x){
+          if(capacitycheck(size()+n)){
+            return;
+          }
+          if(pos == end()){
+            unchecked_append_n(n,x);
+            return;
+          }
+          StatsPolicy::middle_insert();
+          // x may refer to an element that is about to be shifted
+          value_type copy(x);
+          insert_fill(pos,n,copy,is_trivially_relocatable<T>());
         }
 
+        // [first,last) may be a single pass range, two integers are a count and a value as in std::vector
         template <typename InputIterator>
-        void insert(iterator pos, InputIterator first, InputIterator last){
-          // TODO: have this function call two versions of this function, one for foward iteration only and the other for random access
-          difference_type n = last-first;
-          BOOST_ASSERT(!capacitycheck(size()+n));
-          copy_backward_impl(pos,end(),end()+n);
-          copy_impl(first,last,pos);
+        BOOST_STATIC_VECTOR_CONSTEXPR void insert(iterator pos, InputIterator first, InputIterator last){
+          insert_dispatch(pos,first,last,boost::is_integral<InputIterator>());
         }
 
-        iterator erase(iterator pos){
+        BOOST_STATIC_VECTOR_CONSTEXPR iterator erase(iterator pos){
           BOOST_ASSERT(!rangecheck(pos-begin()));
-          pos->~T();
-          copy_impl(pos+1,end(),pos);
-          m_size--;
+          if(pos+1 != end()){
+            StatsPolicy::erase();
+          }
+          return erase_shift(pos,pos+1,is_trivially_relocatable<T>());
+        }
+
+        BOOST_STATIC_VECTOR_CONSTEXPR iterator erase(iterator first, iterator last){
+          BOOST_ASSERT(begin() <= first && first <= last && last <= end());
+          if(first != last && last != end()){
+            StatsPolicy::erase();
+          }
+          return erase_shift(first,last,is_trivially_relocatable<T>());
+        }
+
+        // erase every element for which pred is true in a single pass, keeping the order of the rest.
+        // Relocatable survivors are moved down in runs with one memmove each. Returns the number erased.
+        template<class Predicate>
+        size_type erase_if(Predicate pred){
+          iterator first = std::find_if(begin(),end(),pred);
+          if(first == end()){
+            return 0;
+          }
+          StatsPolicy::erase();
+          size_type old_size = size();
+          erase_if_impl(first,pred,is_trivially_relocatable<T>());
+          return old_size - size();
+        }
+
+        // erase pos by moving the last element into its place, O(1) but the order is not kept
+        BOOST_STATIC_VECTOR_CONSTEXPR iterator unordered_erase(iterator pos){
+          BOOST_ASSERT(!rangecheck(pos-begin()));
+          if(pos+1 != end()){
+            erase_swap(pos,is_trivially_relocatable<T>());
+          } else {
+            pop_back();
+          }
           return pos;
         }
 
-        iterator erase(iterator first, iterator last){
-          difference_type n = last-first;
-      	  BOOST_ASSERT(!rangecheck(size()-n));
-      	  for(iterator it = first; first!=last; ++first){
-      	    it->~T();
-      	  }
-      	  copy_impl(last,end(),first);
-      	  m_size -= n;
-      	  
-          return first;
+        BOOST_STATIC_VECTOR_CONSTEXPR void clear(){
+          destroy_array(::boost::has_trivial_destructor<T>());
+          m_size = 0;
         }
 
-        void clear(){
-          erase(begin(),end());
+        BOOST_STATIC_VECTOR_CONSTEXPR void resize(max_size_type n, const_reference t = T() ){
+          if(capacitycheck(n)){
+            return;
+          }
+          if(n > size()){
+            uninitialized_fill_impl(end(), n-size(), t);
+            m_size = n;
+            grown();
+          } else {
+            erase(begin()+n,end());
+          }
         }
 
-        void resize(max_size_type n, const_reference t = T() ){
-          capacitycheck(n);
-          if(n - m_size > 0){
-            std::fill_n(end(), n-m_size, t);
+        // like resize(), but new elements are default-initialized rather than copied from a value,
+        // so for a trivially constructible T the slots are left as they are instead of being filled
+        void resize_default_init(max_size_type n){
+          if(capacitycheck(n)){
+            return;
+          }
+          if(n > size()){
+            default_init_range(end(), n-size(), boost::has_trivial_constructor<T>());
+            m_size = n;
+            grown();
           } else {
             erase(begin()+n,end());
           }
-	        m_size = n;
-	      }
+        }
+
+        // resize without touching the new elements, which hold indeterminate values until written
+        void resize_uninitialized(max_size_type n){
+          BOOST_STATIC_ASSERT_MSG(boost::has_trivial_constructor<T>::value && boost::has_trivial_destructor<T>::value,
+                                  "StaticVector<>::resize_uninitialized requires a trivial T, use resize_default_init");
+          resize_default_init(n);
+        }
+
+        // fill the unused tail in place: writer(end(), capacity()-size()) writes elements to the front
+        // of the tail and returns how many, which then become part of the vector. Returns that count.
+        //
+        //   buffer.append_from([&](char* tail, std::size_t room){ return read(fd, tail, room); });
+        template<typename Writer>
+        max_size_type append_from(Writer writer){
+          BOOST_STATIC_ASSERT_MSG(boost::has_trivial_constructor<T>::value && boost::has_trivial_destructor<T>::value,
+                                  "StaticVector<>::append_from requires a trivial T");
+          std::size_t room = N - size();
+          std::size_t written = writer(end(), room);
+          BOOST_ASSERT(written <= room && "StaticVector<>: append_from wrote past the capacity");
+          if(capacitycheck(size()+written)){
+            return 0;
+          }
+          m_size += written;
+          if(written != 0){
+            grown();
+          }
+          return written;
+        }
 
-        void reserve(max_size_type n){
+        // checks n against the capacity, nothing is recorded since the size does not change
+        BOOST_STATIC_VECTOR_CONSTEXPR void reserve(max_size_type n){
           capacitycheck(n);
         }
 
         // operator[]
-        reference operator[](max_size_type i) 
+        BOOST_STATIC_VECTOR_CONSTEXPR reference operator[](max_size_type i) 
         { 
-            BOOST_ASSERT( i < N || i < size() && "StaticVector<>: out of range" );
+            BOOST_ASSERT( i < size() && "StaticVector<>: out of range" );
             return *to_object(i);
         }
         
-        const_reference operator[](max_size_type i) const 
+        BOOST_STATIC_VECTOR_CONSTEXPR const_reference operator[](max_size_type i) const 
         {     
-            BOOST_ASSERT( i < N || i < size() && "StaticVector<>: out of range" );
+            BOOST_ASSERT( i < size() && "StaticVector<>: out of range" );
             return *to_object(i); 
         }
 
         // at() with range check
-        reference at(max_size_type i) { rangecheck(i); return *to_object(i); }
-        const_reference at(max_size_type i) const { rangecheck(i); return *to_object(i); }
+        BOOST_STATIC_VECTOR_CONSTEXPR reference at(max_size_type i) { rangecheck(i); return *to_object(i); }
+        BOOST_STATIC_VECTOR_CONSTEXPR const_reference at(max_size_type i) const { rangecheck(i); return *to_object(i); }
     
         // front() and back()
-        reference front() 
+        BOOST_STATIC_VECTOR_CONSTEXPR reference front() 
         { 
-            return begin(); 
+            return *begin(); 
         }
         
-        const_reference front() const 
+        BOOST_STATIC_VECTOR_CONSTEXPR const_reference front() const 
         {
-            return begin();
+            return *begin();
         }
         
-        reference back() 
+        BOOST_STATIC_VECTOR_CONSTEXPR reference back() 
         { 
             return *to_object(size()-1);
         }
         
-        const_reference back() const 
+        BOOST_STATIC_VECTOR_CONSTEXPR const_reference back() const 
         { 
             return *to_object(size()-1);
         }
 
         // capacity is constant, size varies
-        inline max_size_type size() const { return m_size; }
-        inline static max_size_type capacity() { return N; }
-        bool empty() { return size() == 0; }
-        bool full() { return size() >= capacity(); }
-        static max_size_type max_size() { return N; }
+        BOOST_STATIC_VECTOR_CONSTEXPR inline max_size_type size() const { return m_size; }
+        BOOST_STATIC_VECTOR_CONSTEXPR inline static max_size_type capacity() { return N; }
+        BOOST_STATIC_VECTOR_CONSTEXPR bool empty() const { return size() == 0; }
+        BOOST_STATIC_VECTOR_CONSTEXPR bool full() const { return size() >= capacity(); }
+        BOOST_STATIC_VECTOR_CONSTEXPR static max_size_type max_size() { return N; }
         enum { static_size = N };
 
-        // swap (note: linear complexity)
-        void swap (StaticVector<T,N>& y) {
-#if ((BOOST_VERSION / 100) % 1000) > 44
-            for (size_type i = 0; i < N; ++i)
-                boost::swap(*to_object(i),*y.to_object(i));
-            boost::swap(m_size,y.m_size);
-#else
-            std::swap_ranges(begin(),end(),y.begin());
-            std::swap(m_size,y.m_size);
-#endif
+        // swap (note: linear in the larger of the two sizes, slots past both sizes are never touched)
+        void swap (StaticVector& y) {
+            swap_impl(y,is_trivially_relocatable<T>());
         }
 
         // direct access to data (read-only)
-        const_pointer data() const { return elems; }
-        pointer data() { return elems; }
+        BOOST_STATIC_VECTOR_CONSTEXPR const_pointer data() const { return to_object(0); }
+        BOOST_STATIC_VECTOR_CONSTEXPR pointer data() { return to_object(0); }
 
         // use array as C array (direct read/write access to data)
-        pointer c_array() { return elems; }
+        BOOST_STATIC_VECTOR_CONSTEXPR pointer c_array() { return to_object(0); }
+
+        // Stable layout: for trivially copyable T (see has_stable_layout) a StaticVector is a
+        // standard layout block holding m_size at offset 0 and the N element slots at
+        // elems_offset(), with no pointers. Its bytes can be written to disk or shared memory
+        // and used in place by a process with the same size_type, T, endianness and ABI
+        // (see StaticVectorView.hpp and StaticVectorSerialization.hpp).
+        enum { has_stable_layout = boost::has_trivial_copy<T>::value && boost::has_trivial_destructor<T>::value };
+        static std::size_t size_offset() { return offsetof(StaticVector, m_size); }
+        static std::size_t elems_offset() { return offsetof(StaticVector, elems); }
+
+        BOOST_STATIC_VECTOR_CONSTEXPR StaticVector& operator= (const StaticVector& rhs) {
+            if(this != &rhs){
+              StatsPolicy::copy();
+              assign_range(rhs.begin(),rhs.end(),rhs.size());
+            }
+            return *this;
+        }
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+        // rhs keeps its size, but its elements are left in a moved-from state
+        BOOST_STATIC_VECTOR_CONSTEXPR StaticVector& operator= (StaticVector&& rhs)
+          BOOST_NOEXCEPT_IF(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value) {
+            if(this != &rhs){
+              size_type n = (std::min)(size(),rhs.size());
+              move_impl(rhs.begin(),rhs.begin()+n,begin());
+              if(rhs.size() > size()){
+                uninitialized_move_impl(rhs.begin()+n,rhs.end(),end());
+              } else {
+                destroy_range(begin()+n,end());
+              }
+              m_size = rhs.size();
+              grown();
+            }
+            return *this;
+        }
+#endif
 
         // assignment with type conversion
         template <typename T2>
-        StaticVector<T,N>& operator= (const StaticVector<T2,N>& rhs) {
-            copy_impl(rhs.begin(),rhs.end(), begin());
-            m_size = rhs.size();
+        BOOST_STATIC_VECTOR_CONSTEXPR StaticVector& operator= (const StaticVector<T2,N>& rhs) {
+            StatsPolicy::copy();
+            assign_range(rhs.begin(),rhs.end(),rhs.size());
             return *this;
         }
 
         // assign one value to all elements
-        void assign (const T& value) { fill ( value ); }    // A synonym for fill
-        void fill   (const T& value)
+        BOOST_STATIC_VECTOR_CONSTEXPR void assign (const T& value) { fill ( value ); }    // A synonym for fill
+        BOOST_STATIC_VECTOR_CONSTEXPR void fill   (const T& value)
         {
-            // TODO: figure out where this came from and why this was here initially
-            //assign_impl(begin(),end(),value);
           std::fill(begin(),end(),value);
         }
 
         // check range (may not be private because it is not static)
-        // throws on failure
-        // returns: 0 on success, 1 otherwise when exceptions are disabled
-        bool rangecheck (max_size_type i) {
+        // fails through the error policy, which throws by default
+        // returns: 0 on success, 1 otherwise when the policy does not throw
+        BOOST_STATIC_VECTOR_CONSTEXPR bool rangecheck (max_size_type i) const {
           bool failure(i >= size());
           if (failure) {
-              std::out_of_range e("StaticVector<>: index out of range");
-              BOOST_THROW_EXCEPTION(e);
+              ErrorPolicy::out_of_range(i,size());
           }
           return failure;
         }
 
 private:
        // check capacity (may be private because it is static)
-      inline static bool capacitycheck (max_size_type i) {
-         bool failure(i > N);
+       // returns: 0 on success, 1 when the error policy did not throw and the operation is to be dropped
+      BOOST_STATIC_VECTOR_CONSTEXPR inline static bool capacitycheck (std::size_t i) {
+         bool failure(capacity_exceeded(i));
          if (failure) {
-            std::out_of_range e("StaticVector<>: index out of capacity");
-            BOOST_THROW_EXCEPTION(e);
+            ErrorPolicy::overflow(i,N);
          }
          return failure;
        }
+
+       // the check itself, without the error policy; only a failed check is recorded,
+       // growth is recorded by grown() once the size has changed
+      BOOST_STATIC_VECTOR_CONSTEXPR inline static bool capacity_exceeded (std::size_t i) {
+         if (i > N) {
+            StatsPolicy::overflow(i,N);
+            return true;
+         }
+         return false;
+       }
+
+       // records the size reached after elements were added
+      BOOST_STATIC_VECTOR_CONSTEXPR inline void grown () const {
+         StatsPolicy::grow(size(),N);
+       }
        
-       inline const_pointer to_object(size_type index) const {
-           return reinterpret_cast<const_pointer>(elems+index);
+       BOOST_STATIC_VECTOR_CONSTEXPR inline const_pointer to_object(size_type index) const {
+           return elems.slot(index);
        }
        
-       inline pointer to_object(size_type index) {
-           return reinterpret_cast<pointer>(elems+index);
+       BOOST_STATIC_VECTOR_CONSTEXPR inline pointer to_object(size_type index) {
+           return elems.slot(index);
+       }
+       
+       // placement new, or std::construct_at while the compiler evaluates a constant expression
+       template<typename... Args>
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static void construct(pointer p, Args&&... args) {
+#if BOOST_STATIC_VECTOR_HAS_CONSTEXPR
+           std::construct_at(p, std::forward<Args>(args)...);
+#else
+           new (p) T(std::forward<Args>(args)...);
+#endif
+       }
+       
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static void uninitialized_fill_impl(iterator first, size_type n, const_reference x) {
+           if(detail::static_vector_constant_evaluated()){
+             // the slots already hold value-initialized objects, see detail::static_vector_storage
+             std::fill_n(first,n,x);
+           } else {
+             std::uninitialized_fill_n(first,n,x);
+           }
        }
        
        // T has a trivial destructor, do nothing
-       inline void destroy_array(const boost::true_type&) {}
+       BOOST_STATIC_VECTOR_CONSTEXPR inline void destroy_array(const boost::true_type&) {}
        
        // T has a destructor, destroy each object 
-       inline void destroy_array(const boost::false_type& ) {
-           for(iterator first = begin(); first != end(); ++first) {
+       BOOST_STATIC_VECTOR_CONSTEXPR inline void destroy_array(const boost::false_type& ) {
+           destroy_range(begin(),end());
+       }
+       
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static void destroy_range(iterator /*first*/, iterator /*last*/, const boost::true_type&) {}
+       
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static void destroy_range(iterator first, iterator last, const boost::false_type&) {
+           for(; first != last; ++first) {
               first->~T();
            }
        }
        
-       template< class InputIterator>
-       inline iterator erase_impl( InputIterator begin, InputIterator end, std::random_access_iterator_tag )
-       {
-         return erase_rai(begin,end, boost::has_trivial_assign<T>());
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static void destroy_range(iterator first, iterator last) {
+           destroy_range(first,last,::boost::has_trivial_destructor<T>());
        }
-       template< class InputIterator>
-       inline iterator erase_impl( InputIterator begin, InputIterator end, boost::random_access_traversal_tag )
-       {
-         return erase_rai(begin,end, boost::has_trivial_assign<T>());
+       
+       // T has a trivial default constructor, default-initialization leaves the slots alone
+       inline static void default_init_range(iterator /*first*/, size_type /*n*/, const boost::true_type&) {}
+       
+       // default-initialize n elements in raw storage at first, destroying them again if one throws
+       inline static void default_init_range(iterator first, size_type n, const boost::false_type&) {
+          size_type i = 0;
+          BOOST_TRY {
+            for(; i < n; ++i){
+              new (first+i) T;
+            }
+          } BOOST_CATCH(...) {
+            destroy_range(first,first+i);
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
        }
        
-       template< class InputIterator>
-       inline iterator erase_impl( InputIterator begin, InputIterator end, boost::single_pass_traversal_tag )
-       {
-         return erase_spt(begin,end, boost::has_trivial_assign<T>());
-       } 
+       // opens a one element gap at pos and moves x into it
+       BOOST_STATIC_VECTOR_CONSTEXPR iterator insert_moved(iterator pos, reference x){
+          if(capacitycheck(size()+1)){
+            return pos;
+          }
+          return insert_moved_unchecked(pos,x);
+       }
+
+       BOOST_STATIC_VECTOR_CONSTEXPR iterator insert_moved_unchecked(iterator pos, reference x){
+          if(pos != end()){
+            StatsPolicy::middle_insert();
+          }
+          iterator it = insert_moved(pos,x,is_trivially_relocatable<T>());
+          grown();
+          return it;
+       }
        
-       // erase_rai = erase_random_access_iterator
-       template< class InputIterator>
-       inline iterator erase_rai( const_iterator  first, const_iterator last, const boost::true_type& )
-       {
-         // TODO: have this function work for random access with trivial destructor
-          difference_type n = last-first;
-      	  BOOST_ASSERT(!rangecheck(size()-n));
-      	  copy_impl(last,end(),first);
-      	  m_size -= n;
-      	  return first;
-       } // T has a trivial destructor, do nothing to objects
-       
-        // erase_rai = erase_random_access_iterator
-       template< class InputIterator, bool b >
-       inline iterator erase_rai( InputIterator first, InputIterator last, 
-                             iterator result, const boost::integral_constant<bool, b>& )
-       {
-          // TODO: have this function work for random access with real destructor
-      	  BOOST_ASSERT(!rangecheck(size()-(last-first)));
-      	  for(iterator it = first; first!=last; ++first){
-      	    it->~T();
-      	  }
-      	  copy_impl(last,end(),first);
-      	  m_size -= (last-first);
-       }
-       
-       template< class InputIterator, bool b>
-       inline iterator erase_spt( InputIterator first, InputIterator last, boost::true_type&){
-         // TODO: have this function work for single pass traversal with trivial destructor
-          difference_type n = last-first;
-       	  BOOST_ASSERT(!rangecheck(size()-n));
-      	  copy_impl(last,end(),first);
-      	  m_size -= n;
-      	  return first;
-       } // T has a trivial destructor, do nothing to objects
-       
-       template< class InputIterator, bool b>
-       inline iterator erase_spt( InputIterator first, InputIterator last, boost::false_type&){
-          iterator front = first;
-          iterator back = last;
-          // TODO: have this function work for single pass traversal with real destructor
-          difference_type n = last-first;
-          BOOST_ASSERT(!rangecheck(size()-n));
-      	  // move the back of the list up front
-      	  for(; first!=last && back!=end(); ++first, ++back){
-      	    front = back;
-      	    back->~T();
-      	    m_size--;
-      	  }
-      	  // erase remaining elements
-      	  for(; front!=last; ++front){
-      	    front->~T();
-      	    m_size--;
-      	  }
-      	  return first;
+       // T is relocatable, memmove the tail up by one and construct x in the gap
+       BOOST_STATIC_VECTOR_CONSTEXPR iterator insert_moved(iterator pos, reference x, const boost::true_type&){
+          relocate(pos,end(),pos+1);
+          BOOST_TRY {
+            construct(pos,std::move(x));
+          } BOOST_CATCH(...) {
+            relocate(pos+1,end()+1,pos);
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+          m_size++;
+          return pos;
+       }
+       
+       // T must be moved one element at a time
+       BOOST_STATIC_VECTOR_CONSTEXPR iterator insert_moved(iterator pos, reference x, const boost::false_type&){
+          if(pos == end()){
+            construct(end(),std::move(x));
+            m_size++;
+          } else {
+            iterator old_end = end();
+            construct(old_end,std::move(*(old_end-1)));
+            m_size++;
+            move_backward_impl(pos,old_end-1,old_end);
+            *pos = std::move(x);
+          }
+          return pos;
+       }
+       
+       // T is relocatable, memmove the tail up by n and fill the gap
+       BOOST_STATIC_VECTOR_CONSTEXPR void insert_fill(iterator pos, size_type n, const_reference x, const boost::true_type&){
+          relocate(pos,end(),pos+n);
+          BOOST_TRY {
+            uninitialized_fill_impl(pos,n,x);
+          } BOOST_CATCH(...) {
+            relocate(pos+n,end()+n,pos);
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+          m_size+=n;
+          grown();
+       }
+       
+       BOOST_STATIC_VECTOR_CONSTEXPR void insert_fill(iterator pos, size_type n, const_reference x, const boost::false_type&){
+          iterator old_end = end();
+          size_type elems_after = old_end-pos;
+          if(elems_after > n){
+            uninitialized_move_impl(old_end-n,old_end,old_end);
+            m_size+=n;
+            move_backward_impl(pos,old_end-n,old_end);
+            std::fill(pos,pos+n,x);
+          } else {
+            uninitialized_fill_impl(old_end,n-elems_after,x);
+            m_size+=n-elems_after;
+            uninitialized_move_impl(pos,old_end,end());
+            m_size+=elems_after;
+            std::fill(pos,old_end,x);
+          }
+          grown();
        }
        
+       // two integers, the count and value overload was meant
+       template<class Integer>
+       BOOST_STATIC_VECTOR_CONSTEXPR void append_dispatch(Integer n, Integer value, const boost::true_type&){
+          if(capacitycheck(size()+static_cast<std::size_t>(n))){
+            return;
+          }
+          unchecked_append_n(static_cast<max_size_type>(n),static_cast<value_type>(value));
+       }
+       
+       template<class InputIterator>
+       BOOST_STATIC_VECTOR_CONSTEXPR void append_dispatch(InputIterator first, InputIterator last, const boost::false_type&){
+          append_range(first,last,typename boost::iterator_category<InputIterator>::type());
+       }
+       
+       // single pass, the length is unknown until the end, so check the capacity for each element
+       // and remove the appended elements again on failure
+       template<class InputIterator>
+       BOOST_STATIC_VECTOR_CONSTEXPR void append_range(InputIterator first, InputIterator last, std::input_iterator_tag){
+          size_type old_size = size();
+          BOOST_TRY {
+            for(; first != last; ++first){
+              if(capacitycheck(size()+1)){
+                erase(begin()+old_size,end());
+                return;
+              }
+              unchecked_push_back(*first);
+            }
+          } BOOST_CATCH(...) {
+            erase(begin()+old_size,end());
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+       }
+       
+       // multi pass, measure once, then construct in place
+       template<class ForwardIterator>
+       BOOST_STATIC_VECTOR_CONSTEXPR void append_range(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag){
+          std::size_t n = std::distance(first,last);
+          if(capacitycheck(size()+n)){
+            return;
+          }
+          append_constructed(first,last,n);
+       }
+       
+       // [first,last) holds n elements that fit, one memcpy for contiguous trivially copyable ranges
+       template<class ForwardIterator>
+       BOOST_STATIC_VECTOR_CONSTEXPR void append_constructed(ForwardIterator first, ForwardIterator last, std::size_t n){
+          uninitialized_copy_impl(first,last,end());
+          m_size += n;
+          grown();
+       }
+       
+       template<class Integer>
+       BOOST_STATIC_VECTOR_CONSTEXPR void insert_dispatch(iterator pos, Integer n, Integer value, const boost::true_type&){
+          if(capacitycheck(size()+static_cast<std::size_t>(n))){
+            return;
+          }
+          if(pos == end()){
+            unchecked_append_n(static_cast<max_size_type>(n),static_cast<value_type>(value));
+            return;
+          }
+          StatsPolicy::middle_insert();
+          insert_fill(pos,static_cast<size_type>(n),static_cast<value_type>(value),is_trivially_relocatable<T>());
+       }
+       
+       template<class InputIterator>
+       BOOST_STATIC_VECTOR_CONSTEXPR void insert_dispatch(iterator pos, InputIterator first, InputIterator last, const boost::false_type&){
+          insert_range(pos,first,last,typename boost::iterator_category<InputIterator>::type());
+       }
+       
+       // single pass, append the new elements and rotate them into place
+       template<class InputIterator>
+       BOOST_STATIC_VECTOR_CONSTEXPR void insert_range(iterator pos, InputIterator first, InputIterator last, std::input_iterator_tag){
+          size_type offset = pos-begin();
+          size_type old_size = size();
+          append_range(first,last,std::input_iterator_tag());
+          if(offset != old_size && size() != old_size){
+            StatsPolicy::middle_insert();
+            std::rotate(begin()+offset,begin()+old_size,end());
+          }
+       }
+       
+       template<class ForwardIterator>
+       BOOST_STATIC_VECTOR_CONSTEXPR void insert_range(iterator pos, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag){
+          std::size_t n = std::distance(first,last);
+          if(capacitycheck(size()+n)){
+            return;
+          }
+          if(pos == end()){
+            // nothing to shift
+            append_constructed(first,last,n);
+            return;
+          }
+          StatsPolicy::middle_insert();
+          insert_range(pos,first,last,n,is_trivially_relocatable<T>());
+       }
+       
+       // T is relocatable, memmove the tail up by n and copy [first,last) into the gap
        template< class InputIterator>
-       inline static void copy_impl( InputIterator begin, InputIterator end, iterator result, std::random_access_iterator_tag )
-       {
-           copy_rai( begin, end, result, boost::has_trivial_assign<T>() );
+       BOOST_STATIC_VECTOR_CONSTEXPR void insert_range(iterator pos, InputIterator first, InputIterator last, size_type n, const boost::true_type&){
+          relocate(pos,end(),pos+n);
+          BOOST_TRY {
+            uninitialized_copy_impl(first,last,pos);
+          } BOOST_CATCH(...) {
+            relocate(pos+n,end()+n,pos);
+            BOOST_RETHROW;
+          } BOOST_CATCH_END
+          m_size+=n;
+          grown();
        }
+       
        template< class InputIterator>
-       inline static void copy_impl( InputIterator begin, InputIterator end, iterator result, boost::random_access_traversal_tag )
-       {
-           copy_rai( begin, end, result, boost::has_trivial_assign<T>() );
+       BOOST_STATIC_VECTOR_CONSTEXPR void insert_range(iterator pos, InputIterator first, InputIterator last, size_type n, const boost::false_type&){
+          iterator old_end = end();
+          size_type elems_after = old_end-pos;
+          if(elems_after > n){
+            uninitialized_move_impl(old_end-n,old_end,old_end);
+            m_size+=n;
+            move_backward_impl(pos,old_end-n,old_end);
+            std::copy(first,last,pos);
+          } else {
+            InputIterator mid = first;
+            std::advance(mid,elems_after);
+            uninitialized_copy_impl(mid,last,old_end);
+            m_size+=n-elems_after;
+            uninitialized_move_impl(pos,old_end,end());
+            m_size+=elems_after;
+            std::copy(first,mid,pos);
+          }
+          grown();
        }
        
-       inline static void copy_rai( const_iterator  begin, const_iterator end, 
-                             iterator result, const boost::true_type& )
-       {
-           std::memcpy( result, begin, sizeof(T) * std::distance(begin,end) );
+       // T is relocatable, destroy [first,last) and memmove the tail down over it
+       BOOST_STATIC_VECTOR_CONSTEXPR iterator erase_shift(iterator first, iterator last, const boost::true_type&){
+          destroy_range(first,last);
+          relocate(last,end(),first);
+          m_size -= last-first;
+          return first;
        }
        
-       template< class InputIterator, bool b >
-       inline static void copy_rai( InputIterator begin, InputIterator end, 
-                             iterator result, const boost::integral_constant<bool, b>& )
-       {
-           std::copy( begin, end, result );
-       }        
+       BOOST_STATIC_VECTOR_CONSTEXPR iterator erase_shift(iterator first, iterator last, const boost::false_type&){
+          iterator new_end = move_impl(last,end(),first);
+          destroy_range(new_end,end());
+          m_size -= last-first;
+          return first;
+       }
        
+       // T is relocatable, erased elements are destroyed as they are found and each run of
+       // survivors between them is memmoved down once. first is known to match pred.
+       template<class Predicate>
+       void erase_if_impl(iterator first, Predicate& pred, const boost::true_type&){
+          iterator out = first;         // end of the survivors moved down so far
+          iterator run = first+1;       // first survivor not moved down yet
+          first->~T();
+          iterator it = run;
+          BOOST_TRY {
+            for(; it != end(); ++it){
+              if(pred(*it)){
+                relocate(run,it,out);
+                out += it-run;
+                it->~T();
+                run = it+1;
+              }
+            }
+          } BOOST_CATCH(...) {
+            // *it was not erased, keep it and everything behind it
+            relocate(run,end(),out);
+            m_size = (out-begin()) + (end()-run);
+            BOOST_RETHROW;
+          }
+          BOOST_CATCH_END
+          relocate(run,end(),out);
+          m_size = (out-begin()) + (end()-run);
+       }
+       
+       // survivors are move assigned down like std::remove_if, the moved-from tail is destroyed
+       template<class Predicate>
+       void erase_if_impl(iterator first, Predicate& pred, const boost::false_type&){
+          iterator out = first;
+          for(iterator it = first+1; it != end(); ++it){
+            if(!pred(*it)){
+              *out = boost::move(*it);
+              ++out;
+            }
+          }
+          destroy_range(out,end());
+          m_size = out-begin();
+       }
+       
+       // T is relocatable, destroy *pos and memcpy the last element over it
+       BOOST_STATIC_VECTOR_CONSTEXPR void erase_swap(iterator pos, const boost::true_type&){
+          destroy_range(pos,pos+1);
+          relocate(end()-1,end(),pos);
+          m_size--;
+       }
+       
+       BOOST_STATIC_VECTOR_CONSTEXPR void erase_swap(iterator pos, const boost::false_type&){
+          *pos = boost::move(back());
+          pop_back();
+       }
+       
+       // bitwise move of the objects in [first,last) to result, the source bytes are left as raw storage
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static void relocate(iterator first, iterator last, iterator result){
+          if(detail::static_vector_constant_evaluated()){
+            if(result < first){
+              std::move(first,last,result);
+            } else {
+              std::move_backward(first,last,result+(last-first));
+            }
+          } else {
+            std::memmove(static_cast<void*>(result), static_cast<const void*>(first), sizeof(T) * (last-first));
+          }
+       }
+       
+       // T is relocatable, exchange the bytes of the longer of the two live prefixes
+       void swap_impl(StaticVector& y, const boost::true_type&){
+          std::size_t bytes = sizeof(T) * (std::max)(size(),y.size());
+          unsigned char* lhs = reinterpret_cast<unsigned char*>(to_object(0));
+          unsigned char* rhs = reinterpret_cast<unsigned char*>(y.to_object(0));
+          std::swap_ranges(lhs,lhs+bytes,rhs);
+          std::swap(m_size,y.m_size);
+       }
+       
+       // swap the common prefix, then move the tail of the longer vector into the shorter one
+       void swap_impl(StaticVector& y, const boost::false_type&){
+          StaticVector& shorter = size() < y.size() ? *this : y;
+          StaticVector& longer  = size() < y.size() ? y : *this;
+          iterator common_end = longer.begin() + shorter.size();
+#if ((BOOST_VERSION / 100) % 1000) > 44
+          for (iterator first = shorter.begin(), second = longer.begin(); second != common_end; ++first, ++second)
+              boost::swap(*first,*second);
+#else
+          std::swap_ranges(longer.begin(),common_end,shorter.begin());
+#endif
+          uninitialized_move_impl(common_end,longer.end(),shorter.end());
+          destroy_range(common_end,longer.end());
+          std::swap(m_size,y.m_size);
+       }
+       
+       // assign the n elements of [first,last), reusing the elements already constructed
        template< class InputIterator>
-       inline static void copy_impl( InputIterator begin, InputIterator end, iterator result, boost::single_pass_traversal_tag )
-       {
-           std::copy( begin, end, result );
+       BOOST_STATIC_VECTOR_CONSTEXPR void assign_range(InputIterator first, InputIterator last, std::size_t n){
+          if(capacitycheck(n)){
+            return;
+          }
+          if(n <= size()){
+            iterator new_end = std::copy(first,last,begin());
+            destroy_range(new_end,end());
+          } else {
+            InputIterator mid = first;
+            std::advance(mid,size());
+            std::copy(first,mid,begin());
+            uninitialized_copy_impl(mid,last,end());
+          }
+          m_size = n;
+          grown();
        }
        
+       // true when InputIterator points into contiguous storage of T that may be copied bytewise
+       template< class InputIterator>
+       struct is_memcpy_source : boost::integral_constant<bool,
+           ( boost::is_same<InputIterator,iterator>::value || boost::is_same<InputIterator,const_iterator>::value
+#if BOOST_STATIC_VECTOR_HAS_CONTIGUOUS_ITERATORS
+             || ( std::contiguous_iterator<InputIterator>
+                  && boost::is_same<typename boost::remove_cv<std::iter_value_t<InputIterator> >::type, T>::value )
+#endif
+           ) && boost::has_trivial_copy<T>::value > {};
+       
        template< class InputIterator>
-       inline static void copy_impl( InputIterator begin, InputIterator end, iterator result )
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static iterator uninitialized_copy_impl( InputIterator begin, InputIterator end, iterator result )
        {
-           copy_impl( begin, end, result, typename boost::iterator_category<InputIterator>::type() );
+           return uninitialized_copy_impl( begin, end, result, is_memcpy_source<InputIterator>() );
        }
        
-       template< class InputIterator>
-       inline static void copy_backward_impl( InputIterator begin, InputIterator end, iterator result, std::random_access_iterator_tag )
+       template< class ContiguousIterator>
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static iterator uninitialized_copy_impl( ContiguousIterator begin, ContiguousIterator end, 
+                             iterator result, const boost::true_type& )
        {
-           copy_backward_rai( begin, end, result, boost::has_trivial_assign<T>() );
+           if(detail::static_vector_constant_evaluated()){
+             return std::copy( begin, end, result );
+           }
+           std::size_t n = end-begin;
+           if(n){
+             std::memcpy( static_cast<void*>(result), static_cast<const void*>(detail::static_vector_to_address(begin)), sizeof(T) * n );
+           }
+           return result + n;
        }
        
        template< class InputIterator>
-       inline static void copy_backward_impl( InputIterator begin, InputIterator end, iterator result, boost::random_access_traversal_tag )
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static iterator uninitialized_copy_impl( InputIterator begin, InputIterator end, 
+                             iterator result, const boost::false_type& )
        {
-           copy_backward_rai( begin, end, result, boost::has_trivial_assign<T>() );
+           if(detail::static_vector_constant_evaluated()){
+             return std::copy( begin, end, result );
+           }
+           return std::uninitialized_copy( begin, end, result );
        }
        
-       template< class InputIterator>
-       inline static void copy_backward_rai( iterator begin, iterator end, 
+       // memcpy may stand in for move construction only if neither the copy nor the move constructor is user-provided
+       typedef boost::integral_constant<bool, boost::has_trivial_copy<T>::value
+                                              && boost::has_trivial_move_constructor<T>::value> has_trivial_move_constructor;
+
+       // move construct [begin,end) into raw storage starting at result
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static iterator uninitialized_move_impl( iterator begin, iterator end, iterator result )
+       {
+           return uninitialized_move_impl( begin, end, result, has_trivial_move_constructor() );
+       }
+       
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static iterator uninitialized_move_impl( iterator begin, iterator end, 
                              iterator result, const boost::true_type& )
        {
-           std::memmove( result, begin, sizeof(T) * std::distance(begin,end) );
+           if(detail::static_vector_constant_evaluated()){
+             return std::copy( begin, end, result );
+           }
+           std::memcpy( static_cast<void*>(result), static_cast<const void*>(begin), sizeof(T) * std::distance(begin,end) );
+           return result + (end-begin);
+       }
+       
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static iterator uninitialized_move_impl( iterator begin, iterator end, 
+                             iterator result, const boost::false_type& )
+       {
+           if(detail::static_vector_constant_evaluated()){
+             return std::move( begin, end, result );
+           }
+           return boost::uninitialized_move( begin, end, result );
        }
        
-       template< class InputIterator, bool b >
-       inline static void copy_backward_rai( InputIterator begin, InputIterator end, 
-                             iterator result, const boost::integral_constant<bool, b>& )
+       // memmove may stand in for move assignment only if neither the copy nor the move assignment is user-provided
+       typedef boost::integral_constant<bool, boost::has_trivial_assign<T>::value
+                                              && boost::has_trivial_move_assign<T>::value> has_trivial_move_assign;
+
+       // move assign [begin,end) onto the constructed elements starting at result, ranges may overlap if result <= begin
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static iterator move_impl( iterator begin, iterator end, iterator result )
        {
-           detail::copy_backward( begin, end, result );
+           return move_impl( begin, end, result, has_trivial_move_assign() );
        }
        
-       template< class InputIterator>
-       inline static void copy_backward_impl( InputIterator begin, InputIterator end, iterator result, boost::single_pass_traversal_tag )
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static iterator move_impl( iterator begin, iterator end, 
+                             iterator result, const boost::true_type& )
        {
-           detail::copy_backward( begin, end, result );
+           if(detail::static_vector_constant_evaluated()){
+             return std::move( begin, end, result );
+           }
+           std::memmove( static_cast<void*>(result), static_cast<const void*>(begin), sizeof(T) * std::distance(begin,end) );
+           return result + (end-begin);
        }
        
-       template< class InputIterator>
-       inline static void copy_backward_impl( InputIterator begin, InputIterator end, iterator result )
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static iterator move_impl( iterator begin, iterator end, 
+                             iterator result, const boost::false_type& )
        {
-           copy_backward_impl( begin, end, result, typename boost::iterator_category<InputIterator>::type() );
+           if(detail::static_vector_constant_evaluated()){
+             return std::move( begin, end, result );
+           }
+           return boost::move( begin, end, result );
        }
        
-       template< class InputIterator>
-       inline static void assign_impl( InputIterator begin, InputIterator end, iterator  result )
+       // move assign [begin,end) onto the constructed elements ending at result, ranges may overlap if result >= end
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static iterator move_backward_impl( iterator begin, iterator end, iterator result )
        {
-           assign_impl( begin, end, result, boost::has_trivial_assign<T>() );
+           return move_backward_impl( begin, end, result, has_trivial_move_assign() );
        }
        
-       template< class InputIterator>
-       inline static void assign_impl( InputIterator begin, InputIterator end, iterator  result, const boost::true_type& )
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static iterator move_backward_impl( iterator begin, iterator end, 
+                             iterator result, const boost::true_type& )
        {
-           std::memcpy( result, begin, sizeof(T) * std::distance(begin,end) ); 
+           if(detail::static_vector_constant_evaluated()){
+             return std::move_backward( begin, end, result );
+           }
+           std::memmove( static_cast<void*>(result-(end-begin)), static_cast<const void*>(begin), sizeof(T) * std::distance(begin,end) );
+           return result - (end-begin);
        }
        
-       template< class InputIterator>
-       inline static void assign_impl( InputIterator begin, InputIterator end, iterator  result, const boost::false_type& )
+       BOOST_STATIC_VECTOR_CONSTEXPR inline static iterator move_backward_impl( iterator begin, iterator end, 
+                             iterator result, const boost::false_type& )
        {
-           for( ; begin != end; ++begin, ++result )
-               *result = *begin;
+           if(detail::static_vector_constant_evaluated()){
+             return std::move_backward( begin, end, result );
+           }
+           return boost::move_backward( begin, end, result );
        }
 }; // class StaticVector
 
 #if !defined(BOOST_NO_TEMPLATE_PARTIAL_SPECIALIZATION)
-    template< class T >
-    class StaticVector< T, 0 , typename boost::uint_value_t<0>::least> {
+    template< class T, class StatsPolicy, class ErrorPolicy >
+    class StaticVector< T, 0 , typename boost::uint_value_t<0>::least, StatsPolicy, ErrorPolicy > {
 
       public:
         // type definitions
@@ -635,6 +1419,19 @@ private:
           failed_rangecheck();
         }
 
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+        template<typename... Args>
+        reference emplace_back (Args&&...){
+          return failed_rangecheck();
+        }
+
+        template<typename... Args>
+        iterator emplace (iterator, Args&&...){
+          failed_rangecheck();
+          return begin();
+        }
+#endif
+
         void pop_back(){
           failed_rangecheck();
         }
@@ -660,6 +1457,15 @@ private:
           return failed_rangecheck();
         }
 
+        template<class Predicate>
+        size_type erase_if(Predicate){
+          return 0;
+        }
+
+        iterator unordered_erase(iterator pos){
+          return failed_rangecheck();
+        }
+
         void clear(){
         }
 
@@ -714,7 +1520,7 @@ private:
         inline static max_size_type max_size() { return 0; }
         enum { static_size = 0 };
 
-        void swap (StaticVector<T,0>& /*y*/) {
+        void swap (StaticVector& /*y*/) {
         }
 
         // direct access to data (read-only)
@@ -726,7 +1532,7 @@ private:
 
         // assignment with type conversion
         template <typename T2>
-        StaticVector<T,0>& operator= (const StaticVector<T2,0>& ) {
+        StaticVector& operator= (const StaticVector<T2,0>& ) {
             return *this;
         }
 
@@ -736,8 +1542,7 @@ private:
         
         // check range (may be private because it is static)
         static reference failed_rangecheck () {
-                std::out_of_range e("attempt to access element of an empty StaticVector");
-                BOOST_THROW_EXCEPTION(e);
+                ErrorPolicy::out_of_range(0,0);
 #if defined(BOOST_NO_EXCEPTIONS) || !defined(BOOST_MSVC)
                 //
                 // We need to return something here to keep
@@ -751,35 +1556,79 @@ private:
     };
 #endif
 
-    // comparisons
-    template<class T, std::size_t N>
-    bool operator== (const StaticVector<T,N>& x, const StaticVector<T,N>& y) {
-        return std::equal(x.begin(), x.end(), y.begin());
+    // comparisons, vectorized for arithmetic T (see StaticVectorSimd.hpp)
+    template<class T, std::size_t N, typename S, class P, class E>
+    BOOST_STATIC_VECTOR_CONSTEXPR bool operator== (const StaticVector<T,N,S,P,E>& x, const StaticVector<T,N,S,P,E>& y) {
+        if(detail::static_vector_constant_evaluated()){
+          return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+        }
+        return x.size() == y.size() && detail::simd::equal(x.begin(), y.begin(), x.size());
     }
-    template<class T, std::size_t N>
-    bool operator< (const StaticVector<T,N>& x, const StaticVector<T,N>& y) {
-        return std::lexicographical_compare(x.begin(),x.end(),y.begin(),y.end());
+    template<class T, std::size_t N, typename S, class P, class E>
+    BOOST_STATIC_VECTOR_CONSTEXPR bool operator< (const StaticVector<T,N,S,P,E>& x, const StaticVector<T,N,S,P,E>& y) {
+        if(detail::static_vector_constant_evaluated()){
+          return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+        }
+        return detail::simd::less(x.begin(), x.size(), y.begin(), y.size());
     }
-    template<class T, std::size_t N>
-    bool operator!= (const StaticVector<T,N>& x, const StaticVector<T,N>& y) {
+    template<class T, std::size_t N, typename S, class P, class E>
+    BOOST_STATIC_VECTOR_CONSTEXPR bool operator!= (const StaticVector<T,N,S,P,E>& x, const StaticVector<T,N,S,P,E>& y) {
         return !(x==y);
     }
-    template<class T, std::size_t N>
-    bool operator> (const StaticVector<T,N>& x, const StaticVector<T,N>& y) {
+    template<class T, std::size_t N, typename S, class P, class E>
+    BOOST_STATIC_VECTOR_CONSTEXPR bool operator> (const StaticVector<T,N,S,P,E>& x, const StaticVector<T,N,S,P,E>& y) {
         return y<x;
     }
-    template<class T, std::size_t N>
-    bool operator<= (const StaticVector<T,N>& x, const StaticVector<T,N>& y) {
+    template<class T, std::size_t N, typename S, class P, class E>
+    BOOST_STATIC_VECTOR_CONSTEXPR bool operator<= (const StaticVector<T,N,S,P,E>& x, const StaticVector<T,N,S,P,E>& y) {
         return !(y<x);
     }
-    template<class T, std::size_t N>
-    bool operator>= (const StaticVector<T,N>& x, const StaticVector<T,N>& y) {
+    template<class T, std::size_t N, typename S, class P, class E>
+    BOOST_STATIC_VECTOR_CONSTEXPR bool operator>= (const StaticVector<T,N,S,P,E>& x, const StaticVector<T,N,S,P,E>& y) {
         return !(x<y);
     }
 
+    // searching, vectorized for arithmetic T (see StaticVectorSimd.hpp)
+    template<class T, std::size_t N, typename S, class P, class E>
+    typename StaticVector<T,N,S,P,E>::iterator find (StaticVector<T,N,S,P,E>& x, const T& value) {
+        return x.begin() + detail::simd::find(x.begin(), x.size(), value);
+    }
+    template<class T, std::size_t N, typename S, class P, class E>
+    typename StaticVector<T,N,S,P,E>::const_iterator find (const StaticVector<T,N,S,P,E>& x, const T& value) {
+        return x.begin() + detail::simd::find(x.begin(), x.size(), value);
+    }
+    template<class T, std::size_t N, typename S, class P, class E>
+    std::size_t count (const StaticVector<T,N,S,P,E>& x, const T& value) {
+        return detail::simd::count(x.begin(), x.size(), value);
+    }
+    template<class T, std::size_t N, typename S, class P, class E>
+    bool contains (const StaticVector<T,N,S,P,E>& x, const T& value) {
+        return detail::simd::find(x.begin(), x.size(), value) != x.size();
+    }
+    // first smallest and largest element, end() if x is empty
+    template<class T, std::size_t N, typename S, class P, class E>
+    typename StaticVector<T,N,S,P,E>::const_iterator min_element (const StaticVector<T,N,S,P,E>& x) {
+        return x.begin() + detail::simd::min_element(x.begin(), x.size());
+    }
+    template<class T, std::size_t N, typename S, class P, class E>
+    typename StaticVector<T,N,S,P,E>::const_iterator max_element (const StaticVector<T,N,S,P,E>& x) {
+        return x.begin() + detail::simd::max_element(x.begin(), x.size());
+    }
+
+    // erase the elements equal to value or matching pred in one pass, as std::erase and std::erase_if.
+    // Returns the number erased. Erasing a value compacts arithmetic T with vector compares.
+    template<class T, std::size_t N, typename S, class P, class E>
+    std::size_t erase (StaticVector<T,N,S,P,E>& x, const T& value) {
+        return detail::static_vector_erase_value(x, value, detail::simd::is_vectorized<T>());
+    }
+    template<class T, std::size_t N, typename S, class P, class E, class Predicate>
+    std::size_t erase_if (StaticVector<T,N,S,P,E>& x, Predicate pred) {
+        return x.erase_if(pred);
+    }
+
     // global swap()
-    template<class T, std::size_t N>
-    inline void swap (StaticVector<T,N>& x, StaticVector<T,N>& y) {
+    template<class T, std::size_t N, typename S, class P, class E>
+    inline void swap (StaticVector<T,N,S,P,E>& x, StaticVector<T,N,S,P,E>& y) {
         x.swap(y);
     }
 
@@ -796,32 +1645,32 @@ private:
        };
     }
     
-   // Specific for boost::StaticVector: simply returns its elems data member.
+   // Specific for boost::StaticVector: returns its element storage as an array of all N slots.
    template <typename T, std::size_t N>
    typename detail::c_array<T,N>::type& get_c_array(boost::StaticVector<T,N>& arg)
    {
-       return arg.elems;
+       return *reinterpret_cast<typename detail::c_array<T,N>::type*>(arg.data());
    }
 
-   // Specific for boost::StaticVector: simply returns its elems data member.
+   // Specific for boost::StaticVector: returns its element storage as an array of all N slots.
    template <typename T, std::size_t N>
    typename const detail::c_array<T,N>::type& get_c_array(const boost::StaticVector<T,N>& arg)
    {
-       return arg.elems;
+       return *reinterpret_cast<const typename detail::c_array<T,N>::type*>(arg.data());
    }
 #else
-// Specific for boost::StaticVector: simply returns its elems data member.
+// Specific for boost::StaticVector: returns its element storage as an array of all N slots.
     template <typename T, std::size_t N>
     T(&get_c_array(boost::StaticVector<T,N>& arg))[N]
     {
-        return arg.elems;
+        return *reinterpret_cast<T(*)[N]>(arg.data());
     }
     
     // Const version.
     template <typename T, std::size_t N>
     const T(&get_c_array(const boost::StaticVector<T,N>& arg))[N]
     {
-        return arg.elems;
+        return *reinterpret_cast<const T(*)[N]>(arg.data());
     }
 #endif
     
@@ -0,0 +1,86 @@
+/**
+ *  @file   StaticVectorConstexprTests.cpp
+ *  @brief  StaticVectorConstexprTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticVector is not accepted as part of boost.
+ *
+ *  The constant expressions are only checked when compiled as C++20,
+ *  e.g. with -DSTATIC_VECTOR_CXX20=ON.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <StaticVector.hpp>
+#include <algorithm>
+using namespace boost;
+
+#if BOOST_STATIC_VECTOR_HAS_CONSTEXPR
+
+namespace {
+  struct Field {
+    int id;
+    int width;
+  };
+
+  constexpr bool operator==(const Field& lhs, const Field& rhs){
+    return lhs.id == rhs.id && lhs.width == rhs.width;
+  }
+
+  constexpr StaticVector<int,8> make_sorted(){
+    StaticVector<int,8> v;
+    v.push_back(5);
+    v.push_back(3);
+    v.emplace_back(9);
+    v.insert(v.begin(),7);
+    v.insert(v.begin()+1,2u,1);
+    v.erase(v.begin()+2);
+    std::sort(v.begin(),v.end());
+    return v;
+  }
+
+  constexpr int sum(const StaticVector<int,8>& v){
+    int total = 0;
+    for(int x : v){
+      total += x;
+    }
+    return total;
+  }
+
+  // a descriptor table built once by the compiler and placed in read-only data
+  constexpr StaticVector<Field,16> make_fields(){
+    StaticVector<Field,16> fields;
+    for(int i = 0; i < 6; ++i){
+      fields.push_back(Field{i, 1 << i});
+    }
+    fields.erase(fields.begin()+1,fields.begin()+3);
+    StaticVector<Field,16> copy(fields);
+    copy.resize(5,Field{-1,0});
+    return copy;
+  }
+
+  constexpr StaticVector<int,8> sorted = make_sorted();
+  constexpr StaticVector<Field,16> fields = make_fields();
+
+  static_assert(sorted.size() == 5, "constexpr size");
+  static_assert(sorted[0] == 1 && sorted.front() == 1 && sorted.back() == 9, "constexpr element access");
+  static_assert(std::is_sorted(sorted.begin(),sorted.end()), "constexpr sort");
+  static_assert(sum(sorted) == 1+3+5+7+9, "constexpr iteration");
+  static_assert(sorted == make_sorted() && !(sorted < make_sorted()), "constexpr comparison");
+  static_assert(fields.size() == 5 && fields[1].id == 3 && fields.at(4) == Field{-1,0}, "constexpr erase, copy and resize");
+}
+
+BOOST_AUTO_TEST_CASE(ConstexprTables){
+  BOOST_CHECK_EQUAL(sorted.size(),5u);
+  BOOST_CHECK_EQUAL(sum(sorted),25);
+  StaticVector<int,8> runtime = make_sorted();
+  BOOST_CHECK(runtime == sorted);
+  BOOST_CHECK_EQUAL(fields[2].width,16);
+  BOOST_CHECK_EQUAL(sizeof(fields),sizeof(StaticVector<Field,16>));
+}
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ *  @file   StaticVectorErrorPolicyTests.cpp
+ *  @brief  StaticVectorErrorPolicyTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticVector is not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <StaticVectorSaturate.hpp>
+#include <StaticVectorStats.hpp>
+#include <algorithm>
+#include <sstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+using namespace boost;
+
+namespace {
+  struct Drops {};
+  struct Packets { static const char* name() { return "test packets"; } };
+
+  typedef static_vector_saturate_on_error<Drops> Saturate;
+  typedef StaticVector<int,4,uint_value_t<4>::least,static_vector_no_stats,Saturate> SaturatingVector;
+  typedef StaticVector<std::string,3,uint_value_t<3>::least,static_vector_no_stats,static_vector_assert_on_error> AssertingVector;
+}
+
+BOOST_AUTO_TEST_CASE(SaturateDropsOverflowingOperations){
+  Saturate::reset();
+  SaturatingVector v;
+  for(int i = 0; i < 6; ++i){
+    v.push_back(i);
+  }
+  BOOST_CHECK_EQUAL(v.size(),4u);
+  BOOST_CHECK_EQUAL(v.back(),3);
+  BOOST_CHECK_EQUAL(Saturate::dropped(),2u);
+  
+  // operations that do not fit leave the vector as it was
+  int more[] = {7,8};
+  v.erase(v.begin());
+  v.insert(v.begin(),more,more+2);
+  v.insert(v.begin(),2u,9);
+  v.append(more,more+2);
+  v.resize(5);
+  BOOST_CHECK_EQUAL(v.size(),3u);
+  v.push_back(4);
+  BOOST_CHECK_EQUAL(v.emplace_back(5),4);
+  BOOST_CHECK(v.insert(v.begin(),0) == v.begin());
+  BOOST_CHECK_EQUAL(v.front(),1);
+  
+  // a single pass range is dropped as a whole as well
+  std::istringstream in("5 6");
+  v.pop_back();
+  v.append(std::istream_iterator<int>(in),std::istream_iterator<int>());
+  int expected[] = {1,2,3};
+  BOOST_CHECK_EQUAL(v.size(),3u);
+  BOOST_CHECK(std::equal(v.begin(),v.end(),expected));
+  BOOST_CHECK_EQUAL(Saturate::dropped(),9u);
+  
+  SaturatingVector copy(v);
+  copy.push_back(4);
+  BOOST_CHECK(copy.full());
+  BOOST_CHECK_EQUAL(Saturate::dropped(),9u);
+}
+
+BOOST_AUTO_TEST_CASE(AssertPolicyAllowsSuccessfulOperations){
+  AssertingVector names;
+  names.push_back("a");
+  names.insert(names.begin(),"b");
+  names.append_n(1,"c");
+  BOOST_CHECK(names.full());
+  BOOST_CHECK_EQUAL(names.at(0),"b");
+  BOOST_CHECK(!names.try_push_back("d"));
+  BOOST_CHECK_EQUAL(names.size(),3u);
+}
+
+BOOST_AUTO_TEST_CASE(TryOperationsReportFullVector){
+  typedef StaticVector<std::string,2,uint_value_t<2>::least,static_vector_stats<Packets> > PacketVector;
+  static_vector_counters& c = static_vector_stats<Packets>::counters();
+  c.reset();
+  PacketVector v;
+  BOOST_CHECK(v.try_push_back("a"));
+  std::string b("b");
+  BOOST_CHECK(v.try_insert(v.begin(),b));
+  BOOST_CHECK(!v.try_push_back(std::string("c")));
+  BOOST_CHECK(!v.try_emplace_back(3,'c'));
+  BOOST_CHECK(!v.try_insert(v.begin(),b));
+  BOOST_CHECK_EQUAL(b,"b");
+  BOOST_CHECK_EQUAL(v.size(),2u);
+  BOOST_CHECK_EQUAL(v[0],"b");
+  BOOST_CHECK_EQUAL(c.overflows(),3u);
+  BOOST_CHECK_EQUAL(c.middle_inserts(),1u);
+  
+  // the default policy still throws
+  BOOST_CHECK_THROW(v.push_back("c"),std::out_of_range);
+  BOOST_CHECK_THROW(v.at(2),std::out_of_range);
+  BOOST_CHECK_THROW((StaticVector<int,0>().at(0)),std::out_of_range);
+}
@@ -0,0 +1,450 @@
+/**
+ * @file   StaticVectorParallel.hpp
+ * @brief  Parallel sort, stable_sort, transform, reduce, transform_reduce and partition for large StaticVectors.
+ *
+ * A StaticVector of n elements is cut into k = min(64, n / threshold)
+ * contiguous chunks, which run as tasks on a static_vector_thread_pool; with
+ * k < 2 the serial std algorithm is used. k depends only on n and the
+ * threshold, never on the number of threads, so every result is the same
+ * on every run and every machine:
+ *
+ *   parallel_sort         sorts the chunks, then merges neighbours pairwise in log2(k) rounds
+ *   parallel_stable_sort  the same with std::stable_sort, the merges keep the left chunk first
+ *   parallel_transform    out[i] = op(in[i]), in and out may be the same vector
+ *   parallel_transform_reduce
+ *                         init op r0 op r1 ... op rk-1, where rj folds t(x) over chunk j starting
+ *                         from its first element; as for std::transform_reduce, op must be
+ *                         associative and commutative over Results. Floating point results may
+ *                         differ from a serial std::accumulate, but not between runs
+ *   parallel_reduce       parallel_transform_reduce with t(x) = Result(x)
+ *   parallel_partition    partitions the chunks, then joins neighbours with std::rotate,
+ *                         returns the partition point
+ *
+ * static_vector_thread_pool is a small work-stealing pool built on
+ * Boost.Thread. Each worker owns a task deque, takes work from its back and
+ * steals from the front of the others' deques when it runs dry. The thread
+ * calling run() deals the tasks out round-robin and then executes tasks
+ * itself until its own have finished, so a pool with no workers runs
+ * everything on the caller. An exception thrown by a task is rethrown by
+ * run() once the remaining tasks are done. The algorithms use
+ * static_vector_thread_pool::instance(), with one worker less than the
+ * hardware threads, unless static_vector_parallel_options names another.
+ *
+ *   boost::StaticVector<Quote, 32768> quotes;
+ *   ...
+ *   boost::parallel_sort(quotes, by_price());
+ *   double volume = boost::parallel_transform_reduce(quotes, 0.0, std::plus<double>(), volume_of());
+ *
+ *  StaticVector is not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_VECTOR_PARALLEL_HPP
+#define BOOST_STATIC_VECTOR_PARALLEL_HPP
+
+#include "StaticVector.hpp"
+#include <boost/atomic.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <numeric>
+
+namespace boost {
+
+    class static_vector_thread_pool : private boost::noncopyable {
+      public:
+        // workers in addition to the thread calling run()
+        explicit static_vector_thread_pool(std::size_t workers)
+          :m_queues(workers),m_queued(0),m_stop(false){
+          for(std::size_t i = 0; i < workers; ++i){
+            m_threads.create_thread(boost::bind(&static_vector_thread_pool::work, this, i));
+          }
+        }
+
+        ~static_vector_thread_pool(){
+          {
+            boost::unique_lock<boost::mutex> lock(m_sleep_mutex);
+            m_stop = true;
+          }
+          m_wake.notify_all();
+          m_threads.join_all();
+        }
+
+        // shared by the parallel algorithms, one worker less than the hardware threads
+        static static_vector_thread_pool& instance(){
+          static static_vector_thread_pool pool(default_workers());
+          return pool;
+        }
+
+        std::size_t workers() const { return m_queues.size(); }
+
+        // calls f(0) ... f(tasks-1) on the workers and this thread, returns when all have finished
+        template<class Function>
+        void run(std::size_t tasks, Function f){
+          job j(f, tasks);
+          if(m_queues.empty()){
+            for(std::size_t i = 0; i < tasks; ++i){
+              execute(task(&j, i));
+            }
+          } else {
+            for(std::size_t i = 0; i < tasks; ++i){
+              push(i % m_queues.size(), task(&j, i));
+            }
+            while(j.remaining.load(boost::memory_order_acquire) != 0){
+              task t;
+              if(take(0, t)){
+                execute(t);
+              } else {
+                boost::this_thread::yield();
+              }
+            }
+          }
+          if(j.error){
+            std::rethrow_exception(j.error);
+          }
+        }
+
+      private:
+        struct job {
+          template<class Function>
+          job(Function f, std::size_t tasks):function(f),remaining(tasks){}
+
+          boost::function<void(std::size_t)> function;
+          boost::atomic<std::size_t>         remaining;
+          boost::mutex                       error_mutex;
+          std::exception_ptr                 error;
+        };
+
+        struct task {
+          task():owner(0),index(0){}
+          task(job* j, std::size_t i):owner(j),index(i){}
+          job*        owner;
+          std::size_t index;
+        };
+
+        struct queue {
+          boost::mutex     mutex;
+          std::deque<task> tasks;
+        };
+
+        static std::size_t default_workers(){
+          std::size_t hardware = boost::thread::hardware_concurrency();
+          return hardware > 1 ? hardware - 1 : 0;
+        }
+
+        void push(std::size_t q, const task& t){
+          {
+            boost::lock_guard<boost::mutex> lock(m_queues[q].mutex);
+            m_queues[q].tasks.push_back(t);
+          }
+          m_queued.fetch_add(1, boost::memory_order_release);
+          {
+            // a worker that saw nothing queued is waiting by now
+            boost::lock_guard<boost::mutex> lock(m_sleep_mutex);
+          }
+          m_wake.notify_one();
+        }
+
+        // the back of queue self, else steal from the front of the others
+        bool take(std::size_t self, task& t){
+          if(m_queued.load(boost::memory_order_acquire) == 0){
+            return false;
+          }
+          for(std::size_t k = 0; k < m_queues.size(); ++k){
+            queue& q = m_queues[(self + k) % m_queues.size()];
+            boost::lock_guard<boost::mutex> lock(q.mutex);
+            if(!q.tasks.empty()){
+              if(k == 0){
+                t = q.tasks.back();
+                q.tasks.pop_back();
+              } else {
+                t = q.tasks.front();
+                q.tasks.pop_front();
+              }
+              m_queued.fetch_sub(1, boost::memory_order_relaxed);
+              return true;
+            }
+          }
+          return false;
+        }
+
+        static void execute(const task& t){
+          job& j = *t.owner;
+          try {
+            j.function(t.index);
+          } catch(...) {
+            boost::lock_guard<boost::mutex> lock(j.error_mutex);
+            if(!j.error){
+              j.error = std::current_exception();
+            }
+          }
+          // the last access to j, run() may return as soon as it sees 0
+          j.remaining.fetch_sub(1, boost::memory_order_release);
+        }
+
+        void work(std::size_t self){
+          for(;;){
+            task t;
+            if(take(self, t)){
+              execute(t);
+              continue;
+            }
+            boost::unique_lock<boost::mutex> lock(m_sleep_mutex);
+            while(!m_stop && m_queued.load(boost::memory_order_acquire) == 0){
+              m_wake.wait(lock);
+            }
+            if(m_stop && m_queued.load(boost::memory_order_acquire) == 0){
+              return;
+            }
+          }
+        }
+
+        std::deque<queue>          m_queues;
+        boost::atomic<std::size_t> m_queued;
+        boost::mutex               m_sleep_mutex;
+        boost::condition_variable  m_wake;
+        bool                       m_stop;
+        boost::thread_group        m_threads;
+    };
+
+    struct static_vector_parallel_options {
+        // ranges shorter than 2*threshold elements are processed serially
+        enum { default_threshold = 8192 };
+
+        static_vector_parallel_options()
+          :pool(&static_vector_thread_pool::instance()),threshold(default_threshold){}
+        explicit static_vector_parallel_options(static_vector_thread_pool& p, std::size_t t = default_threshold)
+          :pool(&p),threshold(t ? t : 1){}
+
+        static_vector_thread_pool* pool;
+        std::size_t                threshold;
+    };
+
+    namespace detail {
+        enum { static_vector_max_chunks = 64 };
+
+        inline std::size_t static_vector_chunks(std::size_t n, const static_vector_parallel_options& options){
+          return (std::min)(n / options.threshold, std::size_t(static_vector_max_chunks));
+        }
+
+        // start of chunk i of k over n elements, chunk k-1 ends at n
+        inline std::size_t static_vector_chunk_begin(std::size_t i, std::size_t k, std::size_t n){
+          return i * n / k;
+        }
+
+        template<class Iterator, class Compare>
+        struct static_vector_sort_chunk {
+          Iterator first; std::size_t k; std::size_t n; Compare comp; bool stable;
+          void operator()(std::size_t i) const {
+            Iterator b = first + static_vector_chunk_begin(i, k, n);
+            Iterator e = first + static_vector_chunk_begin(i+1, k, n);
+            if(stable){
+              std::stable_sort(b, e, comp);
+            } else {
+              std::sort(b, e, comp);
+            }
+          }
+        };
+
+        // merges chunks [2*i*width, (2*i+1)*width) and [(2*i+1)*width, (2*i+2)*width)
+        template<class Iterator, class Compare>
+        struct static_vector_merge_chunks {
+          Iterator first; std::size_t k; std::size_t n; std::size_t width; Compare comp;
+          void operator()(std::size_t i) const {
+            std::size_t left = 2 * i * width;
+            std::size_t right = (std::min)(left + 2 * width, k);
+            std::inplace_merge(first + static_vector_chunk_begin(left, k, n),
+                               first + static_vector_chunk_begin(left + width, k, n),
+                               first + static_vector_chunk_begin(right, k, n), comp);
+          }
+        };
+
+        template<class Iterator, class Compare>
+        void static_vector_parallel_sort(Iterator first, Iterator last, Compare comp, bool stable,
+                                         const static_vector_parallel_options& options){
+          std::size_t n = last - first;
+          std::size_t k = static_vector_chunks(n, options);
+          if(k < 2){
+            if(stable){
+              std::stable_sort(first, last, comp);
+            } else {
+              std::sort(first, last, comp);
+            }
+            return;
+          }
+          static_vector_sort_chunk<Iterator, Compare> sort = { first, k, n, comp, stable };
+          options.pool->run(k, sort);
+          for(std::size_t width = 1; width < k; width *= 2){
+            static_vector_merge_chunks<Iterator, Compare> merge = { first, k, n, width, comp };
+            // pairs that have a right hand chunk
+            options.pool->run((k - width + 2 * width - 1) / (2 * width), merge);
+          }
+        }
+
+        template<class InputIterator, class OutputIterator, class UnaryOperation>
+        struct static_vector_transform_chunk {
+          InputIterator in; OutputIterator out; std::size_t k; std::size_t n; UnaryOperation op;
+          void operator()(std::size_t i) const {
+            std::size_t b = static_vector_chunk_begin(i, k, n);
+            std::size_t e = static_vector_chunk_begin(i+1, k, n);
+            std::transform(in + b, in + e, out + b, op);
+          }
+        };
+
+        // folds the transformed elements of chunk i, starting from the first one
+        template<class Iterator, class Result, class BinaryOperation, class UnaryOperation>
+        struct static_vector_reduce_chunk {
+          Iterator first; std::size_t k; std::size_t n; BinaryOperation reduce; UnaryOperation transform;
+          boost::optional<Result>* partial;
+          void operator()(std::size_t i) const {
+            Iterator b = first + static_vector_chunk_begin(i, k, n);
+            Iterator e = first + static_vector_chunk_begin(i+1, k, n);
+            Result r(transform(*b));
+            for(++b; b != e; ++b){
+              r = reduce(r, transform(*b));
+            }
+            partial[i] = r;
+          }
+        };
+
+        // the transform of parallel_reduce, elements are converted to Result before they are combined
+        template<class Result>
+        struct static_vector_convert {
+          template<class U>
+          Result operator()(const U& x) const { return Result(x); }
+        };
+
+        template<class Iterator, class Predicate>
+        struct static_vector_partition_chunk {
+          Iterator first; std::size_t k; std::size_t n; Predicate pred; std::size_t* mid;
+          void operator()(std::size_t i) const {
+            Iterator b = first + static_vector_chunk_begin(i, k, n);
+            Iterator e = first + static_vector_chunk_begin(i+1, k, n);
+            mid[i] = std::partition(b, e, pred) - first;
+          }
+        };
+
+        // joins partitioned chunk groups 2*i*width and (2*i+1)*width by rotating
+        // the right group's true part in front of the left group's false part
+        template<class Iterator>
+        struct static_vector_join_partitions {
+          Iterator first; std::size_t k; std::size_t n; std::size_t width; std::size_t* mid;
+          void operator()(std::size_t i) const {
+            std::size_t left = 2 * i * width;
+            std::size_t right = left + width;
+            std::size_t split = static_vector_chunk_begin(right, k, n);
+            std::rotate(first + mid[left], first + split, first + mid[right]);
+            mid[left] += mid[right] - split;
+          }
+        };
+    }
+
+    template<class T, std::size_t N, typename S, class P, class E, class Compare>
+    void parallel_sort(StaticVector<T,N,S,P,E>& v, Compare comp,
+                       const static_vector_parallel_options& options = static_vector_parallel_options()){
+      detail::static_vector_parallel_sort(v.begin(), v.end(), comp, false, options);
+    }
+
+    template<class T, std::size_t N, typename S, class P, class E>
+    void parallel_sort(StaticVector<T,N,S,P,E>& v){
+      parallel_sort(v, std::less<T>());
+    }
+
+    template<class T, std::size_t N, typename S, class P, class E, class Compare>
+    void parallel_stable_sort(StaticVector<T,N,S,P,E>& v, Compare comp,
+                              const static_vector_parallel_options& options = static_vector_parallel_options()){
+      detail::static_vector_parallel_sort(v.begin(), v.end(), comp, true, options);
+    }
+
+    template<class T, std::size_t N, typename S, class P, class E>
+    void parallel_stable_sort(StaticVector<T,N,S,P,E>& v){
+      parallel_stable_sort(v, std::less<T>());
+    }
+
+    // out is resized to in.size(), elements it gains are default constructed before being assigned
+    template<class T, std::size_t N, typename S, class P, class E,
+             class U, std::size_t M, typename S2, class P2, class E2, class UnaryOperation>
+    void parallel_transform(const StaticVector<T,N,S,P,E>& in, StaticVector<U,M,S2,P2,E2>& out, UnaryOperation op,
+                            const static_vector_parallel_options& options = static_vector_parallel_options()){
+      std::size_t n = in.size();
+      out.resize_default_init(n);
+      std::size_t k = detail::static_vector_chunks(n, options);
+      if(k < 2){
+        std::transform(in.begin(), in.end(), out.begin(), op);
+        return;
+      }
+      detail::static_vector_transform_chunk<typename StaticVector<T,N,S,P,E>::const_iterator,
+                                            typename StaticVector<U,M,S2,P2,E2>::iterator,
+                                            UnaryOperation> transform = { in.begin(), out.begin(), k, n, op };
+      options.pool->run(k, transform);
+    }
+
+    // init reduce t(v[0]) reduce t(v[1]) ..., grouped by chunk; transform turns an element into a Result
+    template<class T, std::size_t N, typename S, class P, class E, class Result, class BinaryOperation, class UnaryOperation>
+    Result parallel_transform_reduce(const StaticVector<T,N,S,P,E>& v, Result init, BinaryOperation reduce, UnaryOperation transform,
+                                     const static_vector_parallel_options& options = static_vector_parallel_options()){
+      std::size_t n = v.size();
+      std::size_t k = detail::static_vector_chunks(n, options);
+      if(k < 2){
+        for(typename StaticVector<T,N,S,P,E>::const_iterator it = v.begin(); it != v.end(); ++it){
+          init = reduce(init, transform(*it));
+        }
+        return init;
+      }
+      boost::optional<Result> partial[detail::static_vector_max_chunks];
+      detail::static_vector_reduce_chunk<typename StaticVector<T,N,S,P,E>::const_iterator,
+                                         Result, BinaryOperation, UnaryOperation> chunk = { v.begin(), k, n, reduce, transform, partial };
+      options.pool->run(k, chunk);
+      for(std::size_t i = 0; i < k; ++i){
+        init = reduce(init, *partial[i]);
+      }
+      return init;
+    }
+
+    // the elements must convert to Result, op combines two Results
+    template<class T, std::size_t N, typename S, class P, class E, class Result, class BinaryOperation>
+    Result parallel_reduce(const StaticVector<T,N,S,P,E>& v, Result init, BinaryOperation op,
+                           const static_vector_parallel_options& options = static_vector_parallel_options()){
+      return parallel_transform_reduce(v, init, op, detail::static_vector_convert<Result>(), options);
+    }
+
+    template<class T, std::size_t N, typename S, class P, class E, class Result>
+    Result parallel_reduce(const StaticVector<T,N,S,P,E>& v, Result init){
+      return parallel_reduce(v, init, std::plus<Result>());
+    }
+
+    // the relative order within each side is not preserved, as with std::partition
+    template<class T, std::size_t N, typename S, class P, class E, class Predicate>
+    typename StaticVector<T,N,S,P,E>::iterator
+    parallel_partition(StaticVector<T,N,S,P,E>& v, Predicate pred,
+                       const static_vector_parallel_options& options = static_vector_parallel_options()){
+      typedef typename StaticVector<T,N,S,P,E>::iterator iterator;
+      std::size_t n = v.size();
+      std::size_t k = detail::static_vector_chunks(n, options);
+      if(k < 2){
+        return std::partition(v.begin(), v.end(), pred);
+      }
+      std::size_t mid[detail::static_vector_max_chunks];
+      detail::static_vector_partition_chunk<iterator, Predicate> partition = { v.begin(), k, n, pred, mid };
+      options.pool->run(k, partition);
+      for(std::size_t width = 1; width < k; width *= 2){
+        detail::static_vector_join_partitions<iterator> join = { v.begin(), k, n, width, mid };
+        options.pool->run((k - width + 2 * width - 1) / (2 * width), join);
+      }
+      return v.begin() + mid[0];
+    }
+
+} // namespace boost
+
+#endif /* BOOST_STATIC_VECTOR_PARALLEL_HPP */
@@ -0,0 +1,149 @@
+/**
+ *  @file   StaticVectorParallelTests.cpp
+ *  @brief  StaticVectorParallelTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticVector is not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <StaticVectorParallel.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+using namespace boost;
+
+namespace {
+  struct Quote {
+    int price;
+    int sequence;
+  };
+
+  bool ByPrice(const Quote& a, const Quote& b){ return a.price < b.price; }
+  bool IsEven(int x){ return x % 2 == 0; }
+  int Square(int x){ return x * x; }
+  long PriceOf(const Quote& q){ return q.price; }
+
+  typedef StaticVector<Quote,20000> Quotes;
+  typedef StaticVector<int,20000> Ints;
+
+  void Fill(Ints& v, std::size_t n, int seed){
+    std::srand(seed);
+    v.clear();
+    for(std::size_t i = 0; i < n; ++i){
+      v.push_back(std::rand() % 1000);
+    }
+  }
+
+  struct Throws {
+    void operator()(std::size_t i) const {
+      if(i == 3){
+        throw std::runtime_error("task 3");
+      }
+    }
+  };
+}
+
+BOOST_AUTO_TEST_CASE(ParallelSortMatchesSerial){
+  static_vector_thread_pool pool(3);
+  // 7 and 16 chunks, an odd count leaves a chunk without a partner in the first merge round
+  std::size_t sizes[] = {700, 19999, 50};
+  for(std::size_t s = 0; s < 3; ++s){
+    static Ints v;
+    Fill(v,sizes[s],int(s));
+    std::vector<int> expected(v.begin(),v.end());
+    std::sort(expected.begin(),expected.end());
+    parallel_sort(v,std::less<int>(),static_vector_parallel_options(pool,100));
+    BOOST_CHECK(std::equal(v.begin(),v.end(),expected.begin()));
+  }
+  
+  static Quotes quotes;
+  std::srand(42);
+  for(int i = 0; i < 15000; ++i){
+    Quote q = { std::rand() % 50, i };
+    quotes.push_back(q);
+  }
+  parallel_stable_sort(quotes,ByPrice,static_vector_parallel_options(pool,1000));
+  bool stable = true;
+  for(std::size_t i = 1; i < quotes.size(); ++i){
+    stable = stable && (quotes[i-1].price < quotes[i].price ||
+                        (quotes[i-1].price == quotes[i].price && quotes[i-1].sequence < quotes[i].sequence));
+  }
+  BOOST_CHECK(stable);
+}
+
+BOOST_AUTO_TEST_CASE(ParallelTransformReducePartition){
+  static_vector_thread_pool pool(2);
+  static_vector_parallel_options options(pool,256);
+  static Ints v;
+  Fill(v,10000,1);
+  std::vector<int> serial(v.begin(),v.end());
+  
+  BOOST_CHECK_EQUAL(parallel_reduce(v,0,std::plus<int>(),options),std::accumulate(serial.begin(),serial.end(),0));
+  
+  // floating point sums are grouped by chunk, the same way on every run
+  static StaticVector<double,10000> tenths;
+  for(std::size_t i = 0; i < v.size(); ++i){
+    tenths.push_back(v[i] * 0.1);
+  }
+  double sum = parallel_reduce(tenths,0.0,std::plus<double>(),options);
+  BOOST_CHECK_CLOSE(sum,std::accumulate(tenths.begin(),tenths.end(),0.0),1e-9);
+  for(int run = 0; run < 5; ++run){
+    BOOST_CHECK_EQUAL(parallel_reduce(tenths,0.0,std::plus<double>(),options),sum);
+  }
+  static_vector_thread_pool other(1);
+  BOOST_CHECK_EQUAL(parallel_reduce(tenths,0.0,std::plus<double>(),static_vector_parallel_options(other,256)),sum);
+  
+  // elements that are not the result type are transformed before they are combined
+  static Quotes quotes;
+  long total = 0;
+  for(std::size_t i = 0; i < v.size(); ++i){
+    Quote q = { v[i], int(i) };
+    quotes.push_back(q);
+    total += v[i];
+  }
+  BOOST_CHECK_EQUAL(parallel_transform_reduce(quotes,0L,std::plus<long>(),PriceOf,options),total);
+  BOOST_CHECK_EQUAL(parallel_transform_reduce(quotes,5L,std::plus<long>(),PriceOf),total+5);
+
+  static Ints squares;
+  parallel_transform(v,squares,Square,options);
+  BOOST_REQUIRE_EQUAL(squares.size(),v.size());
+  BOOST_CHECK_EQUAL(squares[9999],serial[9999]*serial[9999]);
+  parallel_transform(v,v,Square,options);
+  BOOST_CHECK(std::equal(v.begin(),v.end(),squares.begin()));
+  
+  Fill(v,10000,2);
+  std::size_t evens = std::count_if(v.begin(),v.end(),IsEven);
+  std::vector<int> before(v.begin(),v.end());
+  Ints::iterator mid = parallel_partition(v,IsEven,options);
+  BOOST_CHECK_EQUAL(std::size_t(mid-v.begin()),evens);
+  BOOST_CHECK(std::is_partitioned(v.begin(),v.end(),IsEven));
+  std::sort(before.begin(),before.end());
+  std::sort(v.begin(),v.end());
+  BOOST_CHECK(std::equal(v.begin(),v.end(),before.begin()));
+}
+
+BOOST_AUTO_TEST_CASE(ThreadPoolRethrowsAndRunsWithoutWorkers){
+  static_vector_thread_pool pool(2);
+  BOOST_CHECK_THROW(pool.run(8,Throws()),std::runtime_error);
+  static_vector_thread_pool inline_pool(0);
+  BOOST_CHECK_EQUAL(inline_pool.workers(),0u);
+  static Ints v;
+  Fill(v,5000,3);
+  std::vector<int> expected(v.begin(),v.end());
+  std::sort(expected.begin(),expected.end());
+  parallel_sort(v,std::less<int>(),static_vector_parallel_options(inline_pool,100));
+  BOOST_CHECK(std::equal(v.begin(),v.end(),expected.begin()));
+  
+  // below the threshold, the default pool is not involved
+  Ints small(10u,1);
+  BOOST_CHECK_EQUAL(parallel_reduce(small,0),10);
+}
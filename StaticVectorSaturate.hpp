@@ -0,0 +1,55 @@
+/**
+ * @file   StaticVectorSaturate.hpp
+ * @brief  Error policy for StaticVector that drops and counts overflowing operations.
+ *
+ * static_vector_saturate_on_error<Tag> is passed as the fifth template
+ * parameter of StaticVector (or of StaticBitVector). An operation that does
+ * not fit is dropped like with static_vector_assert_on_error, but instead of
+ * asserting it is counted, for all containers that use the same Tag, in a
+ * relaxed atomic that dropped() reads and reset() clears. It lives in its own
+ * header so that StaticVector.hpp does not depend on Boost.Atomic.
+ *
+ *   struct Drops {};
+ *   typedef boost::static_vector_saturate_on_error<Drops> Saturate;
+ *   boost::StaticVector<Packet, 64, boost::uint8_t, boost::static_vector_no_stats, Saturate> packets;
+ *   ...
+ *   if(Saturate::dropped()) report(Saturate::dropped());
+ *
+ *  StaticVector is not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_VECTOR_SATURATE_HPP
+#define BOOST_STATIC_VECTOR_SATURATE_HPP
+
+#include "StaticVector.hpp"
+#include <boost/atomic.hpp>
+
+namespace boost {
+
+    // overflowing operations are dropped silently and counted, per Tag, in dropped()
+    template<class Tag = void>
+    struct static_vector_saturate_on_error {
+        static void overflow(std::size_t /*requested*/, std::size_t /*capacity*/) {
+          counter().fetch_add(1, boost::memory_order_relaxed);
+        }
+        static void out_of_range(std::size_t /*index*/, std::size_t /*size*/) {
+          BOOST_ASSERT_MSG(false, "StaticVector<>: index out of range");
+        }
+
+        static std::size_t dropped() { return counter().load(boost::memory_order_relaxed); }
+        static void reset() { counter().store(0, boost::memory_order_relaxed); }
+
+      private:
+        static boost::atomic<std::size_t>& counter(){
+          static boost::atomic<std::size_t> c(0);
+          return c;
+        }
+    };
+
+} // namespace boost
+
+#endif /* BOOST_STATIC_VECTOR_SATURATE_HPP */
@@ -0,0 +1,100 @@
+/**
+ * @file   StaticVectorSerialization.hpp
+ * @brief  Boost.Serialization support for StaticVector.
+ *
+ * A StaticVector is saved as its size followed by its elements. For trivially
+ * copyable T (StaticVector::has_stable_layout) the elements are written as a
+ * single binary object of size()*sizeof(T) bytes, so a binary archive stores
+ * them with one write and restores them with one read. Other element types
+ * are saved one by one like a standard container.
+ *
+ * Loading throws std::out_of_range if the archive holds more than N elements.
+ *
+ *   #include <boost/archive/binary_oarchive.hpp>
+ *   #include "StaticVectorSerialization.hpp"
+ *
+ *   boost::archive::binary_oarchive archive(stream);
+ *   archive << records;
+ *
+ *  StaticVector is not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_VECTOR_SERIALIZATION_HPP
+#define BOOST_STATIC_VECTOR_SERIALIZATION_HPP
+
+#include "StaticVector.hpp"
+#include <boost/serialization/binary_object.hpp>
+#include <boost/serialization/collection_size_type.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/split_free.hpp>
+
+namespace boost {
+namespace serialization {
+
+  namespace detail {
+        template<class Archive, class T, std::size_t N, typename S, class P, class E>
+        void save_elements(Archive& ar, const StaticVector<T,N,S,P,E>& v, boost::true_type /*stable layout*/){
+          if(!v.empty()){
+            const binary_object blob(const_cast<T*>(v.data()), v.size() * sizeof(T));
+            ar << boost::serialization::make_nvp("elements", blob);
+          }
+        }
+
+        template<class Archive, class T, std::size_t N, typename S, class P, class E>
+        void save_elements(Archive& ar, const StaticVector<T,N,S,P,E>& v, boost::false_type /*stable layout*/){
+          for(typename StaticVector<T,N,S,P,E>::const_iterator it = v.begin(); it != v.end(); ++it){
+            ar << boost::serialization::make_nvp("item", *it);
+          }
+        }
+
+        template<class Archive, class T, std::size_t N, typename S, class P, class E>
+        void load_elements(Archive& ar, StaticVector<T,N,S,P,E>& v, std::size_t n, boost::true_type /*stable layout*/){
+          // every element is overwritten by the blob, so they are not value-initialized first
+          v.resize_default_init(n);
+          if(n){
+            binary_object blob(v.data(), n * sizeof(T));
+            ar >> boost::serialization::make_nvp("elements", blob);
+          }
+        }
+
+        template<class Archive, class T, std::size_t N, typename S, class P, class E>
+        void load_elements(Archive& ar, StaticVector<T,N,S,P,E>& v, std::size_t n, boost::false_type /*stable layout*/){
+          for(std::size_t i = 0; i < n; ++i){
+            v.emplace_back();
+            ar >> boost::serialization::make_nvp("item", v.back());
+          }
+        }
+  } // namespace detail
+
+    template<class Archive, class T, std::size_t N, typename S, class P, class E>
+    void save(Archive& ar, const StaticVector<T,N,S,P,E>& v, const unsigned int /*version*/){
+        const collection_size_type count(v.size());
+        ar << BOOST_SERIALIZATION_NVP(count);
+        detail::save_elements(ar, v, boost::integral_constant<bool, StaticVector<T,N,S,P,E>::has_stable_layout>());
+    }
+
+    template<class Archive, class T, std::size_t N, typename S, class P, class E>
+    void load(Archive& ar, StaticVector<T,N,S,P,E>& v, const unsigned int /*version*/){
+        collection_size_type count;
+        ar >> BOOST_SERIALIZATION_NVP(count);
+        if(std::size_t(count) > N){
+            std::out_of_range e("StaticVector<>: archive holds more elements than the capacity");
+            BOOST_THROW_EXCEPTION(e);
+        }
+        v.clear();
+        detail::load_elements(ar, v, count, boost::integral_constant<bool, StaticVector<T,N,S,P,E>::has_stable_layout>());
+    }
+
+    template<class Archive, class T, std::size_t N, typename S, class P, class E>
+    void serialize(Archive& ar, StaticVector<T,N,S,P,E>& v, const unsigned int version){
+        boost::serialization::split_free(ar, v, version);
+    }
+
+} // namespace serialization
+} // namespace boost
+
+#endif /* BOOST_STATIC_VECTOR_SERIALIZATION_HPP */
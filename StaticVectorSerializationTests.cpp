@@ -0,0 +1,91 @@
+/**
+ *  @file   StaticVectorSerializationTests.cpp
+ *  @brief  StaticVectorSerializationTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticVector is not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/serialization/string.hpp>
+#include <StaticVectorSerialization.hpp>
+#include <sstream>
+#include <string>
+using namespace boost;
+
+template <typename OArchive, typename IArchive, typename Vector>
+Vector RoundTrip(const Vector& vec){
+  std::stringstream stream;
+  {
+    OArchive out(stream);
+    out << vec;
+  }
+  Vector result;
+  result.push_back(typename Vector::value_type());
+  IArchive in(stream);
+  in >> result;
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(SerializeTrivialAsBlob){
+  StaticVector<double,1000> vec;
+  for(int i = 0; i < 1000; i++){
+    vec.push_back(i * 0.25);
+  }
+  BOOST_CHECK((RoundTrip<archive::binary_oarchive,archive::binary_iarchive>(vec) == vec));
+  BOOST_CHECK((RoundTrip<archive::text_oarchive,archive::text_iarchive>(vec) == vec));
+  
+  // the binary archive holds the count and one blob, nothing per element
+  std::stringstream stream;
+  {
+    archive::binary_oarchive out(stream,archive::no_header);
+    out << vec;
+  }
+  BOOST_CHECK_LE(stream.str().size(),sizeof(double)*1000 + 2*sizeof(boost::uint64_t));
+  
+  StaticVector<double,1000> empty;
+  BOOST_CHECK((RoundTrip<archive::binary_oarchive,archive::binary_iarchive>(empty).empty()));
+}
+
+BOOST_AUTO_TEST_CASE(SerializeElementwise){
+  StaticVector<std::string,8> vec;
+  vec.push_back("one");
+  vec.push_back("two words");
+  vec.push_back("");
+  BOOST_CHECK((RoundTrip<archive::text_oarchive,archive::text_iarchive>(vec) == vec));
+  BOOST_CHECK((RoundTrip<archive::binary_oarchive,archive::binary_iarchive>(vec) == vec));
+}
+
+BOOST_AUTO_TEST_CASE(SerializeOverCapacity){
+  StaticVector<int,8> large;
+  for(int i = 0; i < 8; i++){
+    large.push_back(i);
+  }
+  std::stringstream stream;
+  {
+    archive::binary_oarchive out(stream);
+    out << large;
+  }
+  StaticVector<int,4> small;
+  archive::binary_iarchive in(stream);
+  BOOST_CHECK_THROW(in >> small,std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(SerializeWithPolicies){
+  typedef StaticVector<int,8,uint_value_t<8>::least,static_vector_no_stats,static_vector_assert_on_error> AssertingVector;
+  AssertingVector vec;
+  for(int i = 0; i < 5; i++){
+    vec.push_back(i);
+  }
+  BOOST_CHECK((RoundTrip<archive::binary_oarchive,archive::binary_iarchive>(vec) == vec));
+  BOOST_CHECK((RoundTrip<archive::text_oarchive,archive::text_iarchive>(vec) == vec));
+}
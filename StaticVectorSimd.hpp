@@ -0,0 +1,657 @@
+/**
+ * @file   StaticVectorSimd.hpp
+ * @brief  SSE2/AVX2 search and comparison kernels for contiguous arithmetic data.
+ *
+ * The kernels in boost::detail::simd work on a pointer and an element count,
+ * and are used by the find, count, contains, min_element, max_element, erase
+ * and comparison functions of StaticVector. remove compacts in place: each
+ * register is compared once and whole blocks of survivors move with one
+ * memmove, only mixed blocks are compressed lane by lane. Each one dispatches on the element
+ * type: integral types of 1, 2, 4 or 8 bytes, float and double go through a
+ * vector kernel, every other type through the equivalent std:: algorithm.
+ *
+ * The instruction set is selected at compile time from the target flags:
+ * __AVX2__ selects 32 byte registers, __SSE2__ (always present on x86-64)
+ * 16 byte registers, and without either only the scalar code is compiled.
+ * Define BOOST_STATIC_VECTOR_NO_SIMD to force the scalar code.
+ *
+ * Loads never touch memory outside of [first, first+n). When n is not a
+ * multiple of the register width, 4 and 8 byte lanes are finished with an
+ * AVX2 masked load, otherwise a final load overlapping the previous block is
+ * used with the already visited lanes masked out of the result, and ranges
+ * shorter than one register are handled by the scalar loop.
+ *
+ * Results are identical to the std:: algorithms, including for floating
+ * point -0.0 and NaN. min/max are only vectorized for integral lanes of up to
+ * 4 bytes, since floating point min/max instructions do not order NaN the
+ * way operator< does.
+ *
+ *  StaticVector is not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_VECTOR_SIMD_HPP
+#define BOOST_STATIC_VECTOR_SIMD_HPP
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_signed.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#if !defined(BOOST_STATIC_VECTOR_NO_SIMD)
+#  if defined(__AVX2__)
+#    define BOOST_STATIC_VECTOR_SIMD_AVX2
+#  endif
+#  if defined(__SSE4_1__) || defined(BOOST_STATIC_VECTOR_SIMD_AVX2)
+#    define BOOST_STATIC_VECTOR_SIMD_SSE41
+#  endif
+#  if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define BOOST_STATIC_VECTOR_SIMD_SSE2
+#  endif
+#endif
+
+#if defined(BOOST_STATIC_VECTOR_SIMD_AVX2) || defined(BOOST_STATIC_VECTOR_SIMD_SSE41)
+#  include <immintrin.h>
+#elif defined(BOOST_STATIC_VECTOR_SIMD_SSE2)
+#  include <emmintrin.h>
+#endif
+
+#if defined(BOOST_MSVC)
+#  include <intrin.h>
+#endif
+
+namespace boost {
+namespace detail {
+namespace simd {
+
+    // kind of vector lane used for an element type, lane_none for the scalar fallback
+    enum lane_kind {
+        lane_none,
+        lane_i8, lane_u8, lane_i16, lane_u16, lane_i32, lane_u32, lane_i64, lane_u64,
+        lane_f32, lane_f64
+    };
+
+    template<class T>
+    struct lane_of : boost::integral_constant<int,
+        boost::is_same<T,float>::value  ? lane_f32 :
+        boost::is_same<T,double>::value ? lane_f64 :
+        !boost::is_integral<T>::value   ? lane_none :
+        sizeof(T) == 1 ? (boost::is_signed<T>::value ? lane_i8  : lane_u8)  :
+        sizeof(T) == 2 ? (boost::is_signed<T>::value ? lane_i16 : lane_u16) :
+        sizeof(T) == 4 ? (boost::is_signed<T>::value ? lane_i32 : lane_u32) :
+        sizeof(T) == 8 ? (boost::is_signed<T>::value ? lane_i64 : lane_u64) :
+        lane_none> {};
+
+    inline unsigned count_trailing_zeros(unsigned x){
+#if defined(BOOST_MSVC)
+        unsigned long index;
+        _BitScanForward(&index, x);
+        return static_cast<unsigned>(index);
+#elif defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctz(x));
+#else
+        unsigned n = 0;
+        while(!(x & 1u)){ x >>= 1; ++n; }
+        return n;
+#endif
+    }
+
+    inline unsigned population_count(unsigned x){
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_popcount(x));
+#else
+        unsigned n = 0;
+        for(; x; x &= x - 1) ++n;
+        return n;
+#endif
+    }
+
+    // Register operations for one lane kind. Comparisons return a byte mask,
+    // one bit per byte of the register, so a matching lane of sizeof(T) bytes
+    // sets sizeof(T) consecutive bits.
+    template<int Isa, int Lane> struct ops { static const bool enabled = false; static const bool has_minmax = false; };
+
+    enum isa_kind { isa_sse2, isa_avx2 };
+
+#if defined(BOOST_STATIC_VECTOR_SIMD_SSE2)
+    template<int Size> struct sse2_int_ops {
+        static const bool enabled = true;
+        static const bool has_masked_load = false;
+        static const std::size_t bytes = 16;
+        typedef __m128i reg;
+        static reg load(const void* p){ return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+        static unsigned mask(reg r){ return static_cast<unsigned>(_mm_movemask_epi8(r)); }
+    };
+
+    template<> struct ops<isa_sse2,lane_i8> : sse2_int_ops<1> {
+        static reg splat(boost::int8_t v){ return _mm_set1_epi8(static_cast<char>(v)); }
+        static unsigned eq(reg a, reg b){ return mask(_mm_cmpeq_epi8(a,b)); }
+#if defined(BOOST_STATIC_VECTOR_SIMD_SSE41)
+        static const bool has_minmax = true;
+        static reg min(reg a, reg b){ return _mm_min_epi8(a,b); }
+        static reg max(reg a, reg b){ return _mm_max_epi8(a,b); }
+#else
+        static const bool has_minmax = false;
+#endif
+    };
+    template<> struct ops<isa_sse2,lane_u8> : sse2_int_ops<1> {
+        static const bool has_minmax = true;
+        static reg splat(boost::uint8_t v){ return _mm_set1_epi8(static_cast<char>(v)); }
+        static unsigned eq(reg a, reg b){ return mask(_mm_cmpeq_epi8(a,b)); }
+        static reg min(reg a, reg b){ return _mm_min_epu8(a,b); }
+        static reg max(reg a, reg b){ return _mm_max_epu8(a,b); }
+    };
+    template<> struct ops<isa_sse2,lane_i16> : sse2_int_ops<2> {
+        static const bool has_minmax = true;
+        static reg splat(boost::int16_t v){ return _mm_set1_epi16(static_cast<short>(v)); }
+        static unsigned eq(reg a, reg b){ return mask(_mm_cmpeq_epi16(a,b)); }
+        static reg min(reg a, reg b){ return _mm_min_epi16(a,b); }
+        static reg max(reg a, reg b){ return _mm_max_epi16(a,b); }
+    };
+    template<> struct ops<isa_sse2,lane_u16> : sse2_int_ops<2> {
+        static reg splat(boost::uint16_t v){ return _mm_set1_epi16(static_cast<short>(v)); }
+        static unsigned eq(reg a, reg b){ return mask(_mm_cmpeq_epi16(a,b)); }
+#if defined(BOOST_STATIC_VECTOR_SIMD_SSE41)
+        static const bool has_minmax = true;
+        static reg min(reg a, reg b){ return _mm_min_epu16(a,b); }
+        static reg max(reg a, reg b){ return _mm_max_epu16(a,b); }
+#else
+        static const bool has_minmax = false;
+#endif
+    };
+    template<> struct ops<isa_sse2,lane_i32> : sse2_int_ops<4> {
+        static reg splat(boost::int32_t v){ return _mm_set1_epi32(v); }
+        static unsigned eq(reg a, reg b){ return mask(_mm_cmpeq_epi32(a,b)); }
+#if defined(BOOST_STATIC_VECTOR_SIMD_SSE41)
+        static const bool has_minmax = true;
+        static reg min(reg a, reg b){ return _mm_min_epi32(a,b); }
+        static reg max(reg a, reg b){ return _mm_max_epi32(a,b); }
+#else
+        static const bool has_minmax = false;
+#endif
+    };
+    template<> struct ops<isa_sse2,lane_u32> : sse2_int_ops<4> {
+        static reg splat(boost::uint32_t v){ return _mm_set1_epi32(static_cast<int>(v)); }
+        static unsigned eq(reg a, reg b){ return mask(_mm_cmpeq_epi32(a,b)); }
+#if defined(BOOST_STATIC_VECTOR_SIMD_SSE41)
+        static const bool has_minmax = true;
+        static reg min(reg a, reg b){ return _mm_min_epu32(a,b); }
+        static reg max(reg a, reg b){ return _mm_max_epu32(a,b); }
+#else
+        static const bool has_minmax = false;
+#endif
+    };
+    template<> struct ops<isa_sse2,lane_i64> : sse2_int_ops<8> {
+        static const bool has_minmax = false;
+        static reg splat(boost::int64_t v){ return _mm_set1_epi64x(v); }
+        static unsigned eq(reg a, reg b){
+#if defined(BOOST_STATIC_VECTOR_SIMD_SSE41)
+            return mask(_mm_cmpeq_epi64(a,b));
+#else
+            // both 32 bit halves of a lane have to match
+            __m128i halves = _mm_cmpeq_epi32(a,b);
+            return mask(_mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2,3,0,1))));
+#endif
+        }
+    };
+    template<> struct ops<isa_sse2,lane_u64> : ops<isa_sse2,lane_i64> {
+        static reg splat(boost::uint64_t v){ return _mm_set1_epi64x(static_cast<boost::int64_t>(v)); }
+    };
+    template<> struct ops<isa_sse2,lane_f32> {
+        static const bool enabled = true;
+        static const bool has_minmax = false;
+        static const bool has_masked_load = false;
+        static const std::size_t bytes = 16;
+        typedef __m128 reg;
+        static reg load(const void* p){ return _mm_loadu_ps(static_cast<const float*>(p)); }
+        static reg splat(float v){ return _mm_set1_ps(v); }
+        static unsigned eq(reg a, reg b){ return static_cast<unsigned>(_mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(a,b)))); }
+    };
+    template<> struct ops<isa_sse2,lane_f64> {
+        static const bool enabled = true;
+        static const bool has_minmax = false;
+        static const bool has_masked_load = false;
+        static const std::size_t bytes = 16;
+        typedef __m128d reg;
+        static reg load(const void* p){ return _mm_loadu_pd(static_cast<const double*>(p)); }
+        static reg splat(double v){ return _mm_set1_pd(v); }
+        static unsigned eq(reg a, reg b){ return static_cast<unsigned>(_mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(a,b)))); }
+    };
+#endif // BOOST_STATIC_VECTOR_SIMD_SSE2
+
+#if defined(BOOST_STATIC_VECTOR_SIMD_AVX2)
+    template<int Size> struct avx2_int_ops {
+        static const bool enabled = true;
+        static const bool has_masked_load = false;
+        static const std::size_t bytes = 32;
+        typedef __m256i reg;
+        static reg load(const void* p){ return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+        static unsigned mask(reg r){ return static_cast<unsigned>(_mm256_movemask_epi8(r)); }
+    };
+
+    // lane_mask(n) enables the first n lanes of a masked load
+    template<> struct avx2_int_ops<4> {
+        static const bool enabled = true;
+        static const bool has_masked_load = true;
+        static const std::size_t bytes = 32;
+        typedef __m256i reg;
+        static reg load(const void* p){ return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+        static reg load(const void* p, std::size_t n){
+            const __m256i lanes = _mm256_setr_epi32(0,1,2,3,4,5,6,7);
+            return _mm256_maskload_epi32(static_cast<const int*>(p), _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(n)), lanes));
+        }
+        static unsigned mask(reg r){ return static_cast<unsigned>(_mm256_movemask_epi8(r)); }
+    };
+    template<> struct avx2_int_ops<8> {
+        static const bool enabled = true;
+        static const bool has_masked_load = true;
+        static const std::size_t bytes = 32;
+        typedef __m256i reg;
+        static reg load(const void* p){ return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+        static reg load(const void* p, std::size_t n){
+            const __m256i lanes = _mm256_setr_epi64x(0,1,2,3);
+            return _mm256_maskload_epi64(static_cast<const long long*>(p), _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(n)), lanes));
+        }
+        static unsigned mask(reg r){ return static_cast<unsigned>(_mm256_movemask_epi8(r)); }
+    };
+
+    template<> struct ops<isa_avx2,lane_i8> : avx2_int_ops<1> {
+        static const bool has_minmax = true;
+        static reg splat(boost::int8_t v){ return _mm256_set1_epi8(static_cast<char>(v)); }
+        static unsigned eq(reg a, reg b){ return mask(_mm256_cmpeq_epi8(a,b)); }
+        static reg min(reg a, reg b){ return _mm256_min_epi8(a,b); }
+        static reg max(reg a, reg b){ return _mm256_max_epi8(a,b); }
+    };
+    template<> struct ops<isa_avx2,lane_u8> : avx2_int_ops<1> {
+        static const bool has_minmax = true;
+        static reg splat(boost::uint8_t v){ return _mm256_set1_epi8(static_cast<char>(v)); }
+        static unsigned eq(reg a, reg b){ return mask(_mm256_cmpeq_epi8(a,b)); }
+        static reg min(reg a, reg b){ return _mm256_min_epu8(a,b); }
+        static reg max(reg a, reg b){ return _mm256_max_epu8(a,b); }
+    };
+    template<> struct ops<isa_avx2,lane_i16> : avx2_int_ops<2> {
+        static const bool has_minmax = true;
+        static reg splat(boost::int16_t v){ return _mm256_set1_epi16(static_cast<short>(v)); }
+        static unsigned eq(reg a, reg b){ return mask(_mm256_cmpeq_epi16(a,b)); }
+        static reg min(reg a, reg b){ return _mm256_min_epi16(a,b); }
+        static reg max(reg a, reg b){ return _mm256_max_epi16(a,b); }
+    };
+    template<> struct ops<isa_avx2,lane_u16> : avx2_int_ops<2> {
+        static const bool has_minmax = true;
+        static reg splat(boost::uint16_t v){ return _mm256_set1_epi16(static_cast<short>(v)); }
+        static unsigned eq(reg a, reg b){ return mask(_mm256_cmpeq_epi16(a,b)); }
+        static reg min(reg a, reg b){ return _mm256_min_epu16(a,b); }
+        static reg max(reg a, reg b){ return _mm256_max_epu16(a,b); }
+    };
+    template<> struct ops<isa_avx2,lane_i32> : avx2_int_ops<4> {
+        static const bool has_minmax = true;
+        static reg splat(boost::int32_t v){ return _mm256_set1_epi32(v); }
+        static unsigned eq(reg a, reg b){ return mask(_mm256_cmpeq_epi32(a,b)); }
+        static reg min(reg a, reg b){ return _mm256_min_epi32(a,b); }
+        static reg max(reg a, reg b){ return _mm256_max_epi32(a,b); }
+    };
+    template<> struct ops<isa_avx2,lane_u32> : avx2_int_ops<4> {
+        static const bool has_minmax = true;
+        static reg splat(boost::uint32_t v){ return _mm256_set1_epi32(static_cast<int>(v)); }
+        static unsigned eq(reg a, reg b){ return mask(_mm256_cmpeq_epi32(a,b)); }
+        static reg min(reg a, reg b){ return _mm256_min_epu32(a,b); }
+        static reg max(reg a, reg b){ return _mm256_max_epu32(a,b); }
+    };
+    template<> struct ops<isa_avx2,lane_i64> : avx2_int_ops<8> {
+        static const bool has_minmax = false;
+        static reg splat(boost::int64_t v){ return _mm256_set1_epi64x(v); }
+        static unsigned eq(reg a, reg b){ return mask(_mm256_cmpeq_epi64(a,b)); }
+    };
+    template<> struct ops<isa_avx2,lane_u64> : ops<isa_avx2,lane_i64> {
+        static reg splat(boost::uint64_t v){ return _mm256_set1_epi64x(static_cast<long long>(v)); }
+    };
+    template<> struct ops<isa_avx2,lane_f32> {
+        static const bool enabled = true;
+        static const bool has_minmax = false;
+        static const bool has_masked_load = true;
+        static const std::size_t bytes = 32;
+        typedef __m256 reg;
+        static reg load(const void* p){ return _mm256_loadu_ps(static_cast<const float*>(p)); }
+        static reg load(const void* p, std::size_t n){
+            const __m256i lanes = _mm256_setr_epi32(0,1,2,3,4,5,6,7);
+            return _mm256_maskload_ps(static_cast<const float*>(p), _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(n)), lanes));
+        }
+        static reg splat(float v){ return _mm256_set1_ps(v); }
+        static unsigned eq(reg a, reg b){ return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_castps_si256(_mm256_cmp_ps(a,b,_CMP_EQ_OQ)))); }
+    };
+    template<> struct ops<isa_avx2,lane_f64> {
+        static const bool enabled = true;
+        static const bool has_minmax = false;
+        static const bool has_masked_load = true;
+        static const std::size_t bytes = 32;
+        typedef __m256d reg;
+        static reg load(const void* p){ return _mm256_loadu_pd(static_cast<const double*>(p)); }
+        static reg load(const void* p, std::size_t n){
+            const __m256i lanes = _mm256_setr_epi64x(0,1,2,3);
+            return _mm256_maskload_pd(static_cast<const double*>(p), _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(n)), lanes));
+        }
+        static reg splat(double v){ return _mm256_set1_pd(v); }
+        static unsigned eq(reg a, reg b){ return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_castpd_si256(_mm256_cmp_pd(a,b,_CMP_EQ_OQ)))); }
+    };
+#endif // BOOST_STATIC_VECTOR_SIMD_AVX2
+
+#if defined(BOOST_STATIC_VECTOR_SIMD_AVX2)
+    template<class T> struct ops_for : ops<isa_avx2, lane_of<T>::value> {};
+#else
+    template<class T> struct ops_for : ops<isa_sse2, lane_of<T>::value> {};
+#endif
+
+    // true if the kernels below use vector registers for T
+    template<class T>
+    struct is_vectorized : boost::integral_constant<bool, ops_for<T>::enabled> {};
+
+    template<class T>
+    struct is_minmax_vectorized : boost::integral_constant<bool, ops_for<T>::enabled && ops_for<T>::has_minmax> {};
+
+    // byte mask bits of the lanes at or after lane k
+    template<class T>
+    inline unsigned lanes_from(std::size_t k){
+        return ~0u << (k * sizeof(T));
+    }
+
+    // bits of the first n lanes
+    template<class T>
+    inline unsigned first_lanes(std::size_t n){
+        return n * sizeof(T) >= 32 ? ~0u : ~(~0u << (n * sizeof(T)));
+    }
+
+    // bits of every lane of a register
+    template<class Ops>
+    inline unsigned all_lanes(){
+        return Ops::bytes >= 32 ? ~0u : ~(~0u << Ops::bytes);
+    }
+
+    // ---------- find -------------------------
+
+    template<class Ops, class T>
+    std::size_t find_tail(const T* p, std::size_t i, std::size_t n, typename Ops::reg v, boost::true_type /*has_masked_load*/){
+        unsigned m = Ops::eq(Ops::load(p+i, n-i), v) & first_lanes<T>(n-i);
+        return m ? i + count_trailing_zeros(m) / sizeof(T) : n;
+    }
+
+    template<class Ops, class T>
+    std::size_t find_tail(const T* p, std::size_t i, std::size_t n, typename Ops::reg v, boost::false_type /*has_masked_load*/){
+        std::size_t base = n - Ops::bytes / sizeof(T);
+        unsigned m = Ops::eq(Ops::load(p+base), v) & lanes_from<T>(i-base);
+        return m ? base + count_trailing_zeros(m) / sizeof(T) : n;
+    }
+
+    template<class T>
+    std::size_t find(const T* p, std::size_t n, const T& value, boost::true_type /*vectorized*/){
+        typedef ops_for<T> Ops;
+        const std::size_t width = Ops::bytes / sizeof(T);
+        if(n < width && !Ops::has_masked_load){
+            return std::find(p, p+n, value) - p;
+        }
+        typename Ops::reg v = Ops::splat(value);
+        std::size_t i = 0;
+        for(; i + width <= n; i += width){
+            unsigned m = Ops::eq(Ops::load(p+i), v);
+            if(m){
+                return i + count_trailing_zeros(m) / sizeof(T);
+            }
+        }
+        if(i == n){
+            return n;
+        }
+        return find_tail<Ops>(p, i, n, v, boost::integral_constant<bool,Ops::has_masked_load>());
+    }
+
+    template<class T>
+    std::size_t find(const T* p, std::size_t n, const T& value, boost::false_type /*vectorized*/){
+        return std::find(p, p+n, value) - p;
+    }
+
+    // index of the first element equal to value, n if there is none
+    template<class T>
+    std::size_t find(const T* p, std::size_t n, const T& value){
+        return simd::find(p, n, value, is_vectorized<T>());
+    }
+
+    // ---------- count -------------------------
+
+    template<class Ops, class T>
+    std::size_t count_tail(const T* p, std::size_t i, std::size_t n, typename Ops::reg v, boost::true_type /*has_masked_load*/){
+        return population_count(Ops::eq(Ops::load(p+i, n-i), v) & first_lanes<T>(n-i)) / sizeof(T);
+    }
+
+    template<class Ops, class T>
+    std::size_t count_tail(const T* p, std::size_t i, std::size_t n, typename Ops::reg v, boost::false_type /*has_masked_load*/){
+        std::size_t base = n - Ops::bytes / sizeof(T);
+        return population_count(Ops::eq(Ops::load(p+base), v) & lanes_from<T>(i-base)) / sizeof(T);
+    }
+
+    template<class T>
+    std::size_t count(const T* p, std::size_t n, const T& value, boost::true_type /*vectorized*/){
+        typedef ops_for<T> Ops;
+        const std::size_t width = Ops::bytes / sizeof(T);
+        if(n < width && !Ops::has_masked_load){
+            return std::count(p, p+n, value);
+        }
+        typename Ops::reg v = Ops::splat(value);
+        std::size_t i = 0;
+        std::size_t result = 0;
+        for(; i + width <= n; i += width){
+            result += population_count(Ops::eq(Ops::load(p+i), v));
+        }
+        result /= sizeof(T);
+        if(i != n){
+            result += count_tail<Ops>(p, i, n, v, boost::integral_constant<bool,Ops::has_masked_load>());
+        }
+        return result;
+    }
+
+    template<class T>
+    std::size_t count(const T* p, std::size_t n, const T& value, boost::false_type /*vectorized*/){
+        return std::count(p, p+n, value);
+    }
+
+    // number of elements equal to value
+    template<class T>
+    std::size_t count(const T* p, std::size_t n, const T& value){
+        return simd::count(p, n, value, is_vectorized<T>());
+    }
+
+    // ---------- mismatch -------------------------
+
+    template<class Ops, class T>
+    std::size_t mismatch_tail(const T* a, const T* b, std::size_t i, std::size_t n, boost::true_type /*has_masked_load*/){
+        unsigned m = ~Ops::eq(Ops::load(a+i, n-i), Ops::load(b+i, n-i)) & first_lanes<T>(n-i);
+        return m ? i + count_trailing_zeros(m) / sizeof(T) : n;
+    }
+
+    template<class Ops, class T>
+    std::size_t mismatch_tail(const T* a, const T* b, std::size_t i, std::size_t n, boost::false_type /*has_masked_load*/){
+        std::size_t base = n - Ops::bytes / sizeof(T);
+        unsigned m = ~Ops::eq(Ops::load(a+base), Ops::load(b+base)) & all_lanes<Ops>() & lanes_from<T>(i-base);
+        return m ? base + count_trailing_zeros(m) / sizeof(T) : n;
+    }
+
+    template<class T>
+    std::size_t mismatch(const T* a, const T* b, std::size_t n, boost::true_type /*vectorized*/){
+        typedef ops_for<T> Ops;
+        const std::size_t width = Ops::bytes / sizeof(T);
+        if(n < width && !Ops::has_masked_load){
+            return std::mismatch(a, a+n, b).first - a;
+        }
+        std::size_t i = 0;
+        for(; i + width <= n; i += width){
+            unsigned m = ~Ops::eq(Ops::load(a+i), Ops::load(b+i)) & all_lanes<Ops>();
+            if(m){
+                return i + count_trailing_zeros(m) / sizeof(T);
+            }
+        }
+        if(i == n){
+            return n;
+        }
+        return mismatch_tail<Ops>(a, b, i, n, boost::integral_constant<bool,Ops::has_masked_load>());
+    }
+
+    template<class T>
+    std::size_t mismatch(const T* a, const T* b, std::size_t n, boost::false_type /*vectorized*/){
+        return std::mismatch(a, a+n, b).first - a;
+    }
+
+    // index of the first position where a and b differ, n if they are equal
+    template<class T>
+    std::size_t mismatch(const T* a, const T* b, std::size_t n){
+        return simd::mismatch(a, b, n, is_vectorized<T>());
+    }
+
+    template<class T>
+    bool equal(const T* a, const T* b, std::size_t n){
+        return simd::mismatch(a, b, n) == n;
+    }
+
+    // lexicographical a < b, vectorized for integral T where the first mismatch decides
+    template<class T>
+    bool less(const T* a, std::size_t na, const T* b, std::size_t nb, boost::true_type /*vectorized*/){
+        std::size_t n = (std::min)(na, nb);
+        std::size_t i = simd::mismatch(a, b, n);
+        return i == n ? na < nb : a[i] < b[i];
+    }
+
+    template<class T>
+    bool less(const T* a, std::size_t na, const T* b, std::size_t nb, boost::false_type /*vectorized*/){
+        return std::lexicographical_compare(a, a+na, b, b+nb);
+    }
+
+    template<class T>
+    bool less(const T* a, std::size_t na, const T* b, std::size_t nb){
+        return simd::less(a, na, b, nb, boost::integral_constant<bool, is_vectorized<T>::value && boost::is_integral<T>::value>());
+    }
+
+    // ---------- min/max -------------------------
+
+    struct min_tag {};
+    struct max_tag {};
+
+    template<class Ops> typename Ops::reg reduce(typename Ops::reg a, typename Ops::reg b, min_tag){ return Ops::min(a,b); }
+    template<class Ops> typename Ops::reg reduce(typename Ops::reg a, typename Ops::reg b, max_tag){ return Ops::max(a,b); }
+
+    template<class T> bool better(const T& a, const T& b, min_tag){ return a < b; }
+    template<class T> bool better(const T& a, const T& b, max_tag){ return b < a; }
+
+    template<class T, class Tag>
+    std::size_t extremum(const T* p, std::size_t n, Tag tag, boost::false_type /*vectorized*/){
+        if(n == 0){
+            return 0;
+        }
+        std::size_t best = 0;
+        for(std::size_t i = 1; i < n; ++i){
+            if(better(p[i], p[best], tag)) best = i;
+        }
+        return best;
+    }
+
+    template<class T, class Tag>
+    std::size_t extremum(const T* p, std::size_t n, Tag tag, boost::true_type /*vectorized*/){
+        typedef ops_for<T> Ops;
+        const std::size_t width = Ops::bytes / sizeof(T);
+        if(n < width){
+            return simd::extremum(p, n, tag, boost::false_type());
+        }
+        typename Ops::reg acc = Ops::load(p);
+        std::size_t i = width;
+        for(; i + width <= n; i += width){
+            acc = reduce<Ops>(acc, Ops::load(p+i), tag);
+        }
+        if(i != n){
+            // overlapping the previous block does not change a minimum or maximum
+            acc = reduce<Ops>(acc, Ops::load(p+n-width), tag);
+        }
+        T lanes[Ops::bytes / sizeof(T)];
+        std::memcpy(lanes, &acc, sizeof(lanes));
+        T best = lanes[0];
+        for(std::size_t j = 1; j < width; ++j){
+            if(better(lanes[j], best, tag)) best = lanes[j];
+        }
+        // std::min_element and std::max_element return the first occurrence
+        return simd::find(p, n, best);
+    }
+
+    // index of the first smallest element, n if the range is empty
+    template<class T>
+    std::size_t min_element(const T* p, std::size_t n){
+        return simd::extremum(p, n, min_tag(), is_minmax_vectorized<T>());
+    }
+
+    // index of the first largest element, n if the range is empty
+    template<class T>
+    std::size_t max_element(const T* p, std::size_t n){
+        return simd::extremum(p, n, max_tag(), is_minmax_vectorized<T>());
+    }
+
+    // ---------- remove -------------------------
+
+    // moves the surviving lanes of one register's worth of elements to out
+    template<class T>
+    inline T* compress_block(const T* block, unsigned keep, T* out){
+        for(; keep; keep &= ~(first_lanes<T>(1) << count_trailing_zeros(keep))){
+            *out++ = block[count_trailing_zeros(keep) / sizeof(T)];
+        }
+        return out;
+    }
+
+    template<class T>
+    std::size_t remove(T* p, std::size_t n, const T& value, boost::true_type /*vectorized*/){
+        typedef ops_for<T> Ops;
+        const std::size_t width = Ops::bytes / sizeof(T);
+        // the elements before the first match stay where they are
+        std::size_t i = simd::find(p, n, value);
+        if(i == n){
+            return n;
+        }
+        typename Ops::reg v = Ops::splat(value);
+        T* out = p + i;
+        for(; i + width <= n; i += width){
+            typename Ops::reg r = Ops::load(p+i);
+            unsigned keep = ~Ops::eq(r, v) & all_lanes<Ops>();
+            if(keep == all_lanes<Ops>()){
+                // whole block survives, out trails i so the ranges may overlap
+                std::memmove(out, p+i, Ops::bytes);
+                out += width;
+            } else if(keep){
+                // the block is in r, so writing to out cannot clobber lanes still to be read
+                T lanes[Ops::bytes / sizeof(T)];
+                std::memcpy(lanes, &r, sizeof(lanes));
+                out = compress_block(lanes, keep, out);
+            }
+        }
+        for(; i < n; ++i){
+            if(!(p[i] == value)){
+                *out++ = p[i];
+            }
+        }
+        return out - p;
+    }
+
+    template<class T>
+    std::size_t remove(T* p, std::size_t n, const T& value, boost::false_type /*vectorized*/){
+        return std::remove(p, p+n, value) - p;
+    }
+
+    // moves the elements not equal to value to the front, keeping their order, and returns their number
+    template<class T>
+    std::size_t remove(T* p, std::size_t n, const T& value){
+        return simd::remove(p, n, value, is_vectorized<T>());
+    }
+
+} // namespace simd
+} // namespace detail
+} // namespace boost
+
+#endif /* BOOST_STATIC_VECTOR_SIMD_HPP */
@@ -0,0 +1,193 @@
+/**
+ * @file   StaticVectorStats.hpp
+ * @brief  Usage statistics for sizing the capacity of StaticVector.
+ *
+ * The fourth template parameter of StaticVector is a stats policy that is
+ * told about every operation that matters for choosing N. The default,
+ * static_vector_no_stats, does nothing and costs nothing. Passing
+ * static_vector_stats<Tag> instead records, for all vectors that use the
+ * same Tag:
+ *
+ *   high_water     the largest size any of them reached
+ *   near_capacity  growing operations that left a vector at least
+ *                  NearCapacityPercent (default 90) percent full
+ *   overflows      operations that failed because N was too small
+ *   middle_inserts inserts and emplaces that had to shift a tail up
+ *   erases         erases that had to shift a tail down
+ *   copies         copy constructions and copy assignments
+ *
+ * The policy is stateless, so the vector keeps its size and layout. The
+ * counters of a Tag live in one static object that is added to
+ * static_vector_stats_registry the first time it is used; the registry
+ * dumps or resets all of them. Counters are relaxed atomics, so vectors on
+ * different threads may share a Tag. Tag must provide a name:
+ *
+ *   struct OrderLevels { static const char* name() { return "order book levels"; } };
+ *   typedef boost::StaticVector<Level, 64, boost::uint8_t, boost::static_vector_stats<OrderLevels> > Levels;
+ *   ...
+ *   boost::static_vector_stats_registry::instance().dump(std::clog);
+ *
+ *  StaticVector is not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_VECTOR_STATS_HPP
+#define BOOST_STATIC_VECTOR_STATS_HPP
+
+#include "StaticVector.hpp"
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <cstring>
+#include <ostream>
+
+namespace boost {
+
+    // counters shared by all vectors of one stats Tag
+    class static_vector_counters : private boost::noncopyable {
+      public:
+        explicit static_vector_counters(const char* name)
+          :m_name(name),m_next(0),m_capacity(0),m_high_water(0),m_near_capacity(0),
+           m_overflows(0),m_middle_inserts(0),m_erases(0),m_copies(0){}
+
+        const char* name() const { return m_name; }
+        std::size_t capacity() const { return m_capacity.load(boost::memory_order_relaxed); }
+        std::size_t high_water() const { return m_high_water.load(boost::memory_order_relaxed); }
+        std::size_t near_capacity() const { return m_near_capacity.load(boost::memory_order_relaxed); }
+        std::size_t overflows() const { return m_overflows.load(boost::memory_order_relaxed); }
+        std::size_t middle_inserts() const { return m_middle_inserts.load(boost::memory_order_relaxed); }
+        std::size_t erases() const { return m_erases.load(boost::memory_order_relaxed); }
+        std::size_t copies() const { return m_copies.load(boost::memory_order_relaxed); }
+
+        // next counters in the registry, 0 at the end
+        const static_vector_counters* next() const { return m_next; }
+
+        void record_size(std::size_t size, std::size_t capacity, std::size_t near_capacity_percent){
+          record_capacity(capacity);
+          std::size_t seen = m_high_water.load(boost::memory_order_relaxed);
+          while(size > seen && !m_high_water.compare_exchange_weak(seen, size, boost::memory_order_relaxed)){}
+          if(size * 100 >= capacity * near_capacity_percent){
+            m_near_capacity.fetch_add(1, boost::memory_order_relaxed);
+          }
+        }
+
+        void record_overflow(std::size_t capacity){
+          record_capacity(capacity);
+          m_overflows.fetch_add(1, boost::memory_order_relaxed);
+        }
+
+        void record_middle_insert() { m_middle_inserts.fetch_add(1, boost::memory_order_relaxed); }
+        void record_erase() { m_erases.fetch_add(1, boost::memory_order_relaxed); }
+        void record_copy() { m_copies.fetch_add(1, boost::memory_order_relaxed); }
+
+        void reset(){
+          m_high_water.store(0, boost::memory_order_relaxed);
+          m_near_capacity.store(0, boost::memory_order_relaxed);
+          m_overflows.store(0, boost::memory_order_relaxed);
+          m_middle_inserts.store(0, boost::memory_order_relaxed);
+          m_erases.store(0, boost::memory_order_relaxed);
+          m_copies.store(0, boost::memory_order_relaxed);
+        }
+
+      private:
+        friend class static_vector_stats_registry;
+
+        // all vectors of a Tag normally share N, the largest one is reported
+        void record_capacity(std::size_t capacity){
+          if(m_capacity.load(boost::memory_order_relaxed) < capacity){
+            m_capacity.store(capacity, boost::memory_order_relaxed);
+          }
+        }
+
+        const char*                m_name;
+        static_vector_counters*    m_next;
+        boost::atomic<std::size_t> m_capacity;
+        boost::atomic<std::size_t> m_high_water;
+        boost::atomic<std::size_t> m_near_capacity;
+        boost::atomic<std::size_t> m_overflows;
+        boost::atomic<std::size_t> m_middle_inserts;
+        boost::atomic<std::size_t> m_erases;
+        boost::atomic<std::size_t> m_copies;
+    };
+
+    // every static_vector_counters object in the program, newest first
+    class static_vector_stats_registry : private boost::noncopyable {
+      public:
+        static static_vector_stats_registry& instance(){
+          static static_vector_stats_registry registry;
+          return registry;
+        }
+
+        // called once per Tag, may race with other registrations
+        void add(static_vector_counters& counters){
+          static_vector_counters* head = m_head.load(boost::memory_order_relaxed);
+          do {
+            counters.m_next = head;
+          } while(!m_head.compare_exchange_weak(head, &counters, boost::memory_order_release, boost::memory_order_relaxed));
+        }
+
+        const static_vector_counters* first() const { return m_head.load(boost::memory_order_acquire); }
+
+        // the counters registered under name, 0 if there are none
+        const static_vector_counters* find(const char* name) const {
+          for(const static_vector_counters* c = first(); c; c = c->next()){
+            if(std::strcmp(c->name(), name) == 0){
+              return c;
+            }
+          }
+          return 0;
+        }
+
+        // one line per Tag
+        void dump(std::ostream& os) const {
+          for(const static_vector_counters* c = first(); c; c = c->next()){
+            os << c->name()
+               << " capacity=" << c->capacity()
+               << " high_water=" << c->high_water()
+               << " near_capacity=" << c->near_capacity()
+               << " overflows=" << c->overflows()
+               << " middle_inserts=" << c->middle_inserts()
+               << " erases=" << c->erases()
+               << " copies=" << c->copies() << '\n';
+          }
+        }
+
+        void reset(){
+          for(static_vector_counters* c = m_head.load(boost::memory_order_acquire); c; c = c->m_next){
+            c->reset();
+          }
+        }
+
+      private:
+        static_vector_stats_registry():m_head(0){}
+
+        boost::atomic<static_vector_counters*> m_head;
+    };
+
+    // stats policy recording into the counters of Tag
+    template<class Tag, std::size_t NearCapacityPercent = 90>
+    struct static_vector_stats {
+        static static_vector_counters& counters(){
+          static static_vector_counters& c = make_counters();
+          return c;
+        }
+
+        static void grow(std::size_t size, std::size_t capacity) { counters().record_size(size, capacity, NearCapacityPercent); }
+        static void overflow(std::size_t /*requested*/, std::size_t capacity) { counters().record_overflow(capacity); }
+        static void middle_insert() { counters().record_middle_insert(); }
+        static void erase() { counters().record_erase(); }
+        static void copy() { counters().record_copy(); }
+
+      private:
+        static static_vector_counters& make_counters(){
+          static static_vector_counters c(Tag::name());
+          static_vector_stats_registry::instance().add(c);
+          return c;
+        }
+    };
+
+} // namespace boost
+
+#endif /* BOOST_STATIC_VECTOR_STATS_HPP */
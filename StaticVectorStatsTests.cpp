@@ -0,0 +1,141 @@
+/**
+ *  @file   StaticVectorStatsTests.cpp
+ *  @brief  StaticVectorStatsTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticVector is not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <StaticVectorStats.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+using namespace boost;
+
+namespace {
+  struct Levels { static const char* name() { return "test levels"; } };
+  struct Names { static const char* name() { return "test names"; } };
+
+  typedef StaticVector<int,10,uint_value_t<10>::least,static_vector_stats<Levels> > LevelVector;
+  typedef StaticVector<std::string,4,uint_value_t<4>::least,static_vector_stats<Names,75> > NameVector;
+}
+
+BOOST_AUTO_TEST_CASE(StatsAreFreeWhenDisabled){
+  BOOST_CHECK_EQUAL(sizeof(LevelVector),sizeof(StaticVector<int,10>));
+  BOOST_CHECK_EQUAL(sizeof(StaticVector<int,10,uint_value_t<10>::least,static_vector_no_stats>),sizeof(StaticVector<int,10>));
+}
+
+BOOST_AUTO_TEST_CASE(StatsCountOperations){
+  static_vector_counters& c = static_vector_stats<Levels>::counters();
+  c.reset();
+  {
+    LevelVector v;
+    for(int i = 0; i < 8; ++i){
+      v.push_back(i);
+    }
+    BOOST_CHECK_EQUAL(c.high_water(),8u);
+    BOOST_CHECK_EQUAL(c.capacity(),10u);
+    BOOST_CHECK_EQUAL(c.near_capacity(),0u);
+
+    v.insert(v.begin(),-1);
+    v.push_back(8);
+    BOOST_CHECK_EQUAL(c.high_water(),10u);
+    BOOST_CHECK_EQUAL(c.near_capacity(),2u);
+    BOOST_CHECK_EQUAL(c.middle_inserts(),1u);
+
+    BOOST_CHECK_THROW(v.push_back(9),std::out_of_range);
+    BOOST_CHECK_EQUAL(c.overflows(),1u);
+
+    v.erase(v.begin());      // shifts the tail
+    v.erase(v.end()-1);      // nothing to shift
+    v.pop_back();
+    BOOST_CHECK_EQUAL(c.erases(),1u);
+
+    LevelVector copy(v);
+    copy = v;
+    BOOST_CHECK_EQUAL(c.copies(),2u);
+    BOOST_CHECK_EQUAL(c.high_water(),10u);
+  }
+  c.reset();
+  BOOST_CHECK_EQUAL(c.high_water(),0u);
+  BOOST_CHECK_EQUAL(c.capacity(),10u);
+}
+
+BOOST_AUTO_TEST_CASE(StatsCountIntegerRangesOnce){
+  static_vector_counters& c = static_vector_stats<Levels>::counters();
+  c.reset();
+  LevelVector v;
+  v.append(3,7);
+  v.insert(v.begin()+1,6,1);
+  v.insert(v.end(),1,2);
+  BOOST_CHECK_EQUAL(v.size(),10u);
+  BOOST_CHECK_EQUAL(v[1],1);
+  BOOST_CHECK_EQUAL(v[7],7);
+  BOOST_CHECK_EQUAL(v.back(),2);
+  BOOST_CHECK_EQUAL(c.near_capacity(),2u);
+  BOOST_CHECK_EQUAL(c.middle_inserts(),1u);
+  BOOST_CHECK_THROW(v.insert(v.begin(),1,0),std::out_of_range);
+  BOOST_CHECK_EQUAL(c.overflows(),1u);
+}
+
+BOOST_AUTO_TEST_CASE(StatsRecordSizesReached){
+  static_vector_counters& c = static_vector_stats<Levels>::counters();
+  c.reset();
+  LevelVector v;
+  v.reserve(10);
+  v.resize(4);
+  BOOST_CHECK_THROW(v.resize(11),std::out_of_range);
+  BOOST_CHECK_THROW(v.append_n(7,1),std::out_of_range);
+  v.resize(2);
+  BOOST_CHECK_EQUAL(c.high_water(),4u);
+  BOOST_CHECK_EQUAL(c.near_capacity(),0u);
+  BOOST_CHECK_EQUAL(c.overflows(),2u);
+}
+
+BOOST_AUTO_TEST_CASE(StatsRecordMoves){
+  static_vector_counters& c = static_vector_stats<Levels>::counters();
+  LevelVector v(9,1);
+  c.reset();
+  LevelVector moved(boost::move(v));
+  BOOST_CHECK_EQUAL(c.high_water(),9u);
+  BOOST_CHECK_EQUAL(c.near_capacity(),1u);
+  LevelVector assigned;
+  assigned = boost::move(moved);
+  BOOST_CHECK_EQUAL(c.near_capacity(),2u);
+  BOOST_CHECK_EQUAL(c.copies(),0u);
+}
+
+BOOST_AUTO_TEST_CASE(StatsRegistry){
+  NameVector names;
+  names.push_back("a");
+  names.push_back("b");
+  names.push_back("c");
+  names.insert(names.begin()+1,"d");
+  LevelVector levels;
+  levels.resize(3,1);
+
+  static_vector_stats_registry& registry = static_vector_stats_registry::instance();
+  const static_vector_counters* c = registry.find("test names");
+  BOOST_REQUIRE(c);
+  BOOST_CHECK_EQUAL(c->capacity(),4u);
+  BOOST_CHECK_EQUAL(c->high_water(),4u);
+  BOOST_CHECK_EQUAL(c->near_capacity(),2u);
+  BOOST_CHECK_EQUAL(c->middle_inserts(),1u);
+  BOOST_CHECK(registry.find("test levels"));
+  BOOST_CHECK(!registry.find("unused"));
+
+  std::ostringstream out;
+  registry.dump(out);
+  BOOST_CHECK(out.str().find("test names capacity=4 high_water=4 near_capacity=2 overflows=0 middle_inserts=1 erases=0 copies=0\n") != std::string::npos);
+  BOOST_CHECK(out.str().find("test levels capacity=10") != std::string::npos);
+
+  registry.reset();
+  BOOST_CHECK_EQUAL(c->high_water(),0u);
+  BOOST_CHECK_EQUAL(c->middle_inserts(),0u);
+}
@@ -0,0 +1,42 @@
+/**
+ *  @file   StaticVectorTestTypes.hpp
+ *  @brief  Element types shared by the container tests.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticVector is not accepted as part of boost.
+ */
+
+#ifndef BOOST_STATIC_VECTOR_TEST_TYPES_HPP
+#define BOOST_STATIC_VECTOR_TEST_TYPES_HPP
+
+#include <stdexcept>
+
+// the counters live in a class template so every test file can include this header
+template <typename Tag = void>
+struct trackedCounters {
+  static int live;
+  static int copies_left;
+};
+template <typename Tag> int trackedCounters<Tag>::live = 0;
+template <typename Tag> int trackedCounters<Tag>::copies_left = 0;
+
+// counts live instances, the copy constructor throws once copies_left runs out
+struct Tracked : trackedCounters<> {
+  explicit Tracked(int v = 0):value(v){ ++live; }
+  Tracked(const Tracked& rhs):value(rhs.value){
+    if(copies_left-- == 0){
+      throw std::runtime_error("copy");
+    }
+    ++live;
+  }
+  Tracked& operator=(const Tracked&) = default;
+  ~Tracked(){ --live; }
+  bool operator<(const Tracked& rhs) const { return value < rhs.value; }
+  
+  int value;
+};
+
+#endif /* BOOST_STATIC_VECTOR_TEST_TYPES_HPP */
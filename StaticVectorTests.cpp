@@ -21,6 +21,17 @@
 #include <StaticVector.hpp>
 #include <algorithm>
 #include <vector>
+#include <string>
+#include <utility>
+#include <memory>
+#include <functional>
+#include <limits>
+#include <list>
+#include <sstream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <boost/cstdint.hpp>
 using namespace boost;
 
 template <typename T, std::size_t U>
@@ -177,3 +188,627 @@ BOOST_AUTO_TEST_CASE(CompareIteratorWithStdVector){
 }
 
 
+struct moveCounter {
+  static std::size_t copies;
+  static std::size_t moves;
+  moveCounter(std::size_t v = 0):value(v){}
+  moveCounter(const moveCounter& rhs):value(rhs.value){ copies++; }
+  moveCounter(moveCounter&& rhs):value(rhs.value){ rhs.value = 0; moves++; }
+  moveCounter& operator=(const moveCounter& rhs){ value = rhs.value; copies++; return *this; }
+  moveCounter& operator=(moveCounter&& rhs){ value = rhs.value; rhs.value = 0; moves++; return *this; }
+  static void reset(){ copies = 0; moves = 0; }
+  
+  std::size_t value;
+};
+std::size_t moveCounter::copies = 0;
+std::size_t moveCounter::moves = 0;
+
+BOOST_AUTO_TEST_CASE(PushBackRvalue){
+  StaticVector<moveCounter,VEC_SIZE> vec;
+  moveCounter::reset();
+  moveCounter m(7);
+  vec.push_back(std::move(m));
+  vec.push_back(moveCounter(8));
+  BOOST_CHECK_EQUAL(moveCounter::copies,0);
+  BOOST_CHECK_EQUAL(moveCounter::moves,2);
+  BOOST_CHECK_EQUAL(vec[0].value,7);
+  BOOST_CHECK_EQUAL(vec[1].value,8);
+}
+
+BOOST_AUTO_TEST_CASE(EmplaceBack){
+  StaticVector<std::pair<std::size_t,std::string>,VEC_SIZE> vec;
+  vec.emplace_back(1,"one");
+  vec.emplace_back(2,"two");
+  BOOST_CHECK_EQUAL(vec.size(),2);
+  BOOST_CHECK_EQUAL(vec[1].first,2);
+  BOOST_CHECK_EQUAL(vec.back().second,"two");
+  BOOST_CHECK_EQUAL(vec.front().second,"one");
+}
+
+BOOST_AUTO_TEST_CASE(EmplaceMiddle){
+  StaticVector<std::string,VEC_SIZE> vec;
+  vec.emplace(vec.end(),"c");
+  vec.emplace(vec.begin(),"a");
+  vec.emplace(vec.begin()+1,3,'b');
+  BOOST_CHECK_EQUAL(vec.size(),3);
+  BOOST_CHECK_EQUAL(vec[0],"a");
+  BOOST_CHECK_EQUAL(vec[1],"bbb");
+  BOOST_CHECK_EQUAL(vec[2],"c");
+}
+
+BOOST_AUTO_TEST_CASE(MoveConstructAndAssign){
+  StaticVector<moveCounter,VEC_SIZE> vec;
+  PushBackN(vec,VEC_SIZE);
+  moveCounter::reset();
+  StaticVector<moveCounter,VEC_SIZE> moved(std::move(vec));
+  BOOST_CHECK_EQUAL(moved.size(),VEC_SIZE);
+  BOOST_CHECK_EQUAL(moved[VEC_SIZE-1].value,VEC_SIZE-1);
+  
+  StaticVector<moveCounter,VEC_SIZE> assigned;
+  assigned.push_back(moveCounter(42));
+  assigned = std::move(moved);
+  BOOST_CHECK_EQUAL(assigned.size(),VEC_SIZE);
+  BOOST_CHECK_EQUAL(assigned[0].value,0);
+  BOOST_CHECK_EQUAL(assigned[VEC_SIZE-1].value,VEC_SIZE-1);
+  BOOST_CHECK_EQUAL(moveCounter::copies,0);
+}
+
+BOOST_AUTO_TEST_CASE(MovesInStdVector){
+  typedef StaticVector<std::string,VEC_SIZE> Strings;
+  BOOST_STATIC_ASSERT(std::is_nothrow_move_constructible<Strings>::value);
+  BOOST_STATIC_ASSERT(std::is_nothrow_move_assignable<Strings>::value);
+
+  // reallocation moves the rows, so the strings hand over their buffers rather than being copied
+  std::vector<Strings> rows(1);
+  rows[0].push_back(std::string(40,'a'));
+  const char* buffer = rows[0][0].data();
+  for(std::size_t i = 0; i < 100; i++){
+    rows.push_back(Strings());
+  }
+  BOOST_CHECK(rows[0][0].data() == buffer);
+}
+
+// trivial copies, but moving clears the source
+struct clearingMove {
+  static std::size_t moves;
+  clearingMove(std::size_t v = 0):value(v){}
+  clearingMove(const clearingMove&) = default;
+  clearingMove(clearingMove&& rhs):value(rhs.value){ rhs.value = 0; moves++; }
+  clearingMove& operator=(const clearingMove&) = default;
+  clearingMove& operator=(clearingMove&& rhs){ value = rhs.value; rhs.value = 0; moves++; return *this; }
+  
+  std::size_t value;
+};
+std::size_t clearingMove::moves = 0;
+
+BOOST_AUTO_TEST_CASE(MoveRunsUserProvidedMoves){
+  StaticVector<clearingMove,VEC_SIZE> vec;
+  vec.push_back(clearingMove(1));
+  vec.push_back(clearingMove(2));
+  clearingMove::moves = 0;
+  StaticVector<clearingMove,VEC_SIZE> moved(std::move(vec));
+  BOOST_CHECK_EQUAL(clearingMove::moves,2);
+  BOOST_CHECK_EQUAL(vec[0].value,0);
+  
+  StaticVector<clearingMove,VEC_SIZE> assigned(1,clearingMove(9));
+  assigned = std::move(moved);
+  BOOST_CHECK_EQUAL(clearingMove::moves,4);
+  BOOST_CHECK_EQUAL(assigned[1].value,2);
+  BOOST_CHECK_EQUAL(moved[0].value,0);
+  BOOST_CHECK_EQUAL(moved[1].value,0);
+}
+
+BOOST_AUTO_TEST_CASE(CopyAssignIsDeep){
+  StaticVector<std::string,VEC_SIZE> vec;
+  vec.push_back("first");
+  vec.push_back("second");
+  StaticVector<std::string,VEC_SIZE> copy;
+  copy.push_back("x");
+  copy.push_back("y");
+  copy.push_back("z");
+  copy = vec;
+  vec[0] = "changed";
+  BOOST_CHECK_EQUAL(copy.size(),2);
+  BOOST_CHECK_EQUAL(copy[0],"first");
+  BOOST_CHECK_EQUAL(copy[1],"second");
+}
+
+BOOST_AUTO_TEST_CASE(InsertEraseMatchStdVector){
+  StaticVector<std::string,VEC_SIZE*2> vec;
+  std::vector<std::string> stdvec;
+  const char* words[] = {"a","b","c","d"};
+  
+  vec.insert(vec.end(),words,words+4);
+  stdvec.insert(stdvec.end(),words,words+4);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+  
+  vec.insert(vec.begin()+1,std::string("x"));
+  stdvec.insert(stdvec.begin()+1,std::string("x"));
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+  
+  vec.insert(vec.begin()+2,2,vec[0]);
+  stdvec.insert(stdvec.begin()+2,2,stdvec[0]);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+  
+  vec.insert(vec.begin()+1,words+1,words+3);
+  stdvec.insert(stdvec.begin()+1,words+1,words+3);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+  
+  vec.erase(vec.begin()+3);
+  stdvec.erase(stdvec.begin()+3);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+  
+  vec.erase(vec.begin()+1,vec.begin()+4);
+  stdvec.erase(stdvec.begin()+1,stdvec.begin()+4);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+  
+  vec.resize(VEC_SIZE,"r");
+  stdvec.resize(VEC_SIZE,"r");
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+  
+  vec.resize(2);
+  stdvec.resize(2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+}
+
+BOOST_AUTO_TEST_CASE(InsertEraseTrivial){
+  StaticVector<std::size_t,VEC_SIZE*2> vec;
+  std::vector<std::size_t> stdvec;
+  PushBackN(vec,VEC_SIZE);
+  PushBackN(stdvec,VEC_SIZE);
+  
+  std::size_t array[3] = {97,98,99};
+  vec.insert(vec.begin()+1,array,array+3);
+  stdvec.insert(stdvec.begin()+1,array,array+3);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+  
+  vec.insert(vec.begin(),vec[2]);
+  stdvec.insert(stdvec.begin(),stdvec[2]);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+  
+  vec.erase(vec.begin()+2,vec.begin()+5);
+  stdvec.erase(stdvec.begin()+2,stdvec.begin()+5);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(),vec.end(),stdvec.begin(),stdvec.end());
+  
+  vec.clear();
+  BOOST_CHECK_EQUAL(vec.size(),0);
+}
+
+struct relocatableHandle {
+  static std::size_t live;
+  relocatableHandle(std::size_t v = 0):value(new std::size_t(v)){ live++; }
+  relocatableHandle(const relocatableHandle& rhs):value(new std::size_t(*rhs.value)){ live++; }
+  relocatableHandle& operator=(const relocatableHandle& rhs){ *value = *rhs.value; return *this; }
+  ~relocatableHandle(){ delete value; live--; }
+  
+  std::size_t* value;
+};
+std::size_t relocatableHandle::live = 0;
+
+namespace boost {
+  template<> struct is_trivially_relocatable<relocatableHandle> : boost::true_type {};
+  template<class T> struct is_trivially_relocatable<std::unique_ptr<T> > : boost::true_type {};
+}
+
+BOOST_AUTO_TEST_CASE(RelocatableTrait){
+  BOOST_CHECK(is_trivially_relocatable<std::size_t>::value);
+  BOOST_CHECK((is_trivially_relocatable<std::pair<int,double> >::value));
+  BOOST_CHECK(!is_trivially_relocatable<std::string>::value);
+  BOOST_CHECK(is_trivially_relocatable<relocatableHandle>::value);
+}
+
+BOOST_AUTO_TEST_CASE(RelocatableInsertErase){
+  {
+    StaticVector<relocatableHandle,VEC_SIZE*2> vec;
+    for(std::size_t i = 0; i < VEC_SIZE; i++){
+      vec.push_back(relocatableHandle(i));
+    }
+    BOOST_CHECK_EQUAL(relocatableHandle::live,VEC_SIZE);
+    
+    vec.insert(vec.begin()+2,relocatableHandle(100));
+    vec.insert(vec.begin(),2,vec[3]);
+    BOOST_CHECK_EQUAL(vec.size(),VEC_SIZE+3);
+    BOOST_CHECK_EQUAL(relocatableHandle::live,VEC_SIZE+3);
+    std::size_t expected[VEC_SIZE+3] = {2,2,0,1,100,2,3,4};
+    for(std::size_t i = 0; i < vec.size(); i++){
+      BOOST_CHECK_EQUAL(*vec[i].value,expected[i]);
+    }
+    
+    vec.erase(vec.begin()+1,vec.begin()+4);
+    vec.erase(vec.begin());
+    BOOST_CHECK_EQUAL(vec.size(),VEC_SIZE-1);
+    BOOST_CHECK_EQUAL(relocatableHandle::live,VEC_SIZE-1);
+    BOOST_CHECK_EQUAL(*vec.front().value,100);
+    BOOST_CHECK_EQUAL(*vec.back().value,4);
+  }
+  BOOST_CHECK_EQUAL(relocatableHandle::live,0);
+}
+
+BOOST_AUTO_TEST_CASE(RelocatableUniquePtr){
+  StaticVector<std::unique_ptr<std::size_t>,VEC_SIZE> vec;
+  vec.emplace_back(new std::size_t(1));
+  vec.emplace_back(new std::size_t(3));
+  vec.emplace(vec.begin()+1,new std::size_t(2));
+  vec.insert(vec.begin(),std::unique_ptr<std::size_t>(new std::size_t(0)));
+  BOOST_CHECK_EQUAL(vec.size(),4);
+  for(std::size_t i = 0; i < vec.size(); i++){
+    BOOST_CHECK_EQUAL(*vec[i],i);
+  }
+  vec.erase(vec.begin()+1);
+  BOOST_CHECK_EQUAL(*vec[1],2);
+  BOOST_CHECK_EQUAL(vec.size(),3);
+}
+
+BOOST_AUTO_TEST_CASE(SwapDifferentSizes){
+  StaticVector<std::string,VEC_SIZE> small;
+  StaticVector<std::string,VEC_SIZE> large;
+  small.push_back("s0");
+  large.push_back("l0");
+  large.push_back("l1");
+  large.push_back("l2");
+  small.swap(large);
+  BOOST_CHECK_EQUAL(small.size(),3);
+  BOOST_CHECK_EQUAL(large.size(),1);
+  BOOST_CHECK_EQUAL(small[2],"l2");
+  BOOST_CHECK_EQUAL(large[0],"s0");
+  swap(small,large);
+  BOOST_CHECK_EQUAL(small.size(),1);
+  BOOST_CHECK_EQUAL(large.size(),3);
+  BOOST_CHECK_EQUAL(small[0],"s0");
+  BOOST_CHECK_EQUAL(large[1],"l1");
+}
+
+BOOST_AUTO_TEST_CASE(SwapTrivial){
+  StaticVector<std::size_t,VEC_SIZE> vec;
+  StaticVector<std::size_t,VEC_SIZE> empty;
+  PushBackN(vec,VEC_SIZE-1);
+  vec.swap(empty);
+  BOOST_CHECK_EQUAL(vec.size(),0);
+  BOOST_CHECK_EQUAL(empty.size(),VEC_SIZE-1);
+  BOOST_CHECK_EQUAL(empty[VEC_SIZE-2],VEC_SIZE-2);
+}
+
+// compare the vectorized search kernels against the std:: algorithms for every size up to N,
+// with the searched value placed at every position, so each tail length is covered
+template <typename T, std::size_t N>
+void CheckSearchMatchesStd(){
+  for(std::size_t size = 0; size <= N; size++){
+    for(std::size_t pos = 0; pos <= size; pos++){
+      StaticVector<T,N> vec;
+      for(std::size_t i = 0; i < size; i++){
+        vec.push_back(static_cast<T>(i % 7 + 1));
+      }
+      const T needle = static_cast<T>(100);
+      if(pos < size){
+        vec[pos] = needle;
+      }
+      const StaticVector<T,N>& cvec = vec;
+      BOOST_CHECK(find(cvec,needle) == std::find(vec.begin(),vec.end(),needle));
+      BOOST_CHECK_EQUAL(count(cvec,static_cast<T>(3)),static_cast<std::size_t>(std::count(vec.begin(),vec.end(),static_cast<T>(3))));
+      BOOST_CHECK_EQUAL(contains(cvec,needle),pos < size);
+      BOOST_CHECK(min_element(cvec) == std::min_element(vec.begin(),vec.end()));
+      BOOST_CHECK(max_element(cvec) == std::max_element(vec.begin(),vec.end()));
+      
+      StaticVector<T,N> other(vec);
+      BOOST_CHECK(other == vec);
+      if(pos < size){
+        other[pos] = static_cast<T>(0);
+        BOOST_CHECK(other != vec);
+        BOOST_CHECK(other < vec);
+        BOOST_CHECK(!(vec < other));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SimdSearchMatchesStd){
+  CheckSearchMatchesStd<boost::uint32_t,64>();
+  CheckSearchMatchesStd<boost::int8_t,40>();
+  CheckSearchMatchesStd<boost::uint8_t,40>();
+  CheckSearchMatchesStd<boost::int16_t,20>();
+  CheckSearchMatchesStd<boost::uint16_t,20>();
+  CheckSearchMatchesStd<boost::int32_t,20>();
+  CheckSearchMatchesStd<boost::int64_t,11>();
+  CheckSearchMatchesStd<boost::uint64_t,11>();
+  CheckSearchMatchesStd<float,19>();
+  CheckSearchMatchesStd<double,11>();
+  CheckSearchMatchesStd<std::size_t,VEC_SIZE>();
+}
+
+BOOST_AUTO_TEST_CASE(SimdComparisonEdgeCases){
+  StaticVector<double,8> x;
+  StaticVector<double,8> y;
+  x.push_back(0.0);
+  y.push_back(-0.0);
+  BOOST_CHECK(x == y);
+  x.push_back(std::numeric_limits<double>::quiet_NaN());
+  y.push_back(std::numeric_limits<double>::quiet_NaN());
+  BOOST_CHECK(x != y);
+  BOOST_CHECK(!contains(x,x[1]));
+  BOOST_CHECK(find(x,-0.0) == x.begin());
+  
+  // sizes are part of equality, a prefix compares less
+  StaticVector<int,8> a;
+  StaticVector<int,8> b;
+  a.push_back(1);
+  b.push_back(1);
+  b.push_back(2);
+  BOOST_CHECK(a != b);
+  BOOST_CHECK(a < b);
+  a.push_back(-5);
+  BOOST_CHECK(a < b);
+  
+  StaticVector<int,8> empty;
+  BOOST_CHECK(min_element(empty) == empty.end());
+  BOOST_CHECK_EQUAL(count(empty,0),0);
+}
+
+BOOST_AUTO_TEST_CASE(ResizeWithoutFill){
+  StaticVector<char,64> buffer;
+  buffer.push_back('a');
+  buffer.resize_uninitialized(16);
+  BOOST_CHECK_EQUAL(buffer.size(),16u);
+  BOOST_CHECK_EQUAL(buffer[0],'a');
+  std::fill(buffer.begin()+1,buffer.end(),'b');
+  buffer.resize_default_init(4);
+  BOOST_CHECK_EQUAL(buffer.size(),4u);
+  BOOST_CHECK_EQUAL(buffer.back(),'b');
+  BOOST_CHECK_THROW(buffer.resize_uninitialized(65),std::out_of_range);
+  
+  // class types are default constructed
+  StaticVector<std::string,8> strings(2,std::string("x"));
+  strings.resize_default_init(5);
+  BOOST_CHECK_EQUAL(strings.size(),5u);
+  BOOST_CHECK_EQUAL(strings[1],"x");
+  BOOST_CHECK(strings[4].empty());
+  strings.resize_default_init(1);
+  BOOST_CHECK_EQUAL(strings.size(),1u);
+}
+
+namespace {
+  // stands in for recv(), writes up to 5 bytes per call
+  struct ChunkReader {
+    explicit ChunkReader(std::size_t total):remaining(total){}
+    std::size_t operator()(char* tail, std::size_t room){
+      std::size_t n = (std::min)((std::min)(room,remaining),std::size_t(5));
+      std::fill(tail,tail+n,'r');
+      remaining -= n;
+      return n;
+    }
+    std::size_t remaining;
+  };
+}
+
+BOOST_AUTO_TEST_CASE(AppendFrom){
+  StaticVector<char,12> buffer;
+  buffer.push_back('h');
+  ChunkReader reader(100);
+  BOOST_CHECK_EQUAL(buffer.append_from(std::ref(reader)),5u);
+  BOOST_CHECK_EQUAL(buffer.size(),6u);
+  BOOST_CHECK_EQUAL(buffer.append_from(std::ref(reader)),5u);
+  BOOST_CHECK_EQUAL(buffer.append_from(std::ref(reader)),1u);
+  BOOST_CHECK(buffer.full());
+  BOOST_CHECK_EQUAL(buffer.append_from(std::ref(reader)),0u);
+  BOOST_CHECK_EQUAL(buffer.front(),'h');
+  BOOST_CHECK_EQUAL(std::count(buffer.begin(),buffer.end(),'r'),11);
+}
+
+BOOST_AUTO_TEST_CASE(RangeFromInputIterators){
+  std::istringstream in("1 2 3 4");
+  StaticVector<int,6> v((std::istream_iterator<int>(in)),std::istream_iterator<int>());
+  BOOST_CHECK_EQUAL(v.size(),4u);
+  BOOST_CHECK_EQUAL(v.back(),4);
+  
+  std::istringstream middle("7 8");
+  v.insert(v.begin()+1,std::istream_iterator<int>(middle),std::istream_iterator<int>());
+  int expected[] = {1,7,8,2,3,4};
+  BOOST_CHECK(std::equal(v.begin(),v.end(),expected));
+  
+  // a single pass range that does not fit leaves the vector as it was
+  std::istringstream more("5");
+  BOOST_CHECK_THROW(v.insert(v.begin(),std::istream_iterator<int>(more),std::istream_iterator<int>()),std::out_of_range);
+  BOOST_CHECK(std::equal(v.begin(),v.end(),expected));
+  std::istringstream tooMany("1 2 3 4 5 6 7");
+  BOOST_CHECK_THROW((StaticVector<int,6>(std::istream_iterator<int>(tooMany),std::istream_iterator<int>())),std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(RangeFromForwardIterators){
+  std::list<std::string> names;
+  names.push_back("a");
+  names.push_back("b");
+  StaticVector<std::string,5> v(names.begin(),names.end());
+  v.insert(v.begin()+1,names.begin(),names.end());
+  BOOST_CHECK_EQUAL(v.size(),4u);
+  BOOST_CHECK_EQUAL(v[1],"a");
+  BOOST_CHECK_EQUAL(v[3],"b");
+  BOOST_CHECK_THROW(v.insert(v.begin(),names.begin(),names.end()),std::out_of_range);
+  BOOST_CHECK_EQUAL(v.size(),4u);
+  
+  std::vector<int> source(3,9);
+  StaticVector<int,5> ints(source.begin(),source.end());
+  ints.insert(ints.begin(),source.begin(),source.begin()+2);
+  BOOST_CHECK_EQUAL(ints.size(),5u);
+  BOOST_CHECK_EQUAL(std::count(ints.begin(),ints.end(),9),5);
+}
+
+BOOST_AUTO_TEST_CASE(RangeOverloadsWithIntegers){
+  StaticVector<int,5> v(3,1);
+  BOOST_CHECK_EQUAL(v.size(),3u);
+  BOOST_CHECK_EQUAL(v[2],1);
+  v.insert(v.begin(),2,7);
+  BOOST_CHECK_EQUAL(v.size(),5u);
+  BOOST_CHECK_EQUAL(v[1],7);
+  BOOST_CHECK_EQUAL(v[2],1);
+  BOOST_CHECK_THROW((StaticVector<int,5>(6,0)),std::out_of_range);
+  StaticVector<bool,8> flags(3,1);
+  BOOST_CHECK_EQUAL(count(flags,true),3u);
+  
+  // size()+1 is not truncated to the size type
+  StaticVector<char,255> full(255u,'x');
+  BOOST_CHECK_THROW(full.push_back('y'),std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(BatchAppend){
+  StaticVector<int,64> batch;
+  int packet[32];
+  for(int i = 0; i < 32; ++i){
+    packet[i] = i;
+  }
+  batch.append(packet,packet+32);
+  batch.append_n(16,-1);
+  BOOST_CHECK_EQUAL(batch.size(),48u);
+  BOOST_CHECK_EQUAL(batch[31],31);
+  BOOST_CHECK_EQUAL(batch[47],-1);
+  
+  // a batch that does not fit is rejected as a whole
+  BOOST_CHECK_THROW(batch.append(packet,packet+32),std::out_of_range);
+  BOOST_CHECK_THROW(batch.append_n(17,0),std::out_of_range);
+  BOOST_CHECK_EQUAL(batch.size(),48u);
+  
+  batch.unchecked_append(packet,packet+8);
+  batch.unchecked_append_n(8,batch.front());
+  BOOST_CHECK(batch.full());
+  BOOST_CHECK_EQUAL(batch[55],7);
+  BOOST_CHECK_EQUAL(batch.back(),0);
+  
+  StaticVector<std::string,4> names;
+  names.append_n(2,"n");
+  std::istringstream in("x y z");
+  BOOST_CHECK_THROW(names.append(std::istream_iterator<std::string>(in),std::istream_iterator<std::string>()),std::out_of_range);
+  BOOST_CHECK_EQUAL(names.size(),2u);
+  names.append(names.begin(),names.end());
+  BOOST_CHECK_EQUAL(names.size(),4u);
+  BOOST_CHECK_EQUAL(names[3],"n");
+}
+
+namespace {
+  bool IsOdd(std::size_t x){ return x % 2 == 1; }
+
+  struct throwOnValue {
+    explicit throwOnValue(std::size_t v):value(v){}
+    bool operator()(const relocatableHandle& h) const {
+      if(*h.value == value){
+        throw std::runtime_error("predicate");
+      }
+      return *h.value % 3 == 0;
+    }
+    std::size_t value;
+  };
+}
+
+BOOST_AUTO_TEST_CASE(EraseIfMatchesStd){
+  StaticVector<std::string,VEC_SIZE*4> strings;
+  std::vector<std::string> expected;
+  for(std::size_t i = 0; i < VEC_SIZE*4; i++){
+    strings.push_back(std::string(i % 5 + 1,'a' + char(i % 26)));
+    expected.push_back(strings.back());
+  }
+  std::size_t erased = erase_if(strings,[](const std::string& s){ return s.size() == 2 || s.size() == 3; });
+  expected.erase(std::remove_if(expected.begin(),expected.end(),[](const std::string& s){ return s.size() == 2 || s.size() == 3; }),expected.end());
+  BOOST_CHECK_EQUAL(erased,VEC_SIZE*4-expected.size());
+  BOOST_CHECK(std::equal(strings.begin(),strings.end(),expected.begin()) && strings.size() == expected.size());
+  BOOST_CHECK_EQUAL(strings.erase_if([](const std::string&){ return false; }),0);
+
+  StaticVector<std::size_t,VEC_SIZE*4> numbers;
+  PushBackN(numbers,VEC_SIZE*4);
+  BOOST_CHECK_EQUAL(numbers.erase_if(IsOdd),VEC_SIZE*2);
+  for(std::size_t i = 0; i < numbers.size(); i++){
+    BOOST_CHECK_EQUAL(numbers[i],2*i);
+  }
+  BOOST_CHECK_EQUAL(erase(numbers,std::size_t(4)),1);
+  BOOST_CHECK_EQUAL(numbers[2],6);
+}
+
+BOOST_AUTO_TEST_CASE(EraseIfRelocatable){
+  {
+    StaticVector<relocatableHandle,VEC_SIZE*4> vec;
+    for(std::size_t i = 0; i < VEC_SIZE*4; i++){
+      vec.push_back(relocatableHandle(i));
+    }
+    // 0 3 6 9 ... are erased, runs of two survivors are moved down between them
+    BOOST_CHECK_EQUAL(vec.erase_if(throwOnValue(VEC_SIZE*4)),(VEC_SIZE*4+2)/3);
+    BOOST_CHECK_EQUAL(relocatableHandle::live,vec.size());
+    for(std::size_t i = 0; i < vec.size(); i++){
+      BOOST_CHECK(*vec[i].value % 3 != 0);
+    }
+
+    // a throwing predicate keeps the element it threw on and everything behind it
+    vec.clear();
+    for(std::size_t i = 0; i < VEC_SIZE*2; i++){
+      vec.push_back(relocatableHandle(i));
+    }
+    BOOST_CHECK_THROW(vec.erase_if(throwOnValue(7)),std::runtime_error);
+    std::size_t expected[] = {1,2,4,5,7,8,9};
+    BOOST_REQUIRE_EQUAL(vec.size(),sizeof(expected)/sizeof(expected[0]));
+    for(std::size_t i = 0; i < vec.size(); i++){
+      BOOST_CHECK_EQUAL(*vec[i].value,expected[i]);
+    }
+    BOOST_CHECK_EQUAL(relocatableHandle::live,vec.size());
+  }
+  BOOST_CHECK_EQUAL(relocatableHandle::live,0);
+}
+
+BOOST_AUTO_TEST_CASE(UnorderedErase){
+  StaticVector<std::string,VEC_SIZE> strings;
+  strings.push_back("a");
+  strings.push_back("b");
+  strings.push_back("c");
+  StaticVector<std::string,VEC_SIZE>::iterator it = strings.unordered_erase(strings.begin());
+  BOOST_CHECK(it == strings.begin());
+  BOOST_CHECK_EQUAL(strings.size(),2);
+  BOOST_CHECK_EQUAL(strings[0],"c");
+  BOOST_CHECK(strings.unordered_erase(strings.begin()+1) == strings.end());
+  BOOST_CHECK_EQUAL(strings.size(),1);
+
+  {
+    StaticVector<relocatableHandle,VEC_SIZE> vec;
+    for(std::size_t i = 0; i < VEC_SIZE; i++){
+      vec.push_back(relocatableHandle(i));
+    }
+    vec.unordered_erase(vec.begin()+1);
+    BOOST_CHECK_EQUAL(*vec[1].value,VEC_SIZE-1);
+    BOOST_CHECK_EQUAL(vec.size(),VEC_SIZE-1);
+    BOOST_CHECK_EQUAL(relocatableHandle::live,VEC_SIZE-1);
+  }
+  BOOST_CHECK_EQUAL(relocatableHandle::live,0);
+}
+
+// erase by value with the vector compress kernel against std::remove, for every size up to N
+// and several patterns of erased elements, so full, empty and mixed blocks and each tail are covered
+template <typename T, std::size_t N>
+void CheckEraseMatchesStd(){
+  for(std::size_t size = 0; size <= N; size++){
+    for(std::size_t period = 1; period <= 5; period++){
+      StaticVector<T,N> vec;
+      std::vector<T> expected;
+      for(std::size_t i = 0; i < size; i++){
+        vec.push_back(static_cast<T>(i % period == 0 ? 0 : i % 7 + 1));
+        expected.push_back(vec.back());
+      }
+      expected.erase(std::remove(expected.begin(),expected.end(),static_cast<T>(0)),expected.end());
+      BOOST_CHECK_EQUAL(erase(vec,static_cast<T>(0)),size-expected.size());
+      BOOST_REQUIRE_EQUAL(vec.size(),expected.size());
+      BOOST_CHECK(std::equal(vec.begin(),vec.end(),expected.begin()));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SimdEraseMatchesStd){
+  CheckEraseMatchesStd<boost::int8_t,70>();
+  CheckEraseMatchesStd<boost::uint16_t,40>();
+  CheckEraseMatchesStd<boost::int32_t,20>();
+  CheckEraseMatchesStd<boost::uint64_t,11>();
+  CheckEraseMatchesStd<float,19>();
+  CheckEraseMatchesStd<double,11>();
+
+  // -0.0 compares equal to 0.0, NaN is never equal and stays
+  StaticVector<float,VEC_SIZE*2> floats;
+  floats.push_back(-0.0f);
+  floats.push_back(std::numeric_limits<float>::quiet_NaN());
+  floats.push_back(1.0f);
+  floats.push_back(0.0f);
+  BOOST_CHECK_EQUAL(erase(floats,0.0f),2);
+  BOOST_CHECK_EQUAL(floats.size(),2);
+  BOOST_CHECK(floats[0] != floats[0]);
+  BOOST_CHECK_EQUAL(erase(floats,std::numeric_limits<float>::quiet_NaN()),0);
+}
@@ -0,0 +1,137 @@
+/**
+ * @file   StaticVectorView.hpp
+ * @brief  Zero-copy view of a StaticVector stored in external memory.
+ *
+ * For trivially copyable T, StaticVector has a stable layout (see
+ * StaticVector::has_stable_layout): the size at size_offset(), the N element
+ * slots at elems_offset() and nothing else, sizeof(StaticVector) bytes in
+ * total. A snapshot of those bytes in a file or shared memory segment is a
+ * valid StaticVector again once mapped at a suitably aligned address.
+ *
+ * StaticVectorView<T, N> is placed over such a region without copying:
+ * construction checks that the region is large and aligned enough and that
+ * the stored size is at most N, and throws std::invalid_argument otherwise.
+ * After that, vector() is the StaticVector living in the region and the
+ * usual read access is forwarded. StaticVectorView<const T, N> only gives
+ * const access and accepts const memory, e.g. a read-only mapping. The
+ * size type and the policies must match those of the StaticVector that
+ * wrote the region.
+ *
+ *   boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+ *   boost::StaticVectorView<const Record, 100000> records(region.get_address(), region.get_size());
+ *
+ *  StaticVectorView is not accepted as part of boost.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_STATIC_VECTOR_VIEW_HPP
+#define BOOST_STATIC_VECTOR_VIEW_HPP
+
+#include "StaticVector.hpp"
+#include <boost/mpl/if.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_const.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <stdexcept>
+
+namespace boost {
+
+    template<class T, std::size_t N, typename size_type_t = typename boost::uint_value_t<N>::least,
+             class StatsPolicy = static_vector_no_stats, class ErrorPolicy = static_vector_throw_on_error>
+    class StaticVectorView {
+      public:
+        // the StaticVector stored in the viewed memory
+        typedef StaticVector<typename boost::remove_const<T>::type, N, size_type_t, StatsPolicy, ErrorPolicy> vector_type;
+        typedef typename boost::mpl::if_c< boost::is_const<T>::value,
+                                           const vector_type,
+                                           vector_type >::type viewed_type;
+        typedef typename boost::mpl::if_c< boost::is_const<T>::value,
+                                           const void*,
+                                           void* >::type      memory_pointer;
+
+        typedef typename vector_type::value_type               value_type;
+        typedef T*                                             pointer;
+        typedef T*                                             iterator;
+        typedef const T*                                       const_iterator;
+        typedef T&                                             reference;
+        typedef const T&                                       const_reference;
+        typedef typename vector_type::size_type                size_type;
+
+        BOOST_STATIC_ASSERT(vector_type::has_stable_layout);
+
+        // number of bytes a region must provide
+        static std::size_t required_bytes() { return sizeof(vector_type); }
+        // alignment a region must have
+        static std::size_t required_alignment() { return boost::alignment_of<vector_type>::value; }
+
+        // view the StaticVector stored in [memory, memory+bytes), throws std::invalid_argument if it is not valid
+        StaticVectorView(memory_pointer memory, std::size_t bytes)
+          :m_vector(static_cast<viewed_type*>(memory)){
+          const char* reason = check(memory, bytes);
+          if(reason){
+            std::invalid_argument e(reason);
+            BOOST_THROW_EXCEPTION(e);
+          }
+        }
+
+        // true if a view may be placed over [memory, memory+bytes)
+        static bool validate(const void* memory, std::size_t bytes){
+          return check(memory, bytes) == 0;
+        }
+
+        // an empty StaticVector in raw memory, e.g. a freshly created shared memory segment or file
+        static viewed_type* initialize(void* memory, std::size_t bytes){
+          if(!memory || bytes < required_bytes() || !aligned(memory)){
+            std::invalid_argument e("StaticVectorView<>: region too small or misaligned");
+            BOOST_THROW_EXCEPTION(e);
+          }
+          return new (memory) vector_type();
+        }
+
+        viewed_type& vector() const { return *m_vector; }
+        viewed_type* operator->() const { return m_vector; }
+
+        iterator begin() const { return m_vector->begin(); }
+        iterator end() const { return m_vector->end(); }
+        pointer data() const { return m_vector->data(); }
+        reference operator[](size_type i) const { return (*m_vector)[i]; }
+        reference at(size_type i) const { return m_vector->at(i); }
+
+        size_type size() const { return m_vector->size(); }
+        bool empty() const { return m_vector->empty(); }
+        static size_type capacity() { return N; }
+
+      private:
+
+        static bool aligned(const void* memory){
+          return reinterpret_cast<std::size_t>(memory) % required_alignment() == 0;
+        }
+
+        // 0 if valid, otherwise what is wrong with the region
+        static const char* check(const void* memory, std::size_t bytes){
+          if(!memory){
+            return "StaticVectorView<>: null region";
+          }
+          if(bytes < required_bytes()){
+            return "StaticVectorView<>: region smaller than the StaticVector";
+          }
+          if(!aligned(memory)){
+            return "StaticVectorView<>: region misaligned for the StaticVector";
+          }
+          size_type stored;
+          std::memcpy(&stored, static_cast<const char*>(memory) + vector_type::size_offset(), sizeof(stored));
+          if(stored > N){
+            return "StaticVectorView<>: stored size exceeds the capacity";
+          }
+          return 0;
+        }
+
+        viewed_type* m_vector;
+    };
+
+} // namespace boost
+
+#endif /* BOOST_STATIC_VECTOR_VIEW_HPP */
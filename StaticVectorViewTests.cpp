@@ -0,0 +1,112 @@
+/**
+ *  @file   StaticVectorViewTests.cpp
+ *  @brief  StaticVectorViewTests.cpp
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *  StaticVectorView is not accepted as part of boost.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <StaticVectorView.hpp>
+#include <boost/cstdint.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+using namespace boost;
+
+namespace {
+  struct Record {
+    boost::uint32_t id;
+    double value;
+  };
+  
+  bool operator==(const Record& lhs, const Record& rhs){
+    return lhs.id == rhs.id && lhs.value == rhs.value;
+  }
+  
+  typedef StaticVector<Record,100> RecordVector;
+  typedef boost::aligned_storage<sizeof(RecordVector),boost::alignment_of<RecordVector>::value>::type Region;
+}
+
+BOOST_AUTO_TEST_CASE(StableLayout){
+  BOOST_CHECK(RecordVector::has_stable_layout);
+  BOOST_CHECK(!(StaticVector<std::string,4>::has_stable_layout));
+  BOOST_CHECK_EQUAL(RecordVector::size_offset(),0u);
+  BOOST_CHECK_EQUAL(RecordVector::elems_offset(),boost::alignment_of<Record>::value);
+  
+  RecordVector records;
+  Record r = {7,1.5};
+  records.push_back(r);
+  BOOST_CHECK(records.data() == &records[0]);
+  BOOST_CHECK(reinterpret_cast<const char*>(records.data()) == reinterpret_cast<const char*>(&records) + RecordVector::elems_offset());
+  BOOST_CHECK_EQUAL(get_c_array(records)[0].id,7u);
+}
+
+BOOST_AUTO_TEST_CASE(ViewOverSnapshotFile){
+  RecordVector records;
+  for(boost::uint32_t i = 0; i < 42; i++){
+    Record r = {i,i*0.5};
+    records.push_back(r);
+  }
+  
+  // one write of the whole block, one read back into aligned memory, no per element work
+  const char* path = "StaticVectorViewTests.snapshot";
+  {
+    std::ofstream out(path,std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&records),sizeof(records));
+  }
+  Region region;
+  {
+    std::ifstream in(path,std::ios::binary);
+    in.read(reinterpret_cast<char*>(&region),sizeof(region));
+  }
+  std::remove(path);
+  
+  StaticVectorView<const Record,100> view(&region,sizeof(region));
+  BOOST_CHECK_EQUAL(view.size(),42);
+  BOOST_CHECK_EQUAL(view[41].id,41u);
+  BOOST_CHECK_EQUAL(view.at(10).value,5.0);
+  BOOST_CHECK(view.vector() == records);
+  
+  // writable views modify the region in place
+  StaticVectorView<Record,100> writable(&region,sizeof(region));
+  Record r = {1000,0.0};
+  writable->push_back(r);
+  BOOST_CHECK_EQUAL(view.size(),43);
+  BOOST_CHECK_EQUAL(view[42].id,1000u);
+}
+
+BOOST_AUTO_TEST_CASE(ViewValidation){
+  Region region;
+  RecordVector* vec = StaticVectorView<Record,100>::initialize(&region,sizeof(region));
+  BOOST_CHECK(vec->empty());
+  BOOST_CHECK((StaticVectorView<Record,100>::validate(&region,sizeof(region))));
+  
+  BOOST_CHECK((!StaticVectorView<Record,100>::validate(0,sizeof(region))));
+  BOOST_CHECK((!StaticVectorView<Record,100>::validate(&region,sizeof(region)-1)));
+  BOOST_CHECK((!StaticVectorView<Record,100>::validate(reinterpret_cast<char*>(&region)+1,sizeof(region)-1)));
+  BOOST_CHECK_THROW((StaticVectorView<Record,100>(&region,sizeof(region)-1)),std::invalid_argument);
+  
+  // a corrupted size is rejected before any element is touched
+  RecordVector::size_type corrupt = 101;
+  std::memcpy(&region,&corrupt,sizeof(corrupt));
+  BOOST_CHECK((!StaticVectorView<Record,100>::validate(&region,sizeof(region))));
+  BOOST_CHECK_THROW((StaticVectorView<const Record,100>(&region,sizeof(region))),std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(ViewWithPolicies){
+  typedef StaticVectorView<Record,100,uint_value_t<100>::least,static_vector_no_stats,static_vector_assert_on_error> AssertingView;
+  Region region;
+  AssertingView::vector_type* vec = AssertingView::initialize(&region,sizeof(region));
+  Record r = {7, 0.5};
+  vec->push_back(r);
+  AssertingView view(&region,sizeof(region));
+  BOOST_CHECK_EQUAL(view.size(),1);
+  BOOST_CHECK(view[0] == r);
+}
@@ -0,0 +1,339 @@
+/**
+ *  @file   benchStaticConcurrent.cpp
+ *  @brief  Contention benchmark for StaticMPMCQueue and StaticAppendLog.
+ *
+ *  Every workload is run with 1, 2, 4, ... up to 64 threads against the
+ *  lock-free container and against the lock based alternatives it replaces:
+ *
+ *    append  threads append to a log of 65536 elements until it is full
+ *            StaticAppendLog, StaticVector + spinlock, StaticVector + boost::mutex
+ *    queue   every thread does push/pop pairs through one queue of 1024 elements,
+ *            65536 pairs in total
+ *            StaticMPMCQueue, StaticRing + spinlock, std::deque + boost::mutex
+ *
+ *  The threads are started and parked on a barrier before the clock starts,
+ *  and the trial ends when the last thread has been joined. The median and
+ *  minimum over all trials are printed together with the median time per
+ *  element operation.
+ *
+ *  Usage:
+ *    benchStaticConcurrent [--format=csv|json] [--trials=N] [--filter=substring] [--max-threads=N]
+ *
+ *  The filter is matched against the benchmark name, which has the form
+ *  workload/container/threads, e.g. queue/StaticMPMCQueue/8.
+ *
+ *  Build with optimization (e.g. -DCMAKE_BUILD_TYPE=Release) for meaningful numbers.
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include "StaticConcurrent.hpp"
+#include <boost/bind/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef boost::uint64_t value_type;
+
+const std::size_t log_capacity = 65536;
+const std::size_t queue_capacity = 1024;
+const std::size_t queue_pairs = 65536;
+
+// ---------- locks -------------------------
+
+// test and test-and-set, yielding so oversubscribed runs still make progress
+class Spinlock {
+public:
+  Spinlock() : m_locked(false) {}
+  void lock() {
+    for (;;) {
+      if (!m_locked.exchange(true, boost::memory_order_acquire))
+        return;
+      while (m_locked.load(boost::memory_order_relaxed))
+        boost::this_thread::yield();
+    }
+  }
+  void unlock() { m_locked.store(false, boost::memory_order_release); }
+private:
+  boost::atomic<bool> m_locked;
+};
+
+template<typename Lock>
+class Guard {
+public:
+  explicit Guard(Lock& lock) : m_lock(lock) { m_lock.lock(); }
+  ~Guard() { m_lock.unlock(); }
+private:
+  Lock& m_lock;
+};
+
+// ---------- append-only logs -------------------------
+
+struct AppendLog {
+  static const char* name() { return "StaticAppendLog"; }
+  bool try_push_back(value_type v) { return log.try_push_back(v); }
+  boost::StaticAppendLog<value_type, log_capacity> log;
+};
+
+template<typename Lock>
+struct LockedVector {
+  static const char* name();
+  bool try_push_back(value_type v) {
+    Guard<Lock> guard(lock);
+    if (vec.full())
+      return false;
+    vec.push_back(v);
+    return true;
+  }
+  boost::StaticVector<value_type, log_capacity> vec;
+  Lock lock;
+};
+template<> const char* LockedVector<Spinlock>::name() { return "StaticVector+spinlock"; }
+template<> const char* LockedVector<boost::mutex>::name() { return "StaticVector+mutex"; }
+
+// ---------- queues -------------------------
+
+struct MPMCQueue {
+  static const char* name() { return "StaticMPMCQueue"; }
+  bool try_push(value_type v) { return queue.try_push(v); }
+  bool try_pop(value_type& v) { return queue.try_pop(v); }
+  boost::StaticMPMCQueue<value_type, queue_capacity> queue;
+};
+
+struct SpinlockRing {
+  static const char* name() { return "StaticRing+spinlock"; }
+  bool try_push(value_type v) {
+    Guard<Spinlock> guard(lock);
+    return ring.try_push(v);
+  }
+  bool try_pop(value_type& v) {
+    Guard<Spinlock> guard(lock);
+    return ring.try_pop(v);
+  }
+  boost::StaticRing<value_type, queue_capacity, boost::ring_unsynchronized> ring;
+  Spinlock lock;
+};
+
+struct MutexDeque {
+  static const char* name() { return "std::deque+mutex"; }
+  bool try_push(value_type v) {
+    Guard<boost::mutex> guard(lock);
+    if (deque.size() == queue_capacity)
+      return false;
+    deque.push_back(v);
+    return true;
+  }
+  bool try_pop(value_type& v) {
+    Guard<boost::mutex> guard(lock);
+    if (deque.empty())
+      return false;
+    v = deque.front();
+    deque.pop_front();
+    return true;
+  }
+  std::deque<value_type> deque;
+  boost::mutex lock;
+};
+
+// ---------- workloads -------------------------
+
+template<typename Log>
+struct Append {
+  static const char* name() { return "append"; }
+  static std::size_t ops(std::size_t /*threads*/) { return log_capacity; }
+  static void run(Log* log, std::size_t thread, std::size_t /*threads*/, boost::barrier* start) {
+    start->wait();
+    value_type v = static_cast<value_type>(thread) << 32;
+    while (log->try_push_back(v))
+      ++v;
+  }
+};
+
+template<typename Queue>
+struct PushPop {
+  static const char* name() { return "queue"; }
+  static std::size_t ops(std::size_t threads) { return queue_pairs / threads * threads * 2; }
+  static void run(Queue* queue, std::size_t thread, std::size_t threads, boost::barrier* start) {
+    start->wait();
+    value_type v = static_cast<value_type>(thread) << 32;
+    for (std::size_t i = queue_pairs / threads; i > 0; --i) {
+      while (!queue->try_push(v))
+        boost::this_thread::yield();
+      while (!queue->try_pop(v))
+        boost::this_thread::yield();
+    }
+  }
+};
+
+// ---------- measurement -------------------------
+
+typedef std::chrono::steady_clock bench_clock;
+
+struct Options {
+  Options() : json(false), trials(7), max_threads(64) {}
+  bool json;
+  std::size_t trials;
+  std::size_t max_threads;
+  std::string filter;
+};
+
+struct Result {
+  std::string name, workload, container;
+  std::size_t threads, trials, ops;
+  double median_ns, min_ns;
+};
+
+class Reporter {
+public:
+  explicit Reporter(const Options& options) : m_options(options), m_count(0) {}
+
+  void begin() {
+    if (m_options.json) {
+      std::cout << "{\n  \"context\": {\"trials\": " << m_options.trials
+                << ", \"hardware_threads\": " << boost::thread::hardware_concurrency()
+                << ", \"optimized\": " << (optimized() ? "true" : "false") << "},\n"
+                << "  \"benchmarks\": [\n";
+    } else {
+      std::cout << "name,workload,container,threads,trials,ops,median_ns,min_ns,ns_per_op\n";
+    }
+  }
+
+  void add(const Result& r) {
+    double per_op = r.ops ? r.median_ns / r.ops : 0.0;
+    if (m_options.json) {
+      std::cout << (m_count ? ",\n" : "")
+                << "    {\"name\": \"" << r.name << "\", \"workload\": \"" << r.workload
+                << "\", \"container\": \"" << r.container << "\", \"threads\": " << r.threads
+                << ", \"trials\": " << r.trials << ", \"ops\": " << r.ops
+                << ", \"median_ns\": " << r.median_ns << ", \"min_ns\": " << r.min_ns
+                << ", \"ns_per_op\": " << per_op << "}";
+    } else {
+      std::cout << r.name << ',' << r.workload << ',' << r.container << ',' << r.threads << ','
+                << r.trials << ',' << r.ops << ',' << r.median_ns << ',' << r.min_ns << ','
+                << per_op << '\n';
+    }
+    ++m_count;
+  }
+
+  void end() {
+    if (m_options.json)
+      std::cout << "\n  ]\n}\n";
+    std::cout.flush();
+  }
+
+  static bool optimized() {
+#if defined(__OPTIMIZE__) || defined(NDEBUG)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+private:
+  const Options& m_options;
+  std::size_t m_count;
+};
+
+// one trial: park the threads on a barrier, then time from releasing them until all have been joined
+template<template<typename> class Workload, typename Container>
+double run_trial(std::size_t threads) {
+  std::unique_ptr<Container> container(new Container());
+  boost::barrier start(static_cast<unsigned>(threads + 1));
+  boost::thread_group group;
+  for (std::size_t t = 0; t < threads; ++t)
+    group.create_thread(boost::bind(&Workload<Container>::run, container.get(), t, threads, &start));
+  start.wait();
+  bench_clock::time_point begin = bench_clock::now();
+  group.join_all();
+  bench_clock::time_point end = bench_clock::now();
+  return std::chrono::duration<double, std::nano>(end - begin).count();
+}
+
+template<template<typename> class Workload, typename Container>
+void run_one(const Options& options, Reporter& reporter, std::size_t threads) {
+  std::ostringstream name;
+  name << Workload<Container>::name() << '/' << Container::name() << '/' << threads;
+  if (!options.filter.empty() && name.str().find(options.filter) == std::string::npos)
+    return;
+  std::cerr << name.str() << std::endl;
+  std::vector<double> samples;
+  for (std::size_t t = 0; t < options.trials; ++t)
+    samples.push_back(run_trial<Workload, Container>(threads));
+  std::sort(samples.begin(), samples.end());
+  Result r;
+  r.name = name.str();
+  r.workload = Workload<Container>::name();
+  r.container = Container::name();
+  r.threads = threads;
+  r.trials = samples.size();
+  r.ops = Workload<Container>::ops(threads);
+  r.median_ns = samples[(samples.size() - 1) / 2];
+  r.min_ns = samples.front();
+  reporter.add(r);
+}
+
+bool parse_option(const std::string& arg, const char* prefix, std::string& value) {
+  std::size_t len = std::strlen(prefix);
+  if (arg.compare(0, len, prefix) != 0)
+    return false;
+  value = arg.substr(len);
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg(argv[i]), value;
+    if (parse_option(arg, "--format=", value)) {
+      options.json = (value == "json");
+    } else if (parse_option(arg, "--trials=", value)) {
+      options.trials = (std::max)(1L, std::atol(value.c_str()));
+    } else if (parse_option(arg, "--filter=", value)) {
+      options.filter = value;
+    } else if (parse_option(arg, "--max-threads=", value)) {
+      options.max_threads = std::strtoul(value.c_str(), 0, 10);
+    } else {
+      std::cerr << "usage: " << argv[0]
+                << " [--format=csv|json] [--trials=N] [--filter=substring] [--max-threads=N]" << std::endl;
+      return 1;
+    }
+  }
+  if (!Reporter::optimized())
+    std::cerr << "warning: benchmark was built without optimization" << std::endl;
+
+  Reporter reporter(options);
+  reporter.begin();
+  try {
+    for (std::size_t threads = 1; threads <= options.max_threads && threads <= 64; threads *= 2) {
+      run_one<Append, AppendLog>(options, reporter, threads);
+      run_one<Append, LockedVector<Spinlock> >(options, reporter, threads);
+      run_one<Append, LockedVector<boost::mutex> >(options, reporter, threads);
+      run_one<PushPop, MPMCQueue>(options, reporter, threads);
+      run_one<PushPop, SpinlockRing>(options, reporter, threads);
+      run_one<PushPop, MutexDeque>(options, reporter, threads);
+    }
+  } catch (std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  reporter.end();
+  return 0;
+}
@@ -1,80 +1,526 @@
-
- // benchmark based on: http://cpp-next.com/archive/2010/10/howards-stl-move-semantics-benchmark/
+/**
+ *  @file   benchStaticVector.cpp
+ *  @brief  Benchmark suite comparing StaticVector with std::vector,
+ *          boost::container::static_vector and std::array.
+ *
+ *  Every combination of element type, capacity, container and operation is
+ *  run for a number of independent trials. Setup work (filling, generating
+ *  unsorted input, tearing down) happens outside of the timed region, and
+ *  each trial reports a single wall clock measurement. The median, 99th
+ *  percentile and minimum over all trials are printed together with the
+ *  median time per element operation.
+ *
+ *  Usage:
+ *    benchStaticVector [--format=csv|json] [--trials=N] [--filter=substring] [--max-capacity=N]
+ *
+ *  The filter is matched against the benchmark name, which has the form
+ *  operation/container/type/capacity, e.g. insert_middle/StaticVector/std::string/4096.
+ *  Results go to stdout, progress and warnings to stderr, so the output
+ *  can be redirected straight into a file and compared across builds.
+ *
+ *  Build with optimization (e.g. -DCMAKE_BUILD_TYPE=Release) for meaningful numbers.
+ *
+ *  The original single workload benchmark was based on:
+ *  http://cpp-next.com/archive/2010/10/howards-stl-move-semantics-benchmark/
+ *
+ *  Distributed under the Boost Software License, Version 1.0. (See
+ *  accompanying file LICENSE_1_0.txt or copy at
+ *  http://www.boost.org/LICENSE_1_0.txt)
+ */
 
 #include "StaticVector.hpp"
-#include <vector>
+#include <boost/container/static_vector.hpp>
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
-#include <time.h>
+#include <memory>
 #include <set>
-#include <algorithm>
-#include <exception>
- 
-const unsigned N = 3001;
- 
-extern bool some_test;
- 
-template<typename T>
-T get_set(std::size_t)
-{
-    T s;
-    for (std::size_t i = 0; i < N; ++i)
-        while (!s.insert(std::rand()).second)
-            ;
-    if (some_test)
-        return s;
-    return T();
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// ---------- element types -------------------------
+
+struct Pod64 {
+  boost::uint64_t key;
+  char payload[56];
+};
+
+bool operator<(const Pod64& lhs, const Pod64& rhs) { return lhs.key < rhs.key; }
+bool operator==(const Pod64& lhs, const Pod64& rhs) { return lhs.key == rhs.key; }
+
+// deterministic pseudo random sequence so every container sees the same input
+inline std::size_t scramble(std::size_t i) {
+  boost::uint64_t x = i * 0x9E3779B97F4A7C15ull;
+  x ^= x >> 29;
+  return static_cast<std::size_t>(x % 1000003);
 }
- 
-template<typename T>
-T generate()
-{
-    T v;
+
+template<typename T> struct Element;
+
+template<> struct Element<int> {
+  static const char* name() { return "int"; }
+  static int make(std::size_t i) { return static_cast<int>(scramble(i)); }
+  static std::size_t key(const int& v) { return static_cast<std::size_t>(v); }
+};
+
+template<> struct Element<Pod64> {
+  static const char* name() { return "pod64"; }
+  static Pod64 make(std::size_t i) {
+    Pod64 p;
+    p.key = scramble(i);
+    std::memset(p.payload, static_cast<int>(i & 0xff), sizeof(p.payload));
+    return p;
+  }
+  static std::size_t key(const Pod64& v) { return static_cast<std::size_t>(v.key); }
+};
+
+template<> struct Element<std::string> {
+  static const char* name() { return "std::string"; }
+  // long enough to defeat the small string optimization
+  static std::string make(std::size_t i) {
+    std::ostringstream s;
+    s << "element-value-" << scramble(i);
+    return s.str();
+  }
+  static std::size_t key(const std::string& v) { return v.size(); }
+};
+
+template<> struct Element<std::set<std::size_t> > {
+  static const char* name() { return "std::set"; }
+  static std::set<std::size_t> make(std::size_t i) {
+    std::set<std::size_t> s;
+    for (std::size_t j = 0; j < 4; ++j)
+      s.insert(scramble(i * 4 + j));
+    return s;
+  }
+  static std::size_t key(const std::set<std::size_t>& v) { return *v.begin(); }
+};
+
+// ---------- containers -------------------------
+
+// std::array with a separate element count, the hand rolled alternative to StaticVector.
+// All N elements are always constructed, so copy and swap cost O(N).
+template<typename T, std::size_t N>
+class FixedArray {
+public:
+  typedef T* iterator;
+  FixedArray() : m_size(0) {}
+  iterator begin() { return m_elems.data(); }
+  iterator end() { return m_elems.data() + m_size; }
+  std::size_t size() const { return m_size; }
+  T& back() { return m_elems[m_size - 1]; }
+  void push_back(const T& x) { m_elems[m_size++] = x; }
+  iterator insert(iterator pos, const T& x) {
+    std::move_backward(pos, end(), end() + 1);
+    *pos = x;
+    ++m_size;
+    return pos;
+  }
+  iterator erase(iterator pos) {
+    std::move(pos + 1, end(), pos);
+    --m_size;
+    return pos;
+  }
+  void reserve(std::size_t) {}
+  void swap(FixedArray& rhs) {
+    m_elems.swap(rhs.m_elems);
+    std::swap(m_size, rhs.m_size);
+  }
+private:
+  std::array<T, N> m_elems;
+  std::size_t m_size;
+};
+
+struct StaticVectorKind {
+  static const char* name() { return "StaticVector"; }
+  template<typename T, std::size_t N> struct apply { typedef boost::StaticVector<T, N> type; };
+  template<typename C> static void prepare(C&, std::size_t) {}
+};
+
+struct BoostStaticVectorKind {
+  static const char* name() { return "boost::container::static_vector"; }
+  template<typename T, std::size_t N> struct apply { typedef boost::container::static_vector<T, N> type; };
+  template<typename C> static void prepare(C&, std::size_t) {}
+};
+
+struct VectorKind {
+  static const char* name() { return "std::vector"; }
+  template<typename T, std::size_t N> struct apply { typedef std::vector<T> type; };
+  template<typename C> static void prepare(C&, std::size_t) {}
+};
+
+struct ReservedVectorKind {
+  static const char* name() { return "std::vector+reserve"; }
+  template<typename T, std::size_t N> struct apply { typedef std::vector<T> type; };
+  template<typename C> static void prepare(C& c, std::size_t n) { c.reserve(n); }
+};
+
+struct ArrayKind {
+  static const char* name() { return "std::array"; }
+  template<typename T, std::size_t N> struct apply { typedef FixedArray<T, N> type; };
+  template<typename C> static void prepare(C&, std::size_t) {}
+};
+
+// ---------- measurement -------------------------
+
+typedef std::chrono::steady_clock bench_clock;
+
+volatile std::size_t g_sink = 0;
+
+struct Options {
+  Options() : json(false), trials(15), max_capacity(65536) {}
+  bool json;
+  std::size_t trials;
+  std::size_t max_capacity;
+  std::string filter;
+};
+
+struct Result {
+  std::string name, operation, container, type;
+  std::size_t capacity, trials, ops;
+  double median_ns, p99_ns, min_ns;
+};
+
+class Reporter {
+public:
+  explicit Reporter(const Options& options) : m_options(options), m_count(0) {}
+
+  void begin() {
+    if (m_options.json) {
+      std::cout << "{\n  \"context\": {\"trials\": " << m_options.trials
+                << ", \"optimized\": " << (optimized() ? "true" : "false") << "},\n"
+                << "  \"benchmarks\": [\n";
+    } else {
+      std::cout << "name,operation,container,type,capacity,trials,ops,median_ns,p99_ns,min_ns,ns_per_op\n";
+    }
+  }
+
+  void add(const Result& r) {
+    double per_op = r.ops ? r.median_ns / r.ops : 0.0;
+    if (m_options.json) {
+      std::cout << (m_count ? ",\n" : "")
+                << "    {\"name\": \"" << r.name << "\", \"operation\": \"" << r.operation
+                << "\", \"container\": \"" << r.container << "\", \"type\": \"" << r.type
+                << "\", \"capacity\": " << r.capacity << ", \"trials\": " << r.trials
+                << ", \"ops\": " << r.ops << ", \"median_ns\": " << r.median_ns
+                << ", \"p99_ns\": " << r.p99_ns << ", \"min_ns\": " << r.min_ns
+                << ", \"ns_per_op\": " << per_op << "}";
+    } else {
+      std::cout << r.name << ',' << r.operation << ',' << r.container << ',' << r.type << ','
+                << r.capacity << ',' << r.trials << ',' << r.ops << ',' << r.median_ns << ','
+                << r.p99_ns << ',' << r.min_ns << ',' << per_op << '\n';
+    }
+    ++m_count;
+  }
+
+  void end() {
+    if (m_options.json)
+      std::cout << "\n  ]\n}\n";
+    std::cout.flush();
+  }
+
+  static bool optimized() {
+#if defined(__OPTIMIZE__) || defined(NDEBUG)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+private:
+  const Options& m_options;
+  std::size_t m_count;
+};
+
+// Runs op.setup / op.run / op.teardown for every trial and summarizes the timings of op.run.
+template<typename Op>
+Result measure(const Options& options, Op& op) {
+  std::vector<double> samples;
+  samples.reserve(options.trials);
+  for (std::size_t t = 0; t < options.trials; ++t) {
+    op.setup();
+    bench_clock::time_point start = bench_clock::now();
+    op.run();
+    bench_clock::time_point stop = bench_clock::now();
+    op.teardown();
+    samples.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+  }
+  std::sort(samples.begin(), samples.end());
+  Result r;
+  r.trials = samples.size();
+  r.ops = op.ops();
+  r.min_ns = samples.front();
+  r.median_ns = samples[(samples.size() - 1) / 2];
+  std::size_t p99 = static_cast<std::size_t>(0.99 * samples.size() + 0.999999);
+  r.p99_ns = samples[(std::min)(samples.size(), (std::max)(p99, std::size_t(1))) - 1];
+  return r;
+}
+
+// ---------- operations -------------------------
+
+template<typename T, std::size_t N, typename Kind>
+struct Fixture {
+  typedef typename Kind::template apply<T, N>::type container;
+
+  static container* make(std::size_t fill) {
+    container* c = new container();
+    Kind::prepare(*c, N);
+    for (std::size_t i = 0; i < fill; ++i)
+      c->push_back(Element<T>::make(i));
+    return c;
+  }
+
+  static void consume(container& c) {
+    if (c.size())
+      g_sink = g_sink + Element<T>::key(c.back());
+  }
+};
+
+// fill an empty container to capacity
+template<typename T, std::size_t N, typename Kind>
+struct PushBack : Fixture<T, N, Kind> {
+  typedef Fixture<T, N, Kind> base;
+  static const char* name() { return "push_back"; }
+  void setup() {
+    c.reset(base::make(0));
+    input.clear();
     for (std::size_t i = 0; i < N; ++i)
-        v.push_back(get_set<typename T::value_type>(i));
-    if (some_test)
-        return v;
-    return T();
+      input.push_back(Element<T>::make(i));
+  }
+  void run() {
+    for (std::size_t i = 0; i < N; ++i)
+      c->push_back(input[i]);
+    base::consume(*c);
+  }
+  void teardown() { c.reset(); }
+  std::size_t ops() const { return N; }
+  std::unique_ptr<typename base::container> c;
+  std::vector<T> input;
+};
+
+// insert into the middle of a half full container, bounded so large capacities stay tractable
+template<typename T, std::size_t N, typename Kind>
+struct InsertMiddle : Fixture<T, N, Kind> {
+  typedef Fixture<T, N, Kind> base;
+  static const char* name() { return "insert_middle"; }
+  static std::size_t count() { return (std::min)(N / 2, std::size_t(256)); }
+  void setup() { c.reset(base::make(N / 2)); value = Element<T>::make(N); }
+  void run() {
+    for (std::size_t i = 0; i < count(); ++i)
+      c->insert(c->begin() + c->size() / 2, value);
+    base::consume(*c);
+  }
+  void teardown() { c.reset(); }
+  std::size_t ops() const { return count(); }
+  std::unique_ptr<typename base::container> c;
+  T value;
+};
+
+// repeatedly erase the first element of a full container
+template<typename T, std::size_t N, typename Kind>
+struct EraseFront : Fixture<T, N, Kind> {
+  typedef Fixture<T, N, Kind> base;
+  static const char* name() { return "erase_front"; }
+  static std::size_t count() { return (std::min)(N, std::size_t(256)); }
+  void setup() { c.reset(base::make(N)); }
+  void run() {
+    for (std::size_t i = 0; i < count(); ++i)
+      c->erase(c->begin());
+    base::consume(*c);
+  }
+  void teardown() { c.reset(); }
+  std::size_t ops() const { return count(); }
+  std::unique_ptr<typename base::container> c;
+};
+
+// copy construct a full container
+template<typename T, std::size_t N, typename Kind>
+struct Copy : Fixture<T, N, Kind> {
+  typedef Fixture<T, N, Kind> base;
+  static const char* name() { return "copy"; }
+  void setup() { source.reset(base::make(N)); }
+  void run() {
+    copy.reset(new typename base::container(*source));
+    base::consume(*copy);
+  }
+  void teardown() { copy.reset(); source.reset(); }
+  std::size_t ops() const { return N; }
+  std::unique_ptr<typename base::container> source, copy;
+};
+
+// swap a full container with a half full one
+template<typename T, std::size_t N, typename Kind>
+struct Swap : Fixture<T, N, Kind> {
+  typedef Fixture<T, N, Kind> base;
+  static const char* name() { return "swap"; }
+  void setup() { a.reset(base::make(N)); b.reset(base::make(N / 2)); }
+  void run() {
+    a->swap(*b);
+    base::consume(*a);
+  }
+  void teardown() { a.reset(); b.reset(); }
+  std::size_t ops() const { return N; }
+  std::unique_ptr<typename base::container> a, b;
+};
+
+// sort a full container of unsorted elements
+template<typename T, std::size_t N, typename Kind>
+struct Sort : Fixture<T, N, Kind> {
+  typedef Fixture<T, N, Kind> base;
+  static const char* name() { return "sort"; }
+  void setup() { c.reset(base::make(N)); }
+  void run() {
+    std::sort(c->begin(), c->end());
+    base::consume(*c);
+  }
+  void teardown() { c.reset(); }
+  std::size_t ops() const { return N; }
+  std::unique_ptr<typename base::container> c;
+};
+
+// visit every element of a full container
+template<typename T, std::size_t N, typename Kind>
+struct Iterate : Fixture<T, N, Kind> {
+  typedef Fixture<T, N, Kind> base;
+  static const char* name() { return "iterate_sum"; }
+  void setup() { c.reset(base::make(N)); }
+  void run() {
+    std::size_t sum = 0;
+    for (typename base::container::iterator it = c->begin(); it != c->end(); ++it)
+      sum += Element<T>::key(*it);
+    g_sink = g_sink + sum;
+  }
+  void teardown() { c.reset(); }
+  std::size_t ops() const { return N; }
+  std::unique_ptr<typename base::container> c;
+};
+
+// index of the first element of c equal to value
+template<typename C, typename T>
+std::size_t search(C& c, const T& value) {
+  return std::find(c.begin(), c.end(), value) - c.begin();
+}
+
+// StaticVector uses its vectorized kernel for arithmetic element types
+template<typename T, std::size_t N>
+std::size_t search(boost::StaticVector<T, N>& c, const T& value) {
+  return boost::find(c, value) - c.begin();
+}
+
+// scan a full container for a value that is (almost always) absent
+template<typename T, std::size_t N, typename Kind>
+struct Find : Fixture<T, N, Kind> {
+  typedef Fixture<T, N, Kind> base;
+  static const char* name() { return "find"; }
+  void setup() { c.reset(base::make(N)); value = Element<T>::make(N); }
+  void run() { g_sink = g_sink + search(*c, value); }
+  void teardown() { c.reset(); }
+  std::size_t ops() const { return N; }
+  std::unique_ptr<typename base::container> c;
+  T value;
+};
+
+// ---------- sweep -------------------------
+
+template<template<typename, std::size_t, typename> class Op, typename T, std::size_t N, typename Kind>
+void run_one(const Options& options, Reporter& reporter) {
+  std::ostringstream name;
+  name << Op<T, N, Kind>::name() << '/' << Kind::name() << '/' << Element<T>::name() << '/' << N;
+  if (!options.filter.empty() && name.str().find(options.filter) == std::string::npos)
+    return;
+  std::cerr << name.str() << std::endl;
+  Op<T, N, Kind> op;
+  Result r = measure(options, op);
+  r.name = name.str();
+  r.operation = Op<T, N, Kind>::name();
+  r.container = Kind::name();
+  r.type = Element<T>::name();
+  r.capacity = N;
+  reporter.add(r);
+}
+
+template<template<typename, std::size_t, typename> class Op, typename T, std::size_t N>
+void run_containers(const Options& options, Reporter& reporter) {
+  run_one<Op, T, N, StaticVectorKind>(options, reporter);
+  run_one<Op, T, N, BoostStaticVectorKind>(options, reporter);
+  run_one<Op, T, N, VectorKind>(options, reporter);
+  run_one<Op, T, N, ReservedVectorKind>(options, reporter);
+  run_one<Op, T, N, ArrayKind>(options, reporter);
 }
- 
+
+template<typename T, std::size_t N>
+void run_operations(const Options& options, Reporter& reporter) {
+  if (N > options.max_capacity)
+    return;
+  run_containers<PushBack, T, N>(options, reporter);
+  run_containers<InsertMiddle, T, N>(options, reporter);
+  run_containers<EraseFront, T, N>(options, reporter);
+  run_containers<Copy, T, N>(options, reporter);
+  run_containers<Swap, T, N>(options, reporter);
+  run_containers<Sort, T, N>(options, reporter);
+  run_containers<Iterate, T, N>(options, reporter);
+  run_containers<Find, T, N>(options, reporter);
+}
+
 template<typename T>
-float time_it()
-{
-    clock_t t1, t2, t3, t4;
-    clock_t t0 = clock();
-    {
-    T v = generate<T>();
-    t1 = clock();
-    std::cout << "construction took " << (float)((t1 - t0)/(double)CLOCKS_PER_SEC) << std::endl;
-    std::sort(v.begin(), v.end());
-    t2 = clock();
-    std::cout << "sort took " << (float)((t2 - t1)/(double)CLOCKS_PER_SEC) << std::endl;
-    std::rotate(v.begin(), v.begin() + v.size()/2, v.end());
-    t3 = clock();
-    std::cout << "rotate took " << (float)((t3 - t2)/(double)CLOCKS_PER_SEC) << std::endl;
-    }
-    t4 = clock();
-    std::cout << "destruction took " << (float)((t4 - t3)/(double)CLOCKS_PER_SEC) << std::endl;
-    std::cout << "done" << std::endl;
-    return (float)((t4-t0)/(double)CLOCKS_PER_SEC);
+void run_capacities(const Options& options, Reporter& reporter) {
+  run_operations<T, 8>(options, reporter);
+  run_operations<T, 64>(options, reporter);
+  run_operations<T, 512>(options, reporter);
+  run_operations<T, 4096>(options, reporter);
+  run_operations<T, 65536>(options, reporter);
 }
 
-int main()
+bool parse_option(const std::string& arg, const char* prefix, std::string& value) {
+  std::size_t len = std::strlen(prefix);
+  if (arg.compare(0, len, prefix) != 0)
+    return false;
+  value = arg.substr(len);
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
 {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg(argv[i]), value;
+    if (parse_option(arg, "--format=", value)) {
+      options.json = (value == "json");
+    } else if (parse_option(arg, "--trials=", value)) {
+      options.trials = (std::max)(1L, std::atol(value.c_str()));
+    } else if (parse_option(arg, "--filter=", value)) {
+      options.filter = value;
+    } else if (parse_option(arg, "--max-capacity=", value)) {
+      options.max_capacity = std::strtoul(value.c_str(), 0, 10);
+    } else {
+      std::cerr << "usage: " << argv[0]
+                << " [--format=csv|json] [--trials=N] [--filter=substring] [--max-capacity=N]" << std::endl;
+      return 1;
+    }
+  }
+  if (!Reporter::optimized())
+    std::cerr << "warning: benchmark was built without optimization" << std::endl;
+
+  Reporter reporter(options);
+  reporter.begin();
   try {
-    std::cout << "N = " << N << "\n\n";
-    
-    std::cout << "StaticVector Benchmark:\n";
-    float tsv = time_it<boost::StaticVector<std::set<std::size_t>,N > >();
-    std::cout << "Total time = " << tsv << "\n\n";
-    
-    std::cout << "Vector: Benchmark\n";
-    float tv = time_it<std::vector<std::set<std::size_t> > >();
-    std::cout << "Total time = " << tv << "\n\n";
-    
-    std::cout << "StaticVector time / Vector time = " << tsv/tv << '\n';
-  }catch(std::exception e){
-    std::cout << e.what();
+    run_capacities<int>(options, reporter);
+    run_capacities<Pod64>(options, reporter);
+    run_capacities<std::string>(options, reporter);
+    run_capacities<std::set<std::size_t> >(options, reporter);
+  } catch (std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
   }
+  reporter.end();
+  return 0;
 }
- 
-bool some_test = true;